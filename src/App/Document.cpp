@@ -1186,6 +1186,8 @@ void Document::setTransactionMode(int iMode)
     d->iTransactionMode = iMode;
 }
 
+static const char* BrepFormatEnums[]= {"Default","Text","Binary",NULL};
+
 //--------------------------------------------------------------------------
 // constructor
 //--------------------------------------------------------------------------
@@ -1287,6 +1289,9 @@ Document::Document(void)
         "Link of the tip object of the document");
     ADD_PROPERTY_TYPE(TipName,(""),0,PropertyType(Prop_Hidden|Prop_ReadOnly),
         "Link of the tip object of the document");
+    ADD_PROPERTY_TYPE(BrepFormat,((long)0),0,Prop_None,
+        "Format of the shape files when saving, 'Default' follows the preferences");
+    BrepFormat.setEnums(BrepFormatEnums);
     Uid.touch();
 }
 
@@ -1739,7 +1744,12 @@ bool Document::saveToFile(const char* filename) const
         writer.setLevel(compression);
         writer.putNextEntry("Document.xml");
 
-        if (hGrp->GetBool("SaveBinaryBrep", false))
+        bool binaryBrep = hGrp->GetBool("SaveBinaryBrep", false);
+        if (BrepFormat.isValue("Text"))
+            binaryBrep = false;
+        else if (BrepFormat.isValue("Binary"))
+            binaryBrep = true;
+        if (binaryBrep)
             writer.setMode("BinaryBrep");
 
         writer.Stream() << "<?xml version='1.0' encoding='utf-8'?>" << endl
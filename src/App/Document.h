@@ -109,6 +109,11 @@ public:
     PropertyLink Tip;
     /// Tip object of the document (if any)
     PropertyString TipName;
+    /** Format of the shape files when saving
+      * 'Default' follows the preferences, 'Text' writes BRep files
+      * and 'Binary' writes binary BRep files.
+      */
+    PropertyEnumeration BrepFormat;
     //@}
 
     /** @name Signals of the document */
@@ -50,6 +50,7 @@
 #include <Base/Unit.h>
 #include <App/PropertyUnits.h>
 #include <App/ObjectIdentifier.h>
+#include <boost/bind.hpp>
 #include <boost/math/special_functions/round.hpp>
 #include <boost/math/special_functions/trunc.hpp>
 
@@ -127,6 +128,64 @@ std::string unquote(const std::string & input)
     return output;
 }
 
+/* Counts the changes that may alter what a variable or a range refers to;
+ * lookups cached by ExpressionProgram are redone when it changes.
+ */
+static unsigned long resolveEpoch = 1;
+
+static void invalidateLookups()
+{
+    ++resolveEpoch;
+}
+
+/**
+  * Convert the value of a property path to a quantity or a string.
+  *
+  * @returns True if the value is a number, false if it is a string.
+  */
+
+static bool pathValueToQuantity(const boost::any & value, Quantity & qvalue, std::string & svalue)
+{
+    if (value.type() == typeid(Quantity)) {
+        qvalue = boost::any_cast<Quantity>(value);
+        return true;
+    }
+    else if (value.type() == typeid(double)) {
+        qvalue = Quantity(boost::any_cast<double>(value));
+        return true;
+    }
+    else if (value.type() == typeid(float)) {
+        qvalue = Quantity(boost::any_cast<float>(value));
+        return true;
+    }
+    else if (value.type() == typeid(int)) {
+        qvalue = Quantity(boost::any_cast<int>(value));
+        return true;
+    }
+    else if (value.type() == typeid(long)) {
+        qvalue = Quantity(boost::any_cast<long>(value));
+        return true;
+    }
+    else if (value.type() == typeid(bool)) {
+        qvalue = Quantity(boost::any_cast<bool>(value) ? 1.0 : 0.0);
+        return true;
+    }
+    else if (value.type() == typeid(std::string)) {
+        svalue = boost::any_cast<std::string>(value);
+        return false;
+    }
+    else if (value.type() == typeid(char*)) {
+        svalue = boost::any_cast<char*>(value);
+        return false;
+    }
+    else if (value.type() == typeid(const char*)) {
+        svalue = boost::any_cast<const char*>(value);
+        return false;
+    }
+
+    throw ExpressionError("Property is of invalid type.");
+}
+
 //
 // Expression base-class
 //
@@ -148,6 +207,25 @@ Expression * Expression::parse(const DocumentObject *owner, const std::string &b
     return ExpressionParser::parse(owner, buffer.c_str());
 }
 
+/**
+  * Evaluate the expression through its compiled form. The ExpressionProgram is
+  * built on first use, and kept for later evaluations. Expressions that cannot
+  * be compiled are evaluated with eval().
+  *
+  * @returns The result of the evaluation, i.e a new (Number|String)Expression object.
+  */
+
+Expression * Expression::evalCompiled() const
+{
+    if (!program || program->getExpression() != this)
+        program.reset(new ExpressionProgram(this));
+
+    if (!program->isValid())
+        return eval();
+
+    return program->eval();
+}
+
 //
 // UnitExpression class
 //
@@ -354,8 +432,6 @@ Expression * OperatorExpression::eval() const
     NumberExpression * v1;
     std::unique_ptr<Expression> e2(right->eval());
     NumberExpression * v2;
-    Expression * output;
-    const double epsilon = std::numeric_limits<double>::epsilon();
 
     v1 = freecad_dynamic_cast<NumberExpression>(e1.get());
     v2 = freecad_dynamic_cast<NumberExpression>(e2.get());
@@ -363,71 +439,80 @@ Expression * OperatorExpression::eval() const
     if (v1 == 0 || v2 == 0)
         throw ExpressionError("Invalid expression");
 
+    Quantity output = apply(op, v1->getQuantity(), v2->getQuantity());
+
+    switch (op) {
+    case EQ:
+    case NEQ:
+    case LT:
+    case GT:
+    case LTE:
+    case GTE:
+        return new BooleanExpression(owner, output.getValue() > 0.5);
+    default:
+        return new NumberExpression(owner, output);
+    }
+}
+
+/**
+  * Apply operator \a op to the values \a v1 and \a v2. Comparisons return 1 or 0.
+  * Throws an ExpressionError if the units of the values do not match the operator.
+  */
+
+Quantity OperatorExpression::apply(Operator op, const Quantity & v1, const Quantity & v2)
+{
+    const double epsilon = std::numeric_limits<double>::epsilon();
+
     switch (op) {
     case ADD:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for + operator");
-        output = new NumberExpression(owner, v1->getQuantity() + v2->getQuantity());
-        break;
+        return v1 + v2;
     case SUB:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for - operator");
-        output = new NumberExpression(owner, v1->getQuantity()- v2->getQuantity());
-        break;
+        return v1 - v2;
     case MUL:
     case UNIT:
-        output = new NumberExpression(owner, v1->getQuantity() * v2->getQuantity());
-        break;
+        return v1 * v2;
     case DIV:
-        output = new NumberExpression(owner, v1->getQuantity() / v2->getQuantity());
-        break;
+        return v1 / v2;
     case POW:
-        output = new NumberExpression(owner, v1->getQuantity().pow(v2->getQuantity()) );
-        break;
+        return v1.pow(v2);
     case EQ:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for the = operator");
-        output = new BooleanExpression(owner, essentiallyEqual(v1->getValue(), v2->getValue(), epsilon) );
-        break;
+        return Quantity(essentiallyEqual(v1.getValue(), v2.getValue(), epsilon) ? 1.0 : 0.0);
     case NEQ:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for the != operator");
-        output = new BooleanExpression(owner, !essentiallyEqual(v1->getValue(), v2->getValue(), epsilon) );
-        break;
+        return Quantity(!essentiallyEqual(v1.getValue(), v2.getValue(), epsilon) ? 1.0 : 0.0);
     case LT:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for the < operator");
-        output = new BooleanExpression(owner, definitelyLessThan(v1->getValue(), v2->getValue(), epsilon) );
-        break;
+        return Quantity(definitelyLessThan(v1.getValue(), v2.getValue(), epsilon) ? 1.0 : 0.0);
     case GT:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for the > operator");
-        output = new BooleanExpression(owner, definitelyGreaterThan(v1->getValue(), v2->getValue(), epsilon) );
-        break;
+        return Quantity(definitelyGreaterThan(v1.getValue(), v2.getValue(), epsilon) ? 1.0 : 0.0);
     case LTE:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for the <= operator");
-        output = new BooleanExpression(owner, definitelyLessThan(v1->getValue(), v2->getValue(), epsilon) ||
-                                       essentiallyEqual(v1->getValue(), v2->getValue(), epsilon));
-        break;
+        return Quantity(definitelyLessThan(v1.getValue(), v2.getValue(), epsilon) ||
+                        essentiallyEqual(v1.getValue(), v2.getValue(), epsilon) ? 1.0 : 0.0);
     case GTE:
-        if (v1->getUnit() != v2->getUnit())
+        if (v1.getUnit() != v2.getUnit())
             throw ExpressionError("Incompatible units for the >= operator");
-        output = new BooleanExpression(owner, essentiallyEqual(v1->getValue(), v2->getValue(), epsilon) ||
-                                       definitelyGreaterThan(v1->getValue(), v2->getValue(), epsilon));
-        break;
+        return Quantity(essentiallyEqual(v1.getValue(), v2.getValue(), epsilon) ||
+                        definitelyGreaterThan(v1.getValue(), v2.getValue(), epsilon) ? 1.0 : 0.0);
     case NEG:
-        output = new NumberExpression(owner, -v1->getQuantity() );
-        break;
+        return -v1;
     case POS:
-        output = new NumberExpression(owner, v1->getQuantity() );
-        break;
+        return v1;
     default:
-        output = 0;
         assert(0);
+        return Quantity();
     }
-
-    return output;
 }
 
 /**
@@ -938,6 +1023,25 @@ Expression * FunctionExpression::eval() const
     NumberExpression * v1 = freecad_dynamic_cast<NumberExpression>(e1.get());
     NumberExpression * v2 = freecad_dynamic_cast<NumberExpression>(e2.get());
     NumberExpression * v3 = freecad_dynamic_cast<NumberExpression>(e3.get());
+
+    return new NumberExpression(owner, apply(f,
+                                             v1 ? &v1->getQuantity() : 0,
+                                             v2 ? &v2->getQuantity() : 0,
+                                             v3 ? &v3->getQuantity() : 0,
+                                             args.size()));
+}
+
+/**
+  * Apply the non-aggregate function \a f to its evaluated arguments. Arguments
+  * that are missing or did not evaluate to a number are given as null pointers.
+  * Throws an ExpressionError exception if something fails.
+  *
+  * @returns The result of the function.
+  */
+
+Quantity FunctionExpression::apply(Function f, const Quantity * v1, const Quantity * v2,
+                                   const Quantity * v3, std::size_t numArgs)
+{
     double output;
     Unit unit;
     double scaler = 1;
@@ -1047,7 +1151,7 @@ Expression * FunctionExpression::eval() const
         if (v1->getUnit() != v2->getUnit())
             throw ExpressionError("Units must be equal");
 
-        if (args.size() > 2) {
+        if (numArgs > 2) {
             if (v3 == 0)
                 throw ExpressionError("Invalid second argument.");
             if (v2->getUnit() != v3->getUnit())
@@ -1140,7 +1244,7 @@ Expression * FunctionExpression::eval() const
         assert(0);
     }
 
-    return new NumberExpression(owner, Quantity(scaler * output, unit));
+    return Quantity(scaler * output, unit);
 }
 
 /**
@@ -1378,55 +1482,13 @@ Expression * VariableExpression::eval() const
     if (!parent->isDerivedFrom(App::DocumentObject::getClassTypeId()))
         throw ExpressionError("Property must belong to a document object.");
 
-    boost::any value = prop->getPathValue(var);
-
-    if (value.type() == typeid(Quantity)) {
-        Quantity qvalue = boost::any_cast<Quantity>(value);
+    Quantity qvalue;
+    std::string svalue;
 
+    if (pathValueToQuantity(prop->getPathValue(var), qvalue, svalue))
         return new NumberExpression(owner, qvalue);
-    }
-    else if (value.type() == typeid(double)) {
-        double dvalue = boost::any_cast<double>(value);
-
-        return new NumberExpression(owner, Quantity(dvalue));
-    }
-    else if (value.type() == typeid(float)) {
-        double fvalue = boost::any_cast<float>(value);
-
-        return new NumberExpression(owner, Quantity(fvalue));
-    }
-    else if (value.type() == typeid(int)) {
-        int ivalue = boost::any_cast<int>(value);
-
-        return new NumberExpression(owner, Quantity(ivalue));
-    }
-    else if (value.type() == typeid(long)) {
-        long lvalue = boost::any_cast<long>(value);
-
-        return new NumberExpression(owner, Quantity(lvalue));
-    }
-    else if (value.type() == typeid(bool)) {
-        double bvalue = boost::any_cast<bool>(value) ? 1.0 : 0.0;
-
-        return new NumberExpression(owner, Quantity(bvalue));
-    }
-    else if (value.type() == typeid(std::string)) {
-        std::string svalue = boost::any_cast<std::string>(value);
-
-        return new StringExpression(owner, svalue);
-    }
-    else if (value.type() == typeid(char*)) {
-        char* svalue = boost::any_cast<char*>(value);
-
-        return new StringExpression(owner, svalue);
-    }
-    else if (value.type() == typeid(const char*)) {
-        const char* svalue = boost::any_cast<const char*>(value);
-
+    else
         return new StringExpression(owner, svalue);
-    }
-
-    throw ExpressionError("Property is of invalid type.");
 }
 
 /**
@@ -1472,6 +1534,7 @@ void VariableExpression::getDeps(std::set<ObjectIdentifier> &props) const
 void VariableExpression::setPath(const ObjectIdentifier &path)
 {
      var = path;
+     invalidateLookups();
 }
 
 bool VariableExpression::validDocumentObjectRename(const std::string &oldName, const std::string &newName)
@@ -1481,6 +1544,7 @@ bool VariableExpression::validDocumentObjectRename(const std::string &oldName, c
 
 bool VariableExpression::renameDocumentObject(const std::string &oldName, const std::string &newName)
 {
+    invalidateLookups();
     return var.renameDocumentObject(oldName, newName);
 }
 
@@ -1491,6 +1555,7 @@ bool VariableExpression::validDocumentRename(const std::string &oldName, const s
 
 bool VariableExpression::renameDocument(const std::string &oldName, const std::string &newName)
 {
+    invalidateLookups();
     return var.renameDocument(oldName, newName);
 }
 
@@ -1727,6 +1792,438 @@ Expression *RangeExpression::simplify() const
 void RangeExpression::setRange(const Range &r)
 {
     range = r;
+    invalidateLookups();
+}
+
+//
+// ExpressionProgram class
+//
+
+/* Invalidates the cached lookups whenever document objects, dynamic properties
+ * or documents are added, removed or renamed.
+ */
+
+class LookupObserver {
+public:
+    LookupObserver() {
+        Application & app = GetApplication();
+
+        app.signalNewObject.connect(boost::bind(&invalidateLookups));
+        app.signalDeletedObject.connect(boost::bind(&invalidateLookups));
+        app.signalRelabelObject.connect(boost::bind(&invalidateLookups));
+        app.signalAppendDynamicProperty.connect(boost::bind(&invalidateLookups));
+        app.signalRemoveDynamicProperty.connect(boost::bind(&invalidateLookups));
+        app.signalNewDocument.connect(boost::bind(&invalidateLookups));
+        app.signalDeleteDocument.connect(boost::bind(&invalidateLookups));
+        app.signalRelabelDocument.connect(boost::bind(&invalidateLookups));
+        app.signalRenameDocument.connect(boost::bind(&invalidateLookups));
+        app.signalFinishRestoreDocument.connect(boost::bind(&invalidateLookups));
+    }
+};
+
+ExpressionProgram::ExpressionProgram(const Expression *expr)
+    : expression(expr)
+    , running(false)
+    , valid(false)
+    , maxDepth(0)
+{
+    static LookupObserver observer;
+    int depth = 0;
+
+    valid = compile(expr, depth);
+    if (valid)
+        stack.resize(maxDepth);
+}
+
+ExpressionProgram::~ExpressionProgram()
+{
+}
+
+void ExpressionProgram::emit(OpCode code, int a, int b)
+{
+    Instruction i;
+
+    i.code = code;
+    i.a = a;
+    i.b = b;
+    this->code.push_back(i);
+}
+
+/**
+  * Append the instructions computing \a e, which leave one value on the stack.
+  *
+  * @param e     Expression to compile
+  * @param depth Stack depth, updated by the instructions
+  *
+  * @returns False if \a e contains nodes that cannot be compiled.
+  */
+
+bool ExpressionProgram::compile(const Expression *e, int &depth)
+{
+    Base::Type type = e->getTypeId();
+
+    // Fold sub-expressions without references, errors are left to the evaluation
+    if (type == OperatorExpression::getClassTypeId() ||
+        type == FunctionExpression::getClassTypeId() ||
+        type == ConditionalExpression::getClassTypeId()) {
+        std::set<ObjectIdentifier> deps;
+
+        e->getDeps(deps);
+        if (deps.empty()) {
+            try {
+                std::unique_ptr<Expression> value(e->eval());
+                NumberExpression * n = freecad_dynamic_cast<NumberExpression>(value.get());
+                StringExpression * s = freecad_dynamic_cast<StringExpression>(value.get());
+
+                if (n) {
+                    numbers.push_back(n->getQuantity());
+                    emit(PushNumber, static_cast<int>(numbers.size() - 1));
+                }
+                else if (s) {
+                    strings.push_back(s->getText());
+                    emit(PushString, static_cast<int>(strings.size() - 1));
+                }
+                if (n || s) {
+                    if (++depth > maxDepth)
+                        maxDepth = depth;
+                    return true;
+                }
+            }
+            catch (...) {
+            }
+        }
+    }
+
+    if (type == NumberExpression::getClassTypeId() ||
+        type == ConstantExpression::getClassTypeId() ||
+        type == BooleanExpression::getClassTypeId() ||
+        type == UnitExpression::getClassTypeId()) {
+        numbers.push_back(static_cast<const UnitExpression*>(e)->getQuantity());
+        emit(PushNumber, static_cast<int>(numbers.size() - 1));
+        if (++depth > maxDepth)
+            maxDepth = depth;
+    }
+    else if (type == StringExpression::getClassTypeId()) {
+        strings.push_back(static_cast<const StringExpression*>(e)->getText());
+        emit(PushString, static_cast<int>(strings.size() - 1));
+        if (++depth > maxDepth)
+            maxDepth = depth;
+    }
+    else if (type == VariableExpression::getClassTypeId()) {
+        Variable var;
+
+        var.node = static_cast<const VariableExpression*>(e);
+        var.prop = 0;
+        var.epoch = 0;
+        variables.push_back(var);
+        emit(PushVariable, static_cast<int>(variables.size() - 1));
+        if (++depth > maxDepth)
+            maxDepth = depth;
+    }
+    else if (type == OperatorExpression::getClassTypeId()) {
+        const OperatorExpression * o = static_cast<const OperatorExpression*>(e);
+
+        if (!compile(o->getLeft(), depth) || !compile(o->getRight(), depth))
+            return false;
+        emit(Operator, o->getOperator());
+        --depth;
+    }
+    else if (type == FunctionExpression::getClassTypeId()) {
+        const FunctionExpression * f = static_cast<const FunctionExpression*>(e);
+
+        if (f->args.empty())
+            return false;
+
+        if (f->f > FunctionExpression::AGGREGATES) {
+            AggregateCall call;
+
+            call.f = f->f;
+
+            // The arguments are run one by one while aggregating, jump over them
+            std::size_t jump = code.size();
+            emit(Jump);
+
+            for (std::vector<Expression*>::const_iterator it = f->args.begin(); it != f->args.end(); ++it) {
+                AggregateArg arg;
+
+                if ((*it)->isDerivedFrom(RangeExpression::getClassTypeId())) {
+                    RangeRef range;
+
+                    range.node = static_cast<const RangeExpression*>(*it);
+                    range.owner = f->getOwner();
+                    range.epoch = 0;
+                    ranges.push_back(range);
+                    arg.range = static_cast<int>(ranges.size() - 1);
+                    arg.begin = arg.end = 0;
+                }
+                else {
+                    arg.range = -1;
+                    arg.begin = code.size();
+                    if (!compile(*it, depth))
+                        return false;
+                    arg.end = code.size();
+                    --depth;
+                }
+                call.args.push_back(arg);
+            }
+
+            code[jump].a = static_cast<int>(code.size());
+            aggregates.push_back(call);
+            emit(Aggregate, static_cast<int>(aggregates.size() - 1));
+            if (++depth > maxDepth)
+                maxDepth = depth;
+        }
+        else {
+            // Like FunctionExpression::eval(), only the first three arguments are evaluated
+            std::size_t n = std::min<std::size_t>(f->args.size(), 3);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!compile(f->args[i], depth))
+                    return false;
+            }
+            emit(Function, f->f, static_cast<int>(f->args.size()));
+            depth -= static_cast<int>(n) - 1;
+        }
+    }
+    else if (type == ConditionalExpression::getClassTypeId()) {
+        const ConditionalExpression * c = static_cast<const ConditionalExpression*>(e);
+
+        if (!compile(c->condition, depth))
+            return false;
+        std::size_t jumpIfFalse = code.size();
+        emit(JumpIfFalse);
+        --depth;
+
+        if (!compile(c->trueExpr, depth))
+            return false;
+        std::size_t jump = code.size();
+        emit(Jump);
+        --depth;
+
+        code[jumpIfFalse].a = static_cast<int>(code.size());
+        if (!compile(c->falseExpr, depth))
+            return false;
+        code[jump].a = static_cast<int>(code.size());
+    }
+    else {
+        // Unknown node types, and ranges outside of aggregates
+        return false;
+    }
+
+    return true;
+}
+
+/**
+  * Evaluate the program. Gives the same result, or throws the same exception,
+  * as Expression::eval() of the compiled expression.
+  *
+  * @returns A new NumberExpression or StringExpression with the result.
+  */
+
+Expression *ExpressionProgram::eval() const
+{
+    // The value stack is shared, fall back to the expression tree when reentered
+    if (running)
+        return expression->eval();
+
+    class resetter {
+    public:
+        resetter(bool & b) : _b(b) { _b = true; }
+        ~resetter() { _b = false; }
+
+    private:
+        bool & _b;
+    };
+
+    resetter r(running);
+    std::size_t sp = 0;
+
+    run(0, code.size(), sp);
+    assert(sp == 1);
+
+    const Value & result = stack[0];
+
+    if (result.isNumber)
+        return new NumberExpression(expression->getOwner(), result.quantity);
+    else
+        return new StringExpression(expression->getOwner(), result.text);
+}
+
+/**
+  * Run the instructions in [\a pc, \a end), with \a sp pointing above the topmost value.
+  */
+
+void ExpressionProgram::run(std::size_t pc, std::size_t end, std::size_t &sp) const
+{
+    while (pc < end) {
+        const Instruction & i = code[pc++];
+
+        switch (i.code) {
+        case PushNumber:
+            stack[sp].quantity = numbers[i.a];
+            stack[sp].isNumber = true;
+            ++sp;
+            break;
+        case PushString:
+            stack[sp].text = strings[i.a];
+            stack[sp].isNumber = false;
+            ++sp;
+            break;
+        case PushVariable:
+            loadVariable(variables[i.a], stack[sp]);
+            ++sp;
+            break;
+        case Operator: {
+            Value & v1 = stack[sp - 2];
+            const Value & v2 = stack[sp - 1];
+
+            if (!v1.isNumber || !v2.isNumber)
+                throw ExpressionError("Invalid expression");
+
+            v1.quantity = OperatorExpression::apply(static_cast<OperatorExpression::Operator>(i.a), v1.quantity, v2.quantity);
+            --sp;
+            break;
+        }
+        case Function: {
+            std::size_t n = std::min<std::size_t>(i.b, 3);
+            Value * v = &stack[sp - n];
+            Quantity output = FunctionExpression::apply(static_cast<FunctionExpression::Function>(i.a),
+                                                        v[0].isNumber ? &v[0].quantity : 0,
+                                                        n > 1 && v[1].isNumber ? &v[1].quantity : 0,
+                                                        n > 2 && v[2].isNumber ? &v[2].quantity : 0,
+                                                        i.b);
+
+            v[0].quantity = output;
+            v[0].isNumber = true;
+            sp -= n - 1;
+            break;
+        }
+        case Aggregate:
+            evalAggregate(aggregates[i.a], sp);
+            break;
+        case JumpIfFalse: {
+            const Value & v = stack[--sp];
+
+            if (!v.isNumber)
+                throw ExpressionError("Invalid expression");
+
+            if (!(fabs(v.quantity.getValue()) > 0.5))
+                pc = i.a;
+            break;
+        }
+        case Jump:
+            pc = i.a;
+            break;
+        }
+    }
+}
+
+/**
+  * Load the value of variable \a var into \a value. The property is looked up
+  * again only if something it depends on has changed since the last lookup.
+  */
+
+void ExpressionProgram::loadVariable(const Variable &var, Value &value) const
+{
+    if (!var.prop || var.epoch != resolveEpoch) {
+        var.prop = 0;
+        var.prop = var.node->getProperty();
+        var.epoch = resolveEpoch;
+    }
+
+    PropertyContainer * parent = var.prop->getContainer();
+
+    if (!parent->isDerivedFrom(App::DocumentObject::getClassTypeId()))
+        throw ExpressionError("Property must belong to a document object.");
+
+    value.isNumber = pathValueToQuantity(var.prop->getPathValue(var.node->var), value.quantity, value.text);
+}
+
+const std::vector<const Property*> &ExpressionProgram::resolveRange(const RangeRef &range) const
+{
+    if (range.epoch != resolveEpoch) {
+        Range i(range.node->getRange());
+
+        range.props.clear();
+        do {
+            range.props.push_back(range.owner->getPropertyByName(i.address().c_str()));
+        } while (i.next());
+        range.epoch = resolveEpoch;
+    }
+
+    return range.props;
+}
+
+/**
+  * Push the result of an aggregate function, see FunctionExpression::evalAggregate().
+  */
+
+void ExpressionProgram::evalAggregate(const AggregateCall &call, std::size_t &sp) const
+{
+    SumCollector sum;
+    AverageCollector average;
+    StdDevCollector stddev;
+    CountCollector count;
+    MinCollector minimum;
+    MaxCollector maximum;
+    Collector * c;
+
+    switch (call.f) {
+    case FunctionExpression::SUM:
+        c = &sum;
+        break;
+    case FunctionExpression::AVERAGE:
+        c = &average;
+        break;
+    case FunctionExpression::STDDEV:
+        c = &stddev;
+        break;
+    case FunctionExpression::COUNT:
+        c = &count;
+        break;
+    case FunctionExpression::MIN:
+        c = &minimum;
+        break;
+    case FunctionExpression::MAX:
+        c = &maximum;
+        break;
+    default:
+        assert(false);
+        c = &sum;
+    }
+
+    for (std::vector<AggregateArg>::const_iterator it = call.args.begin(); it != call.args.end(); ++it) {
+        if (it->range >= 0) {
+            const std::vector<const Property*> & props = resolveRange(ranges[it->range]);
+
+            for (std::vector<const Property*>::const_iterator p = props.begin(); p != props.end(); ++p) {
+                const PropertyQuantity * qp;
+                const PropertyFloat * fp;
+
+                if (!*p)
+                    continue;
+
+                if ((qp = freecad_dynamic_cast<PropertyQuantity>(*p)) != 0)
+                    c->collect(qp->getQuantityValue());
+                else if ((fp = freecad_dynamic_cast<PropertyFloat>(*p)) != 0)
+                    c->collect(Quantity(fp->getValue()));
+                else
+                    throw Expression::Exception("Invalid property type for aggregate");
+            }
+        }
+        else {
+            run(it->begin, it->end, sp);
+
+            const Value & v = stack[--sp];
+
+            if (v.isNumber)
+                c->collect(v.quantity);
+        }
+    }
+
+    stack[sp].quantity = c->getQuantity();
+    stack[sp].isNumber = true;
+    ++sp;
 }
 
 namespace App {
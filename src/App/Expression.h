@@ -24,6 +24,8 @@
 #define EXPRESSION_H
 
 #include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <Base/Exception.h>
 #include <Base/Unit.h>
@@ -39,6 +41,7 @@ namespace App  {
 
 class DocumentObject;
 class Expression;
+class ExpressionProgram;
 class Document;
 
 class AppExport ExpressionVisitor {
@@ -107,8 +110,11 @@ public:
 
     virtual boost::any getValueAsAny() const { static boost::any empty; return empty; }
 
+    Expression * evalCompiled() const;
+
 protected:
     const App::DocumentObject * owner; /**< The document object used to access unqualified variables (i.e local scope) */
+    mutable boost::shared_ptr<ExpressionProgram> program; /**< Compiled form, built by evalCompiled() */
 };
 
 /**
@@ -252,6 +258,8 @@ public:
 
     Expression * getRight() const { return right; }
 
+    static Base::Quantity apply(Operator op, const Base::Quantity & v1, const Base::Quantity & v2);
+
 protected:
 
     virtual bool isCommutative() const;
@@ -289,6 +297,7 @@ public:
     virtual void visit(ExpressionVisitor & v);
 
 protected:
+    friend class ExpressionProgram;
 
     Expression * condition;  /**< Condition */
     Expression * trueExpr;  /**< Expression if abs(condition) is > 0.5 */
@@ -365,7 +374,12 @@ public:
 
     virtual void visit(ExpressionVisitor & v);
 
+    static Base::Quantity apply(Function f, const Base::Quantity * v1, const Base::Quantity * v2,
+                                const Base::Quantity * v3, std::size_t numArgs);
+
 protected:
+    friend class ExpressionProgram;
+
     Expression *evalAggregate() const;
 
     Function f;        /**< Function to execute */
@@ -418,6 +432,7 @@ public:
     const App::Property *getProperty() const;
 
 protected:
+    friend class ExpressionProgram;
 
     ObjectIdentifier var; /**< Variable name  */
 };
@@ -478,6 +493,103 @@ protected:
     Range range;
 };
 
+/**
+  * Compiled form of an expression tree.
+  *
+  * The tree is lowered into a flat sequence of stack machine instructions.
+  * Sub-expressions that do not reference any property are folded into
+  * constants, so their unit checks are done once at compile time. The
+  * properties referenced by variables and ranges are looked up on first use,
+  * and looked up again only after document objects, dynamic properties or
+  * documents were added, removed or renamed, or the expression was rewritten.
+  *
+  * Evaluation gives the same results and errors as Expression::eval(), but
+  * does not create intermediate Expression objects.
+  */
+
+class AppExport ExpressionProgram {
+public:
+    ExpressionProgram(const Expression * expr);
+
+    ~ExpressionProgram();
+
+    /// The expression the program was compiled from
+    const Expression * getExpression() const { return expression; }
+
+    /// False if the expression contains nodes that cannot be compiled
+    bool isValid() const { return valid; }
+
+    /// Evaluates the program, returns a new NumberExpression or StringExpression
+    Expression * eval() const;
+
+private:
+    enum OpCode {
+        PushNumber,     /**< Push numbers[a] */
+        PushString,     /**< Push strings[a] */
+        PushVariable,   /**< Push the value of variables[a] */
+        Operator,       /**< Replace the two topmost values by the result of operator a */
+        Function,       /**< Replace the topmost min(b, 3) values by the result of function a with b arguments */
+        Aggregate,      /**< Push the result of aggregates[a] */
+        JumpIfFalse,    /**< Pop the condition, jump to a if it is false */
+        Jump            /**< Jump to a */
+    };
+
+    struct Instruction {
+        OpCode code;
+        int a;
+        int b;
+    };
+
+    struct Value {
+        Base::Quantity quantity;
+        std::string text;
+        bool isNumber;
+    };
+
+    struct Variable {
+        const VariableExpression * node;
+        mutable const App::Property * prop;
+        mutable unsigned long epoch;
+    };
+
+    struct RangeRef {
+        const RangeExpression * node;
+        const App::DocumentObject * owner;
+        mutable std::vector<const App::Property*> props;
+        mutable unsigned long epoch;
+    };
+
+    struct AggregateArg {
+        int range;          /**< Index into ranges, or -1 for an expression */
+        std::size_t begin;  /**< Code of the expression */
+        std::size_t end;
+    };
+
+    struct AggregateCall {
+        FunctionExpression::Function f;
+        std::vector<AggregateArg> args;
+    };
+
+    bool compile(const Expression * e, int & depth);
+    void emit(OpCode code, int a = 0, int b = 0);
+    void run(std::size_t pc, std::size_t end, std::size_t & sp) const;
+    void loadVariable(const Variable & var, Value & value) const;
+    const std::vector<const App::Property*> & resolveRange(const RangeRef & range) const;
+    void evalAggregate(const AggregateCall & call, std::size_t & sp) const;
+
+    const Expression * expression;
+    std::vector<Instruction> code;
+    std::vector<Base::Quantity> numbers;
+    std::vector<std::string> strings;
+    std::vector<Variable> variables;
+    std::vector<RangeRef> ranges;
+    std::vector<AggregateCall> aggregates;
+    mutable std::vector<Value> stack;
+    mutable bool running;
+    bool valid;
+    int maxDepth;
+};
+
 namespace ExpressionParser {
 AppExport Expression * parse(const App::DocumentObject *owner, const char *buffer);
 AppExport UnitExpression * parseUnit(const App::DocumentObject *owner, const char *buffer);
@@ -618,7 +618,7 @@ DocumentObjectExecReturn *App::PropertyExpressionEngine::execute()
             throw Base::RuntimeError("Invalid property owner.");
 
         // Evaluate expression
-        std::unique_ptr<Expression> e(expressions[*it].expression->eval());
+        std::unique_ptr<Expression> e(expressions[*it].expression->evalCompiled());
 
 #ifdef FC_PROPERTYEXPRESSIONENGINE_LOG
         {
@@ -124,6 +124,8 @@ void DlgDisplayPropertiesImp::OnChange(Gui::SelectionSingleton::SubjectType &rCa
     Q_UNUSED(rCaller); 
     if (Reason.Type == SelectionChanges::AddSelection ||
         Reason.Type == SelectionChanges::RmvSelection ||
+        Reason.Type == SelectionChanges::AddSubSelections ||
+        Reason.Type == SelectionChanges::RmvSubSelections ||
         Reason.Type == SelectionChanges::SetSelection ||
         Reason.Type == SelectionChanges::ClrSelection) {
         std::vector<Gui::ViewProvider*> views = getSelection();
@@ -53,6 +53,23 @@ FC_LOG_LEVEL_INIT("Selection",false,true,true)
 using namespace Gui;
 using namespace std;
 
+std::vector<SelectionChanges> SelectionChanges::splitSubSelections() const
+{
+    std::vector<SelectionChanges> changes;
+    if (!pSubNames)
+        return changes;
+
+    SelectionChanges single(*this);
+    single.Type = (Type == AddSubSelections) ? AddSelection : RmvSelection;
+    single.pSubNames = 0;
+    changes.reserve(pSubNames->size());
+    for (std::vector<std::string>::const_iterator it = pSubNames->begin(); it != pSubNames->end(); ++it) {
+        single.pSubName = it->c_str();
+        changes.push_back(single);
+    }
+    return changes;
+}
+
 SelectionObserver::SelectionObserver() : blockSelection(false)
 {
     attachSelection();
@@ -78,6 +95,11 @@ bool SelectionObserver::isConnectionBlocked() const
     return blockSelection;
 }
 
+bool SelectionObserver::handlesSubSelections() const
+{
+    return false;
+}
+
 void SelectionObserver::attachSelection()
 {
     if (!connectSelection.connected()) {
@@ -90,7 +112,14 @@ void SelectionObserver::_onSelectionChanged(const SelectionChanges& msg) {
     try {
         if (blockSelection)
             return;
-        onSelectionChanged(msg);
+        if (msg.pSubNames && !handlesSubSelections()) {
+            std::vector<SelectionChanges> changes = msg.splitSubSelections();
+            for (std::vector<SelectionChanges>::iterator it = changes.begin(); it != changes.end(); ++it)
+                onSelectionChanged(*it);
+        }
+        else {
+            onSelectionChanged(msg);
+        }
     } catch (Base::Exception &e) {
         e.ReportException();
         FC_ERR("Unhandled Base::Exception caught in selection observer: ");
@@ -643,6 +672,40 @@ App::Document* SelectionSingleton::getDocument(const char* pDocName) const
         return App::GetApplication().getActiveDocument();
 }
 
+const SelectionSingleton::_SubIndex* SelectionSingleton::findObject(const char* pDocName, const char* pObjectName) const
+{
+    _SelIndex::const_iterator it = _SelMap.find(std::make_pair(std::string(pDocName ? pDocName : ""),
+                                                               std::string(pObjectName ? pObjectName : "")));
+    if (it == _SelMap.end())
+        return 0;
+    return &it->second;
+}
+
+void SelectionSingleton::appendSelection(const _SelObj& obj)
+{
+    _SelList.push_back(obj);
+    std::list<_SelObj>::iterator it = _SelList.end();
+    _SelMap[std::make_pair(obj.DocName, obj.FeatName)][obj.SubName] = --it;
+}
+
+void SelectionSingleton::eraseSelection(std::list<_SelObj>::iterator it)
+{
+    _SelIndex::iterator jt = _SelMap.find(std::make_pair(it->DocName, it->FeatName));
+    if (jt != _SelMap.end()) {
+        jt->second.erase(it->SubName);
+        if (jt->second.empty())
+            _SelMap.erase(jt);
+    }
+    _SelList.erase(it);
+}
+
+void SelectionSingleton::rebuildIndex()
+{
+    _SelMap.clear();
+    for (std::list<_SelObj>::iterator it = _SelList.begin(); it != _SelList.end(); ++it)
+        _SelMap[std::make_pair(it->DocName, it->FeatName)][it->SubName] = it;
+}
+
 bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectName, const char* pSubName, float x, float y, float z)
 {
     // already in ?
@@ -689,7 +752,7 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
         if (temp.pObject)
             temp.TypeName = temp.pObject->getTypeId().getName();
 
-        _SelList.push_back(temp);
+        appendSelection(temp);
 
         SelectionChanges Chng;
 
@@ -738,40 +801,61 @@ bool SelectionSingleton::addSelection(const char* pDocName, const char* pObjectN
 
         temp.DocName  = pDocName;
         temp.FeatName = pObjectName ? pObjectName : "";
-        if (!pSubNames.empty()) {
-            for (std::vector<std::string>::const_iterator it = pSubNames.begin(); it != pSubNames.end(); ++it) {
-                temp.SubName  = it->c_str();
-                temp.x        = 0;
-                temp.y        = 0;
-                temp.z        = 0;
-
-                _SelList.push_back(temp);
+        temp.x        = 0;
+        temp.y        = 0;
+        temp.z        = 0;
+
+        std::vector<std::string> subNames(pSubNames);
+        if (subNames.empty())
+            subNames.push_back(std::string());
+
+        std::vector<std::string> added;
+        bool allowed = false;
+        for (std::vector<std::string>::const_iterator it = subNames.begin(); it != subNames.end(); ++it) {
+            const _SubIndex* subs = findObject(temp.DocName.c_str(), temp.FeatName.c_str());
+            if (subs && subs->find(*it) != subs->end()) {
+                allowed = true;
+                continue;
             }
-        }
-        else {
-            temp.SubName  = "";
-            temp.x        = 0;
-            temp.y        = 0;
-            temp.z        = 0;
-            _SelList.push_back(temp);
-        }
 
-        SelectionChanges Chng;
+            // the sub-elements rejected by a selection gate are skipped silently
+            if (ActiveGate && !ActiveGate->allow(temp.pDoc, temp.pObject, it->c_str())) {
+                ActiveGate->notAllowedReason.clear();
+                continue;
+            }
 
-        Chng.pDocName  = pDocName;
-        Chng.pObjectName = pObjectName ? pObjectName : "";
-        Chng.pSubName  = "";
-        Chng.pTypeName = temp.TypeName.c_str();
-        Chng.x         = 0;
-        Chng.y         = 0;
-        Chng.z         = 0;
-        Chng.Type      = SelectionChanges::AddSelection;
+            temp.SubName = *it;
+            appendSelection(temp);
+            added.push_back(*it);
+            allowed = true;
+        }
 
-        Notify(Chng);
-        signalSelectionChanged(Chng);
+        // the observers are notified once after the loop as they may change
+        // the selection, with the list of the sub-elements actually added
+        if (!added.empty()) {
+            SelectionChanges Chng;
+
+            Chng.pDocName  = temp.DocName.c_str();
+            Chng.pObjectName = temp.FeatName.c_str();
+            Chng.pTypeName = temp.TypeName.c_str();
+            Chng.x         = 0;
+            Chng.y         = 0;
+            Chng.z         = 0;
+            if (added.size() == 1) {
+                Chng.pSubName  = added.front().c_str();
+                Chng.Type      = SelectionChanges::AddSelection;
+            }
+            else {
+                Chng.pSubName  = "";
+                Chng.pSubNames = &added;
+                Chng.Type      = SelectionChanges::AddSubSelections;
+            }
 
-        // allow selection
-        return true;
+            Notify(Chng);
+            signalSelectionChanged(Chng);
+        }
+
+        return allowed;
     }
     else {
         // neither an existing nor active document available
@@ -818,30 +902,56 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
     std::string tmpSubName;
     std::string tmpTypName;
 
-    for (std::list<_SelObj>::iterator It = _SelList.begin();It != _SelList.end();) {
-        if ((It->DocName == pDocName && !pObjectName) ||
-            (It->DocName == pDocName && pObjectName && It->FeatName == pObjectName && !pSubName) ||
-            (It->DocName == pDocName && pObjectName && It->FeatName == pObjectName && pSubName && It->SubName == pSubName))
-        {
-            // save in tmp. string vars
-            tmpDocName = It->DocName;
-            tmpFeaName = It->FeatName;
-            tmpSubName = It->SubName;
-            tmpTypName = It->TypeName;
+    if (!pObjectName) {
+        for (std::list<_SelObj>::iterator It = _SelList.begin();It != _SelList.end();) {
+            if (It->DocName == pDocName) {
+                // save in tmp. string vars
+                tmpDocName = It->DocName;
+                tmpFeaName = It->FeatName;
+                tmpSubName = It->SubName;
+                tmpTypName = It->TypeName;
+
+                // destroy the _SelObj item
+                eraseSelection(It++);
+
+                foundSelection = true;
+            }
+            else {
+                ++It;
+            }
+        }
+    }
+    else if (const _SubIndex* subs = findObject(pDocName, pObjectName)) {
+        std::vector<std::list<_SelObj>::iterator> items;
+        if (!pSubName) {
+            for (_SubIndex::const_iterator It = subs->begin(); It != subs->end(); ++It)
+                items.push_back(It->second);
+        }
+        else {
+            _SubIndex::const_iterator It = subs->find(pSubName);
+            if (It != subs->end())
+                items.push_back(It->second);
+        }
+
+        for (std::vector<std::list<_SelObj>::iterator>::iterator It = items.begin(); It != items.end(); ++It) {
+            // save in tmp. string vars, if several sub-elements of the object
+            // are removed at once the whole object is reported
+            tmpDocName = (*It)->DocName;
+            tmpFeaName = (*It)->FeatName;
+            tmpSubName = items.size() == 1 ? (*It)->SubName : std::string();
+            tmpTypName = (*It)->TypeName;
 
             // destroy the _SelObj item
-            It = _SelList.erase(It);
+            eraseSelection(*It);
 
             foundSelection = true;
+        }
+    }
 
 #ifdef FC_DEBUG
-            Base::Console().Log("Sel : Rmv Selection \"%s.%s.%s\"\n",pDocName,pObjectName,pSubName);
+    if (foundSelection)
+        Base::Console().Log("Sel : Rmv Selection \"%s.%s.%s\"\n",pDocName,pObjectName,pSubName);
 #endif
-        }
-        else {
-            ++It;
-        }
-    }
 
     // NOTE: It can happen that there are nested calls of rmvSelection()
     // so that it's not safe to invoke the notifications inside the loop
@@ -860,6 +970,50 @@ void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectN
     }
 }
 
+void SelectionSingleton::rmvSelection(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames)
+{
+    std::string tmpDocName;
+    std::string tmpFeaName;
+    std::string tmpTypName;
+    std::vector<std::string> removed;
+
+    for (std::vector<std::string>::const_iterator it = pSubNames.begin(); it != pSubNames.end(); ++it) {
+        // the index entry of the object is gone with its last sub-element
+        const _SubIndex* subs = findObject(pDocName, pObjectName);
+        if (!subs)
+            break;
+
+        _SubIndex::const_iterator jt = subs->find(*it);
+        if (jt != subs->end()) {
+            tmpDocName = jt->second->DocName;
+            tmpFeaName = jt->second->FeatName;
+            tmpTypName = jt->second->TypeName;
+            removed.push_back(jt->second->SubName);
+            eraseSelection(jt->second);
+        }
+    }
+
+    // as in rmvSelection() above the notification is done after the loop,
+    // once with the list of the sub-elements actually removed
+    if (!removed.empty()) {
+        SelectionChanges Chng;
+        Chng.pDocName  = tmpDocName.c_str();
+        Chng.pObjectName = tmpFeaName.c_str();
+        Chng.pTypeName = tmpTypName.c_str();
+        if (removed.size() == 1) {
+            Chng.pSubName  = removed.front().c_str();
+            Chng.Type      = SelectionChanges::RmvSelection;
+        }
+        else {
+            Chng.pSubName  = "";
+            Chng.pSubNames = &removed;
+            Chng.Type      = SelectionChanges::RmvSubSelections;
+        }
+        Notify(Chng);
+        signalSelectionChanged(Chng);
+    }
+}
+
 void SelectionSingleton::setSelection(const char* pDocName, const std::vector<App::DocumentObject*>& sel)
 {
     App::Document *pcDoc;
@@ -905,6 +1059,7 @@ void SelectionSingleton::setSelection(const char* pDocName, const std::vector<Ap
         return;
 
     _SelList = temp;
+    rebuildIndex();
 
     SelectionChanges Chng;
     Chng.Type = SelectionChanges::SetSelection;
@@ -932,14 +1087,13 @@ void SelectionSingleton::clearSelection(const char* pDocName)
             docName = pDocName;
         else
             docName = pDoc->getName(); // active document
-        std::list<_SelObj> selList;
-        for (std::list<_SelObj>::iterator it = _SelList.begin(); it != _SelList.end(); ++it) {
-            if (it->DocName != docName)
-                selList.push_back(*it);
+        for (std::list<_SelObj>::iterator it = _SelList.begin(); it != _SelList.end();) {
+            if (it->DocName == docName)
+                eraseSelection(it++);
+            else
+                ++it;
         }
 
-        _SelList = selList;
-
         SelectionChanges Chng;
         Chng.Type = SelectionChanges::ClrSelection;
         Chng.pDocName = docName.c_str();
@@ -959,6 +1113,7 @@ void SelectionSingleton::clearSelection(const char* pDocName)
 void SelectionSingleton::clearCompleteSelection()
 {
     _SelList.clear();
+    _SelMap.clear();
 
     SelectionChanges Chng;
     Chng.Type = SelectionChanges::ClrSelection;
@@ -978,32 +1133,22 @@ void SelectionSingleton::clearCompleteSelection()
 
 bool SelectionSingleton::isSelected(const char* pDocName, const char* pObjectName, const char* pSubName) const
 {
-    const char* tmpDocName = pDocName ? pDocName : "";
-    const char* tmpFeaName = pObjectName ? pObjectName : "";
-    const char* tmpSubName = pSubName ? pSubName : "";
-    for (std::list<_SelObj>::const_iterator It = _SelList.begin();It != _SelList.end();++It)
-        if (It->DocName == tmpDocName && It->FeatName == tmpFeaName && It->SubName == tmpSubName)
-            return true;
-    return false;
+    const _SubIndex* subs = findObject(pDocName, pObjectName);
+    if (!subs)
+        return false;
+    return subs->find(pSubName ? pSubName : "") != subs->end();
 }
 
 bool SelectionSingleton::isSelected(App::DocumentObject* obj, const char* pSubName) const
 {
-    if (!obj) return false;
+    if (!obj || !obj->getNameInDocument()) return false;
 
-    for(list<_SelObj>::const_iterator It = _SelList.begin();It != _SelList.end();++It) {
-        if (It->pObject == obj) {
-            if (pSubName) {
-                if (It->SubName == pSubName)
-                    return true;
-            }
-            else {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    const _SubIndex* subs = findObject(obj->getDocument()->getName(), obj->getNameInDocument());
+    if (!subs)
+        return false;
+    if (pSubName)
+        return subs->find(pSubName) != subs->end();
+    return true;
 }
 
 void SelectionSingleton::slotDeletedObject(const App::DocumentObject& Obj)
@@ -1068,9 +1213,14 @@ void SelectionSingleton::destruct (void)
 PyMethodDef SelectionSingleton::Methods[] = {
     {"addSelection",         (PyCFunction) SelectionSingleton::sAddSelection, METH_VARARGS,
      "addSelection(object,[string,float,float,float]) -- Add an object to the selection\n"
-     "where string is the sub-element name and the three floats represent a 3d point"},
+     "where string is the sub-element name and the three floats represent a 3d point\n"
+     "addSelection(object,list) -- Add a list or tuple of sub-element names at once,\n"
+     "the C++ observers are notified once, Python observers once per sub-element"},
     {"removeSelection",      (PyCFunction) SelectionSingleton::sRemoveSelection, METH_VARARGS,
-     "removeSelection(object) -- Remove an object from the selection"},
+     "removeSelection(object,[string|list]) -- Remove an object from the selection\n"
+     "where string is the sub-element name, with a list or tuple of sub-element\n"
+     "names they are removed at once, the C++ observers are notified once and\n"
+     "Python observers once per sub-element"},
     {"clearSelection"  ,     (PyCFunction) SelectionSingleton::sClearSelection, METH_VARARGS,
      "clearSelection([string]) -- Clear the selection\n"
      "Clear the selection to the given document name. If no document is\n"
@@ -1161,11 +1311,16 @@ PyObject *SelectionSingleton::sAddSelection(PyObject * /*self*/, PyObject *args)
         try {
             if (PyTuple_Check(sequence) || PyList_Check(sequence)) {
                 Py::Sequence list(sequence);
+                std::vector<std::string> subnames;
                 for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
-                    std::string subname = static_cast<std::string>(Py::String(*it));
+                    subnames.push_back(static_cast<std::string>(Py::String(*it)));
+                }
+
+                // an empty list would select the whole object
+                if (!subnames.empty()) {
                     Selection().addSelection(docObj->getDocument()->getName(),
                                              docObj->getNameInDocument(),
-                                             subname.c_str());
+                                             subnames);
                 }
 
                 Py_Return;
@@ -1184,21 +1339,53 @@ PyObject *SelectionSingleton::sRemoveSelection(PyObject * /*self*/, PyObject *ar
 {
     PyObject *object;
     char* subname=0;
-    if (!PyArg_ParseTuple(args, "O!|s", &(App::DocumentObjectPy::Type),&object,&subname))
-        return NULL;
+    if (PyArg_ParseTuple(args, "O!|s", &(App::DocumentObjectPy::Type),&object,&subname)) {
+        App::DocumentObjectPy* docObjPy = static_cast<App::DocumentObjectPy*>(object);
+        App::DocumentObject* docObj = docObjPy->getDocumentObjectPtr();
+        if (!docObj || !docObj->getNameInDocument()) {
+            PyErr_SetString(Base::BaseExceptionFreeCADError, "Cannot check invalid object");
+            return NULL;
+        }
 
-    App::DocumentObjectPy* docObjPy = static_cast<App::DocumentObjectPy*>(object);
-    App::DocumentObject* docObj = docObjPy->getDocumentObjectPtr();
-    if (!docObj || !docObj->getNameInDocument()) {
-        PyErr_SetString(Base::BaseExceptionFreeCADError, "Cannot check invalid object");
-        return NULL;
+        Selection().rmvSelection(docObj->getDocument()->getName(),
+                                 docObj->getNameInDocument(),
+                                 subname);
+
+        Py_Return;
     }
 
-    Selection().rmvSelection(docObj->getDocument()->getName(),
-                             docObj->getNameInDocument(),
-                             subname);
+    PyErr_Clear();
+    PyObject *sequence;
+    if (PyArg_ParseTuple(args, "O!O", &(App::DocumentObjectPy::Type),&object,&sequence)) {
+        App::DocumentObjectPy* docObjPy = static_cast<App::DocumentObjectPy*>(object);
+        App::DocumentObject* docObj = docObjPy->getDocumentObjectPtr();
+        if (!docObj || !docObj->getNameInDocument()) {
+            PyErr_SetString(Base::BaseExceptionFreeCADError, "Cannot check invalid object");
+            return NULL;
+        }
 
-    Py_Return;
+        try {
+            if (PyTuple_Check(sequence) || PyList_Check(sequence)) {
+                Py::Sequence list(sequence);
+                std::vector<std::string> subnames;
+                for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                    subnames.push_back(static_cast<std::string>(Py::String(*it)));
+                }
+
+                Selection().rmvSelection(docObj->getDocument()->getName(),
+                                         docObj->getNameInDocument(),
+                                         subnames);
+
+                Py_Return;
+            }
+        }
+        catch (const Py::Exception&) {
+            // do nothing here
+        }
+    }
+
+    PyErr_SetString(PyExc_ValueError, "type must be 'DocumentObject[,subname]' or 'DocumentObject, list or tuple of subnames'");
+    return 0;
 }
 
 PyObject *SelectionSingleton::sClearSelection(PyObject * /*self*/, PyObject *args)
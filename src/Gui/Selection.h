@@ -31,6 +31,7 @@
 #include <list>
 #include <map>
 #include <boost/signals2.hpp>
+#include <boost/unordered_map.hpp>
 #include <CXX/Objects.hxx>
 
 #include <Base/Observer.h>
@@ -69,7 +70,9 @@ public:
         SetSelection,
         ClrSelection,
         SetPreselect,
-        RmvPreselect
+        RmvPreselect,
+        AddSubSelections,   ///< several sub-elements of an object were added, see pSubNames
+        RmvSubSelections    ///< several sub-elements of an object were removed, see pSubNames
     };
     SelectionChanges()
     : Type(ClrSelection)
@@ -77,16 +80,25 @@ public:
     , pObjectName(0)
     , pSubName(0)
     , pTypeName(0)
+    , pSubNames(0)
     , x(0),y(0),z(0)
     {
     }
 
+    /** Splits an AddSubSelections or RmvSubSelections change into one
+     * AddSelection or RmvSelection change for each sub-element. The changes
+     * refer to the names of this one, so they must not outlive it.
+     */
+    std::vector<SelectionChanges> splitSubSelections() const;
+
     MsgType Type;
 
     const char* pDocName;
     const char* pObjectName;
     const char* pSubName;
     const char* pTypeName;
+    /// the sub-elements of AddSubSelections and RmvSubSelections, pSubName is empty then
+    const std::vector<std::string>* pSubNames;
     float x;
     float y;
     float z;
@@ -140,6 +152,12 @@ public:
     /** Detaches from the selection. */
     void detachSelection();
 
+protected:
+    /** Observers that handle AddSubSelections and RmvSubSelections return true.
+     * All others get one AddSelection or RmvSelection for each sub-element.
+     */
+    virtual bool handlesSubSelections() const;
+
 private:
     virtual void onSelectionChanged(const SelectionChanges& msg) = 0;
     void _onSelectionChanged(const SelectionChanges& msg);
@@ -222,12 +240,14 @@ class GuiExport SelectionSingleton : public Base::Subject<const SelectionChanges
 public:
     /// Add to selection
     bool addSelection(const char* pDocName, const char* pObjectName=0, const char* pSubName=0, float x=0, float y=0, float z=0);
-    /// Add to selection with several sub-elements
+    /// Add to selection with several sub-elements, skipping the ones already selected. Observers get one change, AddSubSelections if several were added.
     bool addSelection(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
     /// Add to selection
     bool addSelection(const SelectionObject&);
     /// Remove from selection (for internal use)
     void rmvSelection(const char* pDocName, const char* pObjectName=0, const char* pSubName=0);
+    /// Remove several sub-elements from selection. Observers get one change, RmvSubSelections if several were removed.
+    void rmvSelection(const char* pDocName, const char* pObjectName, const std::vector<std::string>& pSubNames);
     /// Set the selection for a document
     void setSelection(const char* pDocName, const std::vector<App::DocumentObject*>&);
     /// Clear the selection of document \a pDocName. If the document name is not given the selection of the active document is cleared.
@@ -377,6 +397,20 @@ protected:
     };
     std::list<_SelObj> _SelList;
 
+    /// Index of _SelList: (document, object) -> sub-element -> entry
+    typedef boost::unordered_map<std::string, std::list<_SelObj>::iterator> _SubIndex;
+    typedef boost::unordered_map<std::pair<std::string, std::string>, _SubIndex> _SelIndex;
+    _SelIndex _SelMap;
+
+    /// returns the entries of the object or null if nothing of it is selected
+    const _SubIndex* findObject(const char* pDocName, const char* pObjectName) const;
+    /// appends an entry to _SelList and the index
+    void appendSelection(const _SelObj&);
+    /// removes an entry from _SelList and the index
+    void eraseSelection(std::list<_SelObj>::iterator);
+    /// rebuilds the index after _SelList has been replaced
+    void rebuildIndex();
+
     static SelectionSingleton* _pcSingleton;
 
     std::string DocName;
@@ -106,6 +106,15 @@ void SelectionView::OnChange(Gui::SelectionSingleton::SubjectType &rCaller,
                              Gui::SelectionSingleton::MessageType Reason)
 {
     Q_UNUSED(rCaller);
+    if (Reason.Type == SelectionChanges::AddSubSelections ||
+        Reason.Type == SelectionChanges::RmvSubSelections) {
+        // the view lists each sub-element on its own
+        std::vector<SelectionChanges> changes = Reason.splitSubSelections();
+        for (std::vector<SelectionChanges>::iterator it = changes.begin(); it != changes.end(); ++it)
+            OnChange(rCaller, *it);
+        return;
+    }
+
     QString selObject;
     QTextStream str(&selObject);
     if (Reason.Type == SelectionChanges::AddSelection) {
@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <qstatusbar.h>
 # include <qstring.h>
 # include <Inventor/details/SoFaceDetail.h>
@@ -219,6 +220,26 @@ void SoFCSelection::doAction(SoAction *action)
                 return;
             }
         }
+        else if (selaction->SelChange.Type == SelectionChanges::AddSubSelections ||
+                 selaction->SelChange.Type == SelectionChanges::RmvSubSelections) {
+            const std::vector<std::string>& subNames = *selaction->SelChange.pSubNames;
+            if (documentName.getValue() == selaction->SelChange.pDocName &&
+                objectName.getValue() == selaction->SelChange.pObjectName &&
+                std::find(subNames.begin(), subNames.end(),
+                          subElementName.getValue().getString()) != subNames.end()) {
+                if (selaction->SelChange.Type == SelectionChanges::AddSubSelections) {
+                    if(selected.getValue() == NOTSELECTED){
+                        selected = SELECTED;
+                    }
+                }
+                else {
+                    if(selected.getValue() == SELECTED){
+                        selected = NOTSELECTED;
+                    }
+                }
+                return;
+            }
+        }
         else if (selaction->SelChange.Type == SelectionChanges::ClrSelection) {
             if (documentName.getValue() == selaction->SelChange.pDocName ||
                 strcmp(selaction->SelChange.pDocName,"") == 0){
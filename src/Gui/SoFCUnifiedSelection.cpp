@@ -23,6 +23,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <qstatusbar.h>
 # include <qstring.h>
 # include <Inventor/details/SoFaceDetail.h>
@@ -62,6 +63,7 @@
 #include <Inventor/nodes/SoMaterialBinding.h>
 #include <Inventor/nodes/SoNormalBinding.h>
 #include <Inventor/events/SoLocation2Event.h>
+#include <Inventor/sensors/SoAlarmSensor.h>
 #include <Inventor/SoPickedPoint.h>
 
 #ifdef FC_OS_MACOSX
@@ -121,6 +123,16 @@ SoFCUnifiedSelection::SoFCUnifiedSelection() : pcDocument(0)
     highlighted = false;
     setPreSelection = false;
     preSelection = -1;
+
+    pickSensor = new SoAlarmSensor(pickSensorCB, this);
+    pickEvent = new SoLocation2Event;
+    pickRoot = 0;
+    pickInterval = SbTime(1.0 / 60.0);
+    lastPick = SbTime::zero();
+    forcePick = false;
+    pickCount = 0;
+    pickTotal = SbTime::zero();
+    pickMax = SbTime::zero();
 }
 
 /*!
@@ -134,6 +146,11 @@ SoFCUnifiedSelection::~SoFCUnifiedSelection()
         currenthighlight->unref();
         currenthighlight = NULL;
     }
+
+    delete pickSensor;
+    delete pickEvent;
+    if (pickRoot)
+        pickRoot->unref();
 }
 
 // doc from parent
@@ -154,6 +171,9 @@ void SoFCUnifiedSelection::applySettings()
     ParameterGrp::handle hGrp = Gui::WindowParameter::getDefaultParameter()->GetGroup("View");
     bool enablePre = hGrp->GetBool("EnablePreselection", true);
     bool enableSel = hGrp->GetBool("EnableSelection", true);
+    // by default pick once per frame at 60 Hz
+    long interval = hGrp->GetInt("PreselectionInterval", 16);
+    this->pickInterval = SbTime(static_cast<double>(std::max<long>(interval, 0)) / 1000.0);
     if (!enablePre) {
         this->highlightMode = SoFCUnifiedSelection::OFF;
     }
@@ -332,6 +352,86 @@ SoFCUnifiedSelection::getPickedPoint(SoHandleEventAction* action) const
     return picked;
 }
 
+/*!
+  Returns true if the pick for the mouse move of \a action must wait until
+  the current pick interval is over. The event is kept and handled again
+  by pickSensorCB(), thus the last position is always picked.
+ */
+bool SoFCUnifiedSelection::postponePick(SoHandleEventAction* action)
+{
+    if (forcePick)
+        return false;
+
+    SbTime now = SbTime::getTimeOfDay();
+    if (now - lastPick >= pickInterval) {
+        lastPick = now;
+        if (pickSensor->isScheduled())
+            pickSensor->unschedule();
+        return false;
+    }
+
+    const SoEvent* event = action->getEvent();
+    pickEvent->setPosition(event->getPosition());
+    pickEvent->setTime(event->getTime());
+    pickEvent->setShiftDown(event->wasShiftDown());
+    pickEvent->setCtrlDown(event->wasCtrlDown());
+    pickEvent->setAltDown(event->wasAltDown());
+    pickRegion = action->getViewportRegion();
+
+    // the event is applied again to the root of the scene
+    SoNode* root = action->getCurPath()->getHead();
+    if (root != pickRoot) {
+        if (root)
+            root->ref();
+        if (pickRoot)
+            pickRoot->unref();
+        pickRoot = root;
+    }
+
+    if (!pickSensor->isScheduled()) {
+        pickSensor->setTime(lastPick + pickInterval);
+        pickSensor->schedule();
+    }
+    return true;
+}
+
+void SoFCUnifiedSelection::pickSensorCB(void * data, SoSensor * /*sensor*/)
+{
+    SoFCUnifiedSelection* self = static_cast<SoFCUnifiedSelection*>(data);
+    SoNode* root = self->pickRoot;
+    self->pickRoot = 0;
+    if (!root)
+        return;
+
+    // skip it if the scene is only kept alive by us
+    if (root->getRefCount() > 1) {
+        SoHandleEventAction action(self->pickRegion);
+        action.setEvent(self->pickEvent);
+        self->forcePick = true;
+        action.apply(root);
+        self->forcePick = false;
+        self->lastPick = SbTime::getTimeOfDay();
+    }
+    root->unref();
+}
+
+void SoFCUnifiedSelection::addPickTime(const SbTime& time)
+{
+    pickCount++;
+    pickTotal += time;
+    if (time > pickMax)
+        pickMax = time;
+
+    if (pickCount == 100) {
+        Base::Console().Log("Preselection: %d picks, average %.2f ms, maximum %.2f ms\n",
+                            pickCount, pickTotal.getValue() * 1000.0 / pickCount,
+                            pickMax.getValue() * 1000.0);
+        pickCount = 0;
+        pickTotal = SbTime::zero();
+        pickMax = SbTime::zero();
+    }
+}
+
 void SoFCUnifiedSelection::doAction(SoAction *action)
 {
     if (action->getTypeId() == SoFCEnableHighlightAction::getClassTypeId()) {
@@ -402,34 +502,48 @@ void SoFCUnifiedSelection::doAction(SoAction *action)
     if (selectionMode.getValue() == ON && action->getTypeId() == SoFCSelectionAction::getClassTypeId()) {
         SoFCSelectionAction *selaction = static_cast<SoFCSelectionAction*>(action);
         if (selaction->SelChange.Type == SelectionChanges::AddSelection || 
-            selaction->SelChange.Type == SelectionChanges::RmvSelection) {
+            selaction->SelChange.Type == SelectionChanges::RmvSelection ||
+            selaction->SelChange.Type == SelectionChanges::AddSubSelections ||
+            selaction->SelChange.Type == SelectionChanges::RmvSubSelections) {
             // selection changes inside the 3d view are handled in handleEvent()
             App::Document* doc = App::GetApplication().getDocument(selaction->SelChange.pDocName);
             App::DocumentObject* obj = doc->getObject(selaction->SelChange.pObjectName);
             ViewProvider*vp = Application::Instance->getViewProvider(obj);
             if (vp && vp->useNewSelectionModel() && vp->isSelectable()) {
-                SoDetail* detail = vp->getDetail(selaction->SelChange.pSubName);
-                SoSelectionElementAction::Type type = SoSelectionElementAction::None;
-                if (selaction->SelChange.Type == SelectionChanges::AddSelection) {
-                    if (detail)
-                        type = SoSelectionElementAction::Append;
-                    else
-                        type = SoSelectionElementAction::All;
-                }
-                else {
-                    if (detail)
-                        type = SoSelectionElementAction::Remove;
-                    else
-                        type = SoSelectionElementAction::None;
+                bool add = selaction->SelChange.Type == SelectionChanges::AddSelection ||
+                           selaction->SelChange.Type == SelectionChanges::AddSubSelections;
+                // the object is looked up once for all its sub-elements
+                std::vector<std::string> single;
+                const std::vector<std::string>* subNames = selaction->SelChange.pSubNames;
+                if (!subNames) {
+                    single.push_back(selaction->SelChange.pSubName);
+                    subNames = &single;
                 }
 
-                if (checkSelectionStyle(type,vp)) {
-                    SoSelectionElementAction action(type);
-                    action.setColor(this->colorSelection.getValue());
-                    action.setElement(detail);
-                    action.apply(vp->getRoot());
+                for (std::vector<std::string>::const_iterator it = subNames->begin(); it != subNames->end(); ++it) {
+                    SoDetail* detail = vp->getDetail(it->c_str());
+                    SoSelectionElementAction::Type type = SoSelectionElementAction::None;
+                    if (add) {
+                        if (detail)
+                            type = SoSelectionElementAction::Append;
+                        else
+                            type = SoSelectionElementAction::All;
+                    }
+                    else {
+                        if (detail)
+                            type = SoSelectionElementAction::Remove;
+                        else
+                            type = SoSelectionElementAction::None;
+                    }
+
+                    if (checkSelectionStyle(type,vp)) {
+                        SoSelectionElementAction action(type);
+                        action.setColor(this->colorSelection.getValue());
+                        action.setElement(detail);
+                        action.apply(vp->getRoot());
+                    }
+                    delete detail;
                 }
-                delete detail;
             }
         }
         else if (selaction->SelChange.Type == SelectionChanges::ClrSelection ||
@@ -490,9 +604,11 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
         // NOTE: If preselection is off then we do not check for a picked point because otherwise this search may slow
         // down extremely the system on really big data sets. In this case we just check for a picked point if the data
         // set has been selected.
-        if (mymode == AUTO || mymode == ON) {
+        if ((mymode == AUTO || mymode == ON) && !postponePick(action)) {
             // check to see if the mouse is over our geometry...
+            SbTime start = SbTime::getTimeOfDay();
             const SoPickedPoint * pp = this->getPickedPoint(action);
+            addPickTime(SbTime::getTimeOfDay() - start);
             SoFullPath *pPath = (pp != NULL) ? (SoFullPath *) pp->getPath() : NULL;
             ViewProvider *vp = 0;
             ViewProviderDocumentObject* vpd = 0;
@@ -503,6 +619,7 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
 
             //SbBool old_state = highlighted;
             highlighted = false;
+            bool unchanged = false;
             if (vpd && vpd->useNewSelectionModel() && vpd->isSelectable()) {
                 std::string documentName = vpd->getObject()->getDocument()->getName();
                 std::string objectLabel = vpd->getObject()->Label.getStrValue();
@@ -520,10 +637,25 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
                                            ,pp->getPoint()[1]
                                            ,pp->getPoint()[2]);
 
+                // Still over the same element, only the picked point has moved
+                // and the preselection and its highlighting are kept
+                const SelectionChanges& current = Gui::Selection().getPreselection();
+                if (currenthighlight && current.pDocName && current.pObjectName && current.pSubName &&
+                    documentName == current.pDocName && objectName == current.pObjectName &&
+                    subElementName == current.pSubName) {
+                    Gui::Selection().setPreselectCoord(pp->getPoint()[0]
+                                                      ,pp->getPoint()[1]
+                                                      ,pp->getPoint()[2]);
+                    unchanged = true;
+                }
+
                 getMainWindow()->showMessage(QString::fromUtf8(buf));
 
                 setPreSelection = true;
-                if (Gui::Selection().setPreselect(documentName.c_str()
+                if (unchanged) {
+                    highlighted = true;
+                }
+                else if (Gui::Selection().setPreselect(documentName.c_str()
                                        ,objectName.c_str()
                                        ,subElementName.c_str()
                                        ,pp->getPoint()[0]
@@ -566,7 +698,7 @@ SoFCUnifiedSelection::handleEvent(SoHandleEventAction * action)
                 }
             }
 
-            if (currenthighlight/* && old_state != highlighted*/) {
+            if (currenthighlight && !unchanged/* && old_state != highlighted*/) {
                 SoHighlightElementAction action;
                 action.setHighlighted(highlighted);
                 action.setColor(this->colorHighlight.getValue());
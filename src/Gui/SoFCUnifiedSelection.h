@@ -31,12 +31,17 @@
 #include <Inventor/fields/SoSFString.h>
 #include <Inventor/nodes/SoLightModel.h>
 #include <Inventor/lists/SoPathList.h>
+#include <Inventor/SbTime.h>
+#include <Inventor/SbViewportRegion.h>
 #include "View3DInventorViewer.h"
 #include <list>
 
 class SoFullPath;
 class SoPickedPoint;
 class SoDetail;
+class SoAlarmSensor;
+class SoSensor;
+class SoLocation2Event;
 
 
 namespace Gui {
@@ -115,6 +120,15 @@ private:
     //SbBool preRender(SoGLRenderAction *act, GLint &oldDepthFunc);
     static int getPriority(const SoPickedPoint* p);
     const SoPickedPoint* getPickedPoint(SoHandleEventAction*) const;
+    /** @name Preselection picking.
+     * Mouse moves are picked at most once per pick interval, a move
+     * within the interval is postponed to its end.
+     */
+    //@{
+    bool postponePick(SoHandleEventAction*);
+    void addPickTime(const SbTime&);
+    static void pickSensorCB(void * data, SoSensor * sensor);
+    //@}
     Gui::Document       *pcDocument;
 
     static SoFullPath * currenthighlight;
@@ -125,6 +139,19 @@ private:
     // -1 = not handled, 0 = not selected, 1 = selected
     int32_t preSelection;
     SoColorPacker colorpacker;
+
+    SoAlarmSensor* pickSensor;
+    SoLocation2Event* pickEvent;
+    SoNode* pickRoot;
+    SbViewportRegion pickRegion;
+    SbTime pickInterval;
+    SbTime lastPick;
+    bool forcePick;
+
+    // pick latency statistics
+    int pickCount;
+    SbTime pickTotal;
+    SbTime pickMax;
 };
 
 /**
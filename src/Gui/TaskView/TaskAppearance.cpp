@@ -82,6 +82,8 @@ void TaskAppearance::OnChange(Gui::SelectionSingleton::SubjectType &rCaller,
     Q_UNUSED(rCaller); 
     if (Reason.Type == SelectionChanges::AddSelection ||
         Reason.Type == SelectionChanges::RmvSelection ||
+        Reason.Type == SelectionChanges::AddSubSelections ||
+        Reason.Type == SelectionChanges::RmvSubSelections ||
         Reason.Type == SelectionChanges::SetSelection ||
         Reason.Type == SelectionChanges::ClrSelection) {
         std::vector<Gui::ViewProvider*> views = getSelection();
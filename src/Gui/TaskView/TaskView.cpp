@@ -550,7 +550,9 @@ void TaskView::OnChange(Gui::SelectionSingleton::SubjectType &rCaller,
     if (Reason.Type == SelectionChanges::AddSelection ||
         Reason.Type == SelectionChanges::ClrSelection || 
         Reason.Type == SelectionChanges::SetSelection ||
-        Reason.Type == SelectionChanges::RmvSelection) {
+        Reason.Type == SelectionChanges::RmvSelection ||
+        Reason.Type == SelectionChanges::AddSubSelections ||
+        Reason.Type == SelectionChanges::RmvSubSelections) {
 
         if (!ActiveDialog)
             updateWatcher();
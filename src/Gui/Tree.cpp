@@ -158,6 +158,13 @@ TreeWidget::TreeWidget(QWidget* parent)
 
     this->statusTimer->setSingleShot(true);
     this->statusTimer->start(300);
+
+    // collects the object changes of a recompute or transaction
+    this->updateTimer = new QTimer(this);
+    this->updateTimer->setSingleShot(true);
+    connect(this->updateTimer, SIGNAL(timeout()),
+            this, SLOT(onUpdateItems()));
+
     documentPixmap = new QPixmap(Gui::BitmapFactory().pixmap("Document"));
 
     this->setDefaultDropAction(Qt::MoveAction);
@@ -869,6 +876,15 @@ void TreeWidget::onTestStatus(void)
     this->statusTimer->start(300);
 }
 
+void TreeWidget::onUpdateItems(void)
+{
+    std::map<const Gui::Document*,DocumentItem*>::iterator pos;
+    for (pos = DocumentMap.begin();pos!=DocumentMap.end();++pos) {
+        pos->second->createNewItems();
+        pos->second->updateChangedObjects();
+    }
+}
+
 void TreeWidget::onItemEntered(QTreeWidgetItem * item)
 {
     // object item selected
@@ -898,6 +914,13 @@ void TreeWidget::onItemExpanded(QTreeWidgetItem * item)
             Base::Console().Warning("DocumentItem::onItemExpanded: cannot find object document\n");
         else
             it->second->populateItem(obj);
+
+        // the status of hidden items is not kept up to date, see DocumentItem::testStatus()
+        for (int i=0; i<obj->childCount(); i++) {
+            QTreeWidgetItem* child = obj->child(i);
+            if (child->type() == TreeWidget::ObjectType)
+                static_cast<DocumentObjectItem*>(child)->testStatus();
+        }
     }
 }
 
@@ -957,11 +980,17 @@ void TreeWidget::onItemSelectionChanged ()
     this->blockConnection(lock);
 }
 
+bool TreeWidget::handlesSubSelections() const
+{
+    return true;
+}
+
 void TreeWidget::onSelectionChanged(const SelectionChanges& msg)
 {
     switch (msg.Type)
     {
     case SelectionChanges::AddSelection:
+    case SelectionChanges::AddSubSelections:
         {
             Gui::Document* pDoc = Application::Instance->getDocument(msg.pDocName);
             std::map<const Gui::Document*, DocumentItem*>::iterator it;
@@ -972,6 +1001,7 @@ void TreeWidget::onSelectionChanged(const SelectionChanges& msg)
             this->blockConnection(lock);
         }   break;
     case SelectionChanges::RmvSelection:
+    case SelectionChanges::RmvSubSelections:
         {
             Gui::Document* pDoc = Application::Instance->getDocument(msg.pDocName);
             std::map<const Gui::Document*, DocumentItem*>::iterator it;
@@ -1238,7 +1268,9 @@ DocumentItem::~DocumentItem()
     connectScrObject.disconnect();
 }
 
+// The items of new objects are created before looking up any item
 #define FOREACH_ITEM(_item, _obj) \
+    createNewItems();\
     auto _it = ObjectMap.find(std::string(_obj.getObject()->getNameInDocument()));\
     if(_it == ObjectMap.end() || _it->second->empty()) return;\
     for(auto _item : *_it->second){{
@@ -1248,6 +1280,7 @@ DocumentItem::~DocumentItem()
         for(auto _item : *_v.second) {
 
 #define FOREACH_ITEM_NAME(_item,_name) \
+    createNewItems();\
     auto _it = ObjectMap.find(_name);\
     if(_it != ObjectMap.end()) {\
         for(auto _item : *_it->second) {
@@ -1272,7 +1305,43 @@ void DocumentItem::slotResetEdit(const Gui::ViewProviderDocumentObject& v)
 }
 
 void DocumentItem::slotNewObject(const Gui::ViewProviderDocumentObject& obj) {
-    createNewItem(obj);
+    // Loading a document or a recompute may add many objects at once, so
+    // their items are created together when getting back to the event loop
+    const char* name = obj.getObject()->getNameInDocument();
+    if (!obj.showInTree() || !name)
+        return;
+
+    NewObjects.push_back(name);
+    TreeWidget* tree = static_cast<TreeWidget*>(treeWidget());
+    if (tree && !tree->updateTimer->isActive())
+        tree->updateTimer->start(0);
+}
+
+void DocumentItem::createNewItems(void)
+{
+    if (NewObjects.empty())
+        return;
+
+    std::vector<std::string> names;
+    names.swap(NewObjects);
+
+    const App::Document* doc = pDocument->getDocument();
+    for (std::vector<std::string>::iterator it = names.begin(); it != names.end(); ++it) {
+        // the object may have been deleted meanwhile, or it may already
+        // have got an item as the claimed child of another new object
+        App::DocumentObject* obj = doc->getObject(it->c_str());
+        if (!obj)
+            continue;
+        auto jt = ObjectMap.find(*it);
+        if (jt != ObjectMap.end() && !jt->second->empty())
+            continue;
+        ViewProvider* vp = pDocument->getViewProvider(obj);
+        if (!vp || !vp->isDerivedFrom(ViewProviderDocumentObject::getClassTypeId()))
+            continue;
+        createNewItem(static_cast<ViewProviderDocumentObject&>(*vp));
+        // the new item is populated with the current children already
+        ChangedObjects.erase(*it);
+    }
 }
 
 bool DocumentItem::createNewItem(const Gui::ViewProviderDocumentObject& obj,
@@ -1507,6 +1576,34 @@ void DocumentItem::populateItem(DocumentObjectItem *item, bool refresh)
 }
 
 void DocumentItem::slotChangeObject(const Gui::ViewProviderDocumentObject& view)
+{
+    // An object usually changes several properties in a row, so the
+    // items are updated only once when getting back to the event loop
+    const char* name = view.getObject()->getNameInDocument();
+    if (!name)
+        return;
+
+    ChangedObjects.insert(name);
+    TreeWidget* tree = static_cast<TreeWidget*>(treeWidget());
+    if (tree && !tree->updateTimer->isActive())
+        tree->updateTimer->start(0);
+}
+
+void DocumentItem::updateChangedObjects(void)
+{
+    std::set<std::string> names;
+    names.swap(ChangedObjects);
+
+    for (std::set<std::string>::iterator it = names.begin(); it != names.end(); ++it) {
+        // the object may have been deleted meanwhile
+        auto jt = ObjectMap.find(*it);
+        if (jt == ObjectMap.end() || jt->second->empty())
+            continue;
+        updateObject(*(*jt->second->begin())->object());
+    }
+}
+
+void DocumentItem::updateObject(const Gui::ViewProviderDocumentObject& view)
 {
     QString displayName = QString::fromUtf8(view.getObject()->Label.getValue());
     FOREACH_ITEM(item,view)
@@ -1682,9 +1779,25 @@ const Gui::Document* DocumentItem::document() const
 
 void DocumentItem::testStatus(void)
 {
-    FOREACH_ITEM_ALL(item);
-        item->testStatus();
-    END_FOREACH_ITEM;
+    // Only the items that can be seen are checked, the children of an
+    // item are checked when it gets expanded. So the tree is walked from
+    // the top and collapsed or hidden branches are not entered at all.
+    if (!isExpanded() || isHidden())
+        return;
+
+    std::vector<QTreeWidgetItem*> parents(1, this);
+    while (!parents.empty()) {
+        QTreeWidgetItem* parent = parents.back();
+        parents.pop_back();
+        for (int i=0; i<parent->childCount(); i++) {
+            QTreeWidgetItem* child = parent->child(i);
+            if (child->isHidden() || child->type() != TreeWidget::ObjectType)
+                continue;
+            static_cast<DocumentObjectItem*>(child)->testStatus();
+            if (child->isExpanded())
+                parents.push_back(child);
+        }
+    }
 }
 
 void DocumentItem::setData (int column, int role, const QVariant & value)
@@ -1714,93 +1827,68 @@ void DocumentItem::setObjectSelected(const char* name, bool select)
     END_FOREACH_ITEM;
 }
 
+std::vector<DocumentObjectItem*> DocumentItem::selectedObjectItems(void) const
+{
+    // only the selected items are visited, not all items of the document
+    std::vector<DocumentObjectItem*> items;
+    QList<QTreeWidgetItem*> sel = treeWidget()->selectedItems();
+    for (QList<QTreeWidgetItem*>::iterator it = sel.begin(); it != sel.end(); ++it) {
+        if ((*it)->type() != TreeWidget::ObjectType)
+            continue;
+        DocumentObjectItem* item = static_cast<DocumentObjectItem*>(*it);
+        if (item->object()->getDocument() == pDocument)
+            items.push_back(item);
+    }
+    return items;
+}
+
 void DocumentItem::clearSelection(void)
 {
     // Block signals here otherwise we get a recursion and quadratic runtime
     bool ok = treeWidget()->blockSignals(true);
-    FOREACH_ITEM_ALL(item);
-        item->setSelected(false);
-    END_FOREACH_ITEM;
+    std::vector<DocumentObjectItem*> items = selectedObjectItems();
+    for (std::vector<DocumentObjectItem*>::iterator it = items.begin(); it != items.end(); ++it)
+        (*it)->setSelected(false);
     treeWidget()->blockSignals(ok);
 }
 
 void DocumentItem::updateSelection(void)
 {
     std::vector<App::DocumentObject*> sel;
-    FOREACH_ITEM_ALL(item);
-        if (treeWidget()->isItemSelected(item))
-            sel.push_back(item->object()->getObject());
-    END_FOREACH_ITEM;
+    std::vector<DocumentObjectItem*> items = selectedObjectItems();
+    for (std::vector<DocumentObjectItem*>::iterator it = items.begin(); it != items.end(); ++it)
+        sel.push_back((*it)->object()->getObject());
 
     Gui::Selection().setSelection(pDocument->getDocument()->getName(), sel);
 }
 
-namespace Gui {
-struct ObjectItem_Less : public std::binary_function<DocumentObjectItem*,
-                                                     DocumentObjectItem*, bool>
-{
-    bool operator()(DocumentObjectItem* x, DocumentObjectItem* y) const
-    {
-        return x->object()->getObject() < y->object()->getObject();
-    }
-};
-
-struct ObjectItem_Equal : public std::binary_function<DocumentObjectItem*,
-                                                      App::DocumentObject*, bool>
-{
-    bool operator()(DocumentObjectItem* x, App::DocumentObject* y) const
-    {
-        return x->object()->getObject() == y;
-    }
-};
-}
-
 void DocumentItem::selectItems(void)
 {
-    // get an array of all tree items of the document and sort it in ascending order
-    // with regard to their document object
-    std::vector<DocumentObjectItem*> items;
-    FOREACH_ITEM_ALL(item);
-        items.push_back(item);
-    END_FOREACH_ITEM;
-    std::sort(items.begin(), items.end(), ObjectItem_Less());
+    createNewItems();
 
-    // get and sort all selected document objects of the given document
-    std::vector<App::DocumentObject*> objs;
+    // look up the tree items of the selected document objects
+    std::set<DocumentObjectItem*> common;
     std::vector<SelectionSingleton::SelObj> obj = Selection().getSelection(pDocument->getDocument()->getName());
     for (std::vector<SelectionSingleton::SelObj>::iterator jt = obj.begin(); jt != obj.end(); ++jt) {
-        objs.push_back(jt->pObject);
+        auto it = ObjectMap.find(jt->FeatName);
+        if (it != ObjectMap.end())
+            common.insert(it->second->begin(), it->second->end());
     }
-    std::sort(objs.begin(), objs.end());
 
-    // The document objects in 'objs' is a subset of the document objects stored
-    // in 'items'. Since both arrays are sorted we get the wanted tree items in
-    // linear time.
-    std::vector<DocumentObjectItem*> common;
-    std::vector<DocumentObjectItem*>::iterator item_it = items.begin();
-    for (std::vector<App::DocumentObject*>::iterator it = objs.begin(); it != objs.end(); ++it) {
-        item_it = std::find_if(item_it, items.end(), std::bind2nd(ObjectItem_Equal(), *it));
-        if (item_it == items.end())
-            break; // should never ever happen
-        common.push_back(*item_it);
+    // get the selected items that are no longer selected
+    std::vector<DocumentObjectItem*> items = selectedObjectItems();
+    QList<QTreeWidgetItem *> deselitems;
+    for (std::vector<DocumentObjectItem*>::iterator it = items.begin(); it != items.end(); ++it) {
+        if (common.find(*it) == common.end())
+            deselitems.append(*it);
     }
 
-    // get all unselected items of the given document
-    std::sort(common.begin(), common.end());
-    std::sort(items.begin(), items.end());
-    std::vector<DocumentObjectItem*> diff;
-    std::back_insert_iterator<std::vector<DocumentObjectItem*> > biit(diff);
-    std::set_difference(items.begin(), items.end(), common.begin(), common.end(), biit);
-
     // select the appropriate items
     QList<QTreeWidgetItem *> selitems;
-    for (std::vector<DocumentObjectItem*>::iterator it = common.begin(); it != common.end(); ++it)
+    for (std::set<DocumentObjectItem*>::iterator it = common.begin(); it != common.end(); ++it)
         selitems.append(*it);
     static_cast<TreeWidget*>(treeWidget())->setItemsSelected(selitems, true);
     // deselect the appropriate items
-    QList<QTreeWidgetItem *> deselitems;
-    for (std::vector<DocumentObjectItem*>::iterator it = diff.begin(); it != diff.end(); ++it)
-        deselitems.append(*it);
     static_cast<TreeWidget*>(treeWidget())->setItemsSelected(deselitems, false);
 }
 
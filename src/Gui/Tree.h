@@ -82,6 +82,8 @@ public:
 protected:
     /// Observer message from the Selection
     void onSelectionChanged(const SelectionChanges& msg);
+    /// the tree only shows objects, several sub-elements are one change
+    bool handlesSubSelections() const;
     void contextMenuEvent (QContextMenuEvent * e);
     void drawRow(QPainter *, const QStyleOptionViewItem &, const QModelIndex &) const;
     /** @name Drag and drop */
@@ -118,6 +120,7 @@ private Q_SLOTS:
     void onItemCollapsed(QTreeWidgetItem * item);
     void onItemExpanded(QTreeWidgetItem * item);
     void onTestStatus(void);
+    void onUpdateItems(void);
 
 Q_SIGNALS:
     void emitSearchObjects();
@@ -142,6 +145,7 @@ private:
 
     QTreeWidgetItem* rootItem;
     QTimer* statusTimer;
+    QTimer* updateTimer;
     static QPixmap* documentPixmap;
     std::map<const Gui::Document*,DocumentItem*> DocumentMap;
     bool fromOutside;
@@ -152,6 +156,8 @@ private:
     Connection connectRenDocument;
     Connection connectActDocument;
     Connection connectRelDocument;
+
+    friend class DocumentItem;
 };
 
 /** The link between the tree and a document.
@@ -174,6 +180,10 @@ public:
     void testStatus(void);
     void setData(int column, int role, const QVariant & value);
     void populateItem(DocumentObjectItem *item, bool refresh = false);
+    /// creates the items of the objects added since the last call
+    void createNewItems(void);
+    /// updates the items of the objects changed since the last call
+    void updateChangedObjects(void);
 
 protected:
     /** Adds a view provider to the document item.
@@ -193,6 +203,9 @@ protected:
     void slotExpandObject    (const Gui::ViewProviderDocumentObject&,const Gui::TreeItemMode&);
     void slotScrollToObject  (const Gui::ViewProviderDocumentObject&);
 
+    void updateObject(const Gui::ViewProviderDocumentObject&);
+    std::vector<DocumentObjectItem*> selectedObjectItems(void) const;
+
     bool createNewItem(const Gui::ViewProviderDocumentObject&, 
                     QTreeWidgetItem *parent=0, int index=-1, 
                     DocumentObjectItemsPtr ptrs = DocumentObjectItemsPtr());
@@ -200,6 +213,10 @@ protected:
 private:
     const Gui::Document* pDocument;
     std::map<std::string,DocumentObjectItemsPtr> ObjectMap;
+    /// names of the new objects in the order of creation, their items are created later
+    std::vector<std::string> NewObjects;
+    /// names of the objects whose items need to be updated
+    std::set<std::string> ChangedObjects;
 
     typedef boost::signals2::connection Connection;
     Connection connectNewObject;
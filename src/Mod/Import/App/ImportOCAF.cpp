@@ -38,6 +38,7 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Face.hxx>
+# include <TopoDS_TShape.hxx>
 # include <gp_Dir.hxx>
 # include <gp_Pln.hxx> // for Precision::Confusion()
 # include <Bnd_Box.hxx>
@@ -74,6 +75,7 @@
 # include <TopoDS_Iterator.hxx>
 # include <APIHeaderSection_MakeHeader.hxx>
 # include <OSD_Exception.hxx>
+# include <exception>
 #if OCC_VERSION_HEX >= 0x060500
 # include <TDataXtd_Shape.hxx>
 # else
@@ -82,6 +84,7 @@
 #endif
 
 #include <Base/Console.h>
+#include <Base/TimeInfo.h>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
@@ -92,16 +95,11 @@
 #include <Mod/Part/App/ProgressIndicator.h>
 #include <Mod/Part/App/ImportIges.h>
 #include <Mod/Part/App/ImportStep.h>
+#include <Mod/Part/App/Parallel.h>
 
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectGroup.h>
 
-#ifdef HAVE_TBB
-#include <tbb/parallel_for.h>
-#include <tbb/blocked_range.h>
-#include <tbb/task_group.h>
-#endif
-
 
 
 using namespace Import;
@@ -110,7 +108,7 @@ using namespace Import;
 #define OCAF_KEEP_PLACEMENT
 
 ImportOCAF::ImportOCAF(Handle(TDocStd_Document) h, App::Document* d, const std::string& name)
-    : pDoc(h), doc(d), merge(true), default_name(name)
+    : pDoc(h), doc(d), merge(true), instancing(false), default_name(name)
 {
     aShapeTool = XCAFDoc_DocumentTool::ShapeTool (pDoc->Main());
     aColorTool = XCAFDoc_DocumentTool::ColorTool(pDoc->Main());
@@ -124,8 +122,120 @@ void ImportOCAF::loadShapes()
 {
     std::vector<App::DocumentObject*> lValue;
     myRefShapes.clear();
+    myInstances.clear();
+
+    Base::TimeInfo timer;
+    prepareShapes();
+    Base::TimeInfo prepared;
     loadShapes(pDoc->Main(), TopLoc_Location(), default_name, "", false, lValue);
+    Base::Console().Log("Import: %d shapes prepared in %.3f s, objects created in %.3f s\n",
+                        static_cast<int>(myColors.size()),
+                        Base::TimeInfo::diffTimeF(timer, prepared),
+                        Base::TimeInfo::diffTimeF(prepared, Base::TimeInfo()));
+
     lValue.clear();
+    myInstances.clear();
+    myColors.clear();
+}
+
+void ImportOCAF::prepareShapes()
+{
+    // Collect the shapes which get their own feature, as done by createShape()
+    std::vector<TopoDS_Shape> shapes;
+    std::set<const TopoDS_TShape*> shapeSet;
+    TDF_LabelSequence labels;
+    aShapeTool->GetShapes(labels);
+    for (Standard_Integer i=1; i <= labels.Length(); i++) {
+        const TDF_Label& label = labels.Value(i);
+        if (!aShapeTool->IsSimpleShape(label))
+            continue;
+        TopoDS_Shape aShape = aShapeTool->GetShape(label);
+        if (aShape.IsNull())
+            continue;
+        std::vector<TopoDS_Shape> parts;
+        if (aShape.ShapeType() == TopAbs_COMPOUND && !merge) {
+            TopExp_Explorer xp;
+            for (xp.Init(aShape, TopAbs_SOLID); xp.More(); xp.Next())
+                parts.push_back(xp.Current());
+            for (xp.Init(aShape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next())
+                parts.push_back(xp.Current());
+        }
+        else {
+            parts.push_back(aShape);
+        }
+        for (std::vector<TopoDS_Shape>::iterator it = parts.begin(); it != parts.end(); ++it) {
+            if (shapeSet.insert(it->TShape().operator->()).second)
+                shapes.push_back(*it);
+        }
+    }
+
+    // Shapes sharing a face or an edge with a shape before them are meshed
+    // afterwards, as the triangulation is stored in the face and the
+    // polygons on it in the edges
+    std::vector<bool> independent(shapes.size(), true);
+    std::set<const TopoDS_TShape*> subShapeSet;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        TopTools_IndexedMapOfShape subShapes;
+        TopExp::MapShapes(shapes[i], TopAbs_FACE, subShapes);
+        TopExp::MapShapes(shapes[i], TopAbs_EDGE, subShapes);
+        for (int j=1; j <= subShapes.Extent(); j++) {
+            if (!subShapeSet.insert(subShapes(j).TShape().operator->()).second)
+                independent[i] = false;
+        }
+    }
+
+    // the colors are looked up in the OCAF document, which is not thread
+    // safe, so this is done here and only the meshing runs in parallel
+    myColors.clear();
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        std::vector<App::Color> colors;
+        findColors(shapes[i], colors);
+        ShapeInstance& entry = myColors[shapes[i].TShape().operator->()];
+        entry.shape = shapes[i];
+        entry.colors.swap(colors);
+    }
+
+    std::vector<std::exception_ptr> errors(shapes.size());
+    auto prepare = [&](std::size_t i) {
+        try {
+            tessellate(shapes[i]);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<std::size_t> dependent;
+    std::vector<std::size_t> parallel;
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        if (independent[i])
+            parallel.push_back(i);
+        else
+            dependent.push_back(i);
+    }
+    Part::Parallel::forEach(parallel.size(), [&](std::size_t k) {
+        prepare(parallel[k]);
+    });
+    for (std::vector<std::size_t>::iterator it = dependent.begin(); it != dependent.end(); ++it)
+        prepare(*it);
+
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        if (!errors[i])
+            continue;
+        // the feature is still created, it is meshed again when shown
+        try {
+            std::rethrow_exception(errors[i]);
+        }
+        catch (Standard_Failure& e) {
+            Base::Console().Warning("Import: failed to mesh shape: %s\n", e.GetMessageString());
+        }
+        catch (const std::exception& e) {
+            Base::Console().Warning("Import: failed to mesh shape: %s\n", e.what());
+        }
+        catch (...) {
+            Base::Console().Warning("Import: failed to mesh shape\n");
+        }
+    }
 }
 
 void ImportOCAF::setMerge(bool merge)
@@ -133,15 +243,16 @@ void ImportOCAF::setMerge(bool merge)
     this->merge=merge;
 }
 
+void ImportOCAF::setInstancing(bool on)
+{
+    this->instancing=on;
+}
+
 void ImportOCAF::loadShapes(const TDF_Label& label, const TopLoc_Location& loc,
                             const std::string& defaultname, const std::string& assembly, bool isRef,
                             std::vector<App::DocumentObject*>& lValue)
 {
     int hash = 0;
-#ifdef HAVE_TBB
-    using namespace tbb;
-    task_group g;
-#endif
     TopoDS_Shape aShape;
 
     std::vector<App::DocumentObject *> localValue;
@@ -283,10 +394,10 @@ void ImportOCAF::createShape(const TDF_Label& label, const TopLoc_Location& loc,
                              std::vector<App::DocumentObject*>& lValue, bool mergeShape)
 {
     const TopoDS_Shape& aShape = aShapeTool->GetShape(label);
-#ifdef HAVE_TBB
-    using namespace tbb;
-    task_group g;
-#endif
+
+    // a merged compound which has already been built for another occurrence of this product
+    if (mergeShape && createInstance(aShape, loc, name, lValue))
+        return;
 
     if (!aShape.IsNull() && aShape.ShapeType() == TopAbs_COMPOUND) {
         TopExp_Explorer xp;
@@ -376,6 +487,7 @@ void ImportOCAF::createShape(const TDF_Label& label, const TopLoc_Location& loc,
                 lValue.push_back(part);
 
                 loadColors(part, aShape);
+                addInstance(aShape, comp, aShape);
             }
         }
         else {
@@ -422,6 +534,9 @@ void ImportOCAF::createShape(const TDF_Label& label, const TopLoc_Location& loc,
 void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location& loc, const std::string& name,
                              std::vector<App::DocumentObject*>& lvalue)
 {
+    if (createInstance(aShape, loc, name, lvalue))
+        return;
+
     Part::Feature* part = static_cast<Part::Feature*>(doc->addObject("Part::Feature"));
 
     if (!loc.IsIdentity())
@@ -434,10 +549,68 @@ void ImportOCAF::createShape(const TopoDS_Shape& aShape, const TopLoc_Location&
     lvalue.push_back(part);
 
     loadColors(part, aShape);
+    addInstance(aShape, aShape, aShape);
+}
+
+bool ImportOCAF::createInstance(const TopoDS_Shape& key, const TopLoc_Location& loc, const std::string& name,
+                                std::vector<App::DocumentObject*>& lvalue)
+{
+    if (!instancing || key.IsNull())
+        return false;
+    // The stored shape already carries the location and orientation of its key,
+    // so it can only be reused for the very same shape
+    typedef std::multimap<const TopoDS_TShape*, ShapeInstance>::const_iterator InstanceIterator;
+    std::pair<InstanceIterator, InstanceIterator> range = myInstances.equal_range(key.TShape().operator->());
+    InstanceIterator it = range.first;
+    while (it != range.second && !it->second.key.IsEqual(key))
+        ++it;
+    if (it == range.second)
+        return false;
+
+    // The new feature shares the TShape, and thus the geometry and the triangulation,
+    // of the first occurrence and differs only by its location
+    Part::Feature* part = static_cast<Part::Feature*>(doc->addObject("Part::Feature"));
+    if (!loc.IsIdentity())
+        part->Shape.setValue(it->second.shape.Moved(loc));
+    else
+        part->Shape.setValue(it->second.shape);
+    part->Label.setValue(name);
+    lvalue.push_back(part);
+
+    if (!it->second.colors.empty())
+        applyColors(part, it->second.colors);
+    return true;
+}
+
+void ImportOCAF::addInstance(const TopoDS_Shape& key, const TopoDS_Shape& shape, const TopoDS_Shape& colorShape)
+{
+    if (!instancing || key.IsNull())
+        return;
+    ShapeInstance inst;
+    inst.key = key;
+    inst.shape = shape;
+    findColors(colorShape, inst.colors);
+    myInstances.insert(std::make_pair(key.TShape().operator->(), inst));
 }
 
 void ImportOCAF::loadColors(Part::Feature* part, const TopoDS_Shape& aShape)
 {
+    std::vector<App::Color> colors;
+    findColors(aShape, colors);
+    if (!colors.empty())
+        applyColors(part, colors);
+}
+
+void ImportOCAF::findColors(const TopoDS_Shape& aShape, std::vector<App::Color>& colors) const
+{
+    std::map<const TopoDS_TShape*, ShapeInstance>::const_iterator it = myColors.find(aShape.TShape().operator->());
+    if (it != myColors.end() && it->second.shape.IsSame(aShape)) {
+        colors = it->second.colors;
+        return;
+    }
+
+    colors.clear();
+
     Quantity_Color aColor;
     App::Color color(0.8f,0.8f,0.8f);
     if (aColorTool->GetColor(aShape, XCAFDoc_ColorGen, aColor) ||
@@ -446,9 +619,7 @@ void ImportOCAF::loadColors(Part::Feature* part, const TopoDS_Shape& aShape)
         color.r = (float)aColor.Red();
         color.g = (float)aColor.Green();
         color.b = (float)aColor.Blue();
-        std::vector<App::Color> colors;
         colors.push_back(color);
-        applyColors(part, colors);
     }
 
     TopTools_IndexedMapOfShape faces;
@@ -476,8 +647,9 @@ void ImportOCAF::loadColors(Part::Feature* part, const TopoDS_Shape& aShape)
         xp.Next();
     }
 
+    // face colors override the color of the whole shape
     if (found_face_color) {
-        applyColors(part, faceColors);
+        colors.swap(faceColors);
     }
 }
 
@@ -59,22 +59,40 @@ public:
     virtual ~ImportOCAF();
     void loadShapes();
     void setMerge(bool);
+    void setInstancing(bool);
 
 private:
+    void prepareShapes();
     void loadShapes(const TDF_Label& label, const TopLoc_Location&, const std::string& partname, const std::string& assembly, bool isRef, std::vector<App::DocumentObject*> &);
     void createShape(const TDF_Label& label, const TopLoc_Location&, const std::string&, std::vector<App::DocumentObject*> &, bool);
     void createShape(const TopoDS_Shape& label, const TopLoc_Location&, const std::string&, std::vector<App::DocumentObject*> &);
     void loadColors(Part::Feature* part, const TopoDS_Shape& aShape);
+    void findColors(const TopoDS_Shape& aShape, std::vector<App::Color>& colors) const;
+    bool createInstance(const TopoDS_Shape& key, const TopLoc_Location&, const std::string&, std::vector<App::DocumentObject*> &);
+    void addInstance(const TopoDS_Shape& key, const TopoDS_Shape& shape, const TopoDS_Shape& colorShape);
     virtual void applyColors(Part::Feature*, const std::vector<App::Color>&){}
+    /// called from several threads at once with shapes which share no face
+    virtual void tessellate(const TopoDS_Shape&) const {}
 
 private:
+    /// shape and colors of the first occurrence of a part, shared by all other occurrences
+    struct ShapeInstance {
+        TopoDS_Shape key;
+        TopoDS_Shape shape;
+        std::vector<App::Color> colors;
+    };
+
     Handle(TDocStd_Document) pDoc;
     App::Document* doc;
     Handle(XCAFDoc_ShapeTool) aShapeTool;
     Handle(XCAFDoc_ColorTool) aColorTool;
     bool merge;
+    bool instancing;
     std::string default_name;
     std::set<int> myRefShapes;
+    /// by the TShape of the key, the instances also have to match its location and orientation
+    std::multimap<const TopoDS_TShape*, ShapeInstance> myInstances;
+    std::map<const TopoDS_TShape*, ShapeInstance> myColors;
     static const int HashUpper = INT_MAX;
 };
 
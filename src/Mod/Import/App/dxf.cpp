@@ -9,6 +9,7 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+#include <climits>
 #include <iomanip>
 
 #include <src/Build/Version.h>
@@ -82,7 +83,7 @@ void CDxfWrite::endRun(void)
     writeEntitiesSection();
     writeObjectsSection();
 
-    (*m_ofs) << "  0"         << endl;
+    (*m_ofs) << "  0"         << '\n';
     (*m_ofs) << "EOF";
 }
 
@@ -95,8 +96,8 @@ void CDxfWrite::writeHeaderSection(void)
     ss << "FreeCAD v" << FCVersionMajor << "." << FCVersionMinor << " " << FCRevision; 
 
     //header & version
-    (*m_ofs) << "999"      << endl;
-    (*m_ofs) << ss.str()   << endl;
+    (*m_ofs) << "999"      << '\n';
+    (*m_ofs) << ss.str()   << '\n';
 
     //static header content
     ss.str("");
@@ -144,11 +145,11 @@ void CDxfWrite::writeTablesSection(void)
 
     if (m_version > 12) {
         (*m_ofs) << (*m_ssBlkRecord).str();
-        (*m_ofs) << "  0"      << endl;
-        (*m_ofs) << "ENDTAB"   << endl;
+        (*m_ofs) << "  0"      << '\n';
+        (*m_ofs) << "ENDTAB"   << '\n';
     }
-    (*m_ofs) << "  0"      << endl;
-    (*m_ofs) << "ENDSEC"   << endl;
+    (*m_ofs) << "  0"      << '\n';
+    (*m_ofs) << "ENDSEC"   << '\n';
 }
 
 //***************************
@@ -157,66 +158,66 @@ void CDxfWrite::writeTablesSection(void)
 void CDxfWrite::makeLayerTable(void)
 {
     std::string tablehash = getLayerHandle();
-    (*m_ssLayer) << "  0"      << endl;
-    (*m_ssLayer) << "TABLE"    << endl;
-    (*m_ssLayer) << "  2"      << endl;
-    (*m_ssLayer) << "LAYER"    << endl;
-    (*m_ssLayer) << "  5"      << endl;
-    (*m_ssLayer) << tablehash  << endl;
+    (*m_ssLayer) << "  0"      << '\n';
+    (*m_ssLayer) << "TABLE"    << '\n';
+    (*m_ssLayer) << "  2"      << '\n';
+    (*m_ssLayer) << "LAYER"    << '\n';
+    (*m_ssLayer) << "  5"      << '\n';
+    (*m_ssLayer) << tablehash  << '\n';
     if (m_version > 12) {
-        (*m_ssLayer) << "330"      << endl;
-        (*m_ssLayer) << 0          << endl;
-        (*m_ssLayer) << "100"      << endl;
-        (*m_ssLayer) << "AcDbSymbolTable"   << endl;
-    }
-    (*m_ssLayer) << " 70"      << endl;
-    (*m_ssLayer) << m_layerList.size() + 1 << endl;
-
-    (*m_ssLayer) << "  0"      << endl;
-    (*m_ssLayer) << "LAYER"    << endl;
-    (*m_ssLayer) << "  5"      << endl;
-    (*m_ssLayer) << getLayerHandle()  << endl;
+        (*m_ssLayer) << "330"      << '\n';
+        (*m_ssLayer) << 0          << '\n';
+        (*m_ssLayer) << "100"      << '\n';
+        (*m_ssLayer) << "AcDbSymbolTable"   << '\n';
+    }
+    (*m_ssLayer) << " 70"      << '\n';
+    (*m_ssLayer) << m_layerList.size() + 1 << '\n';
+
+    (*m_ssLayer) << "  0"      << '\n';
+    (*m_ssLayer) << "LAYER"    << '\n';
+    (*m_ssLayer) << "  5"      << '\n';
+    (*m_ssLayer) << getLayerHandle()  << '\n';
     if (m_version > 12) {
-        (*m_ssLayer) << "330"      << endl;
-        (*m_ssLayer) << tablehash  << endl;
-        (*m_ssLayer) << "100"      << endl;
-        (*m_ssLayer) << "AcDbSymbolTableRecord"      << endl;
-        (*m_ssLayer) << "100"      << endl;
-        (*m_ssLayer) << "AcDbLayerTableRecord"      << endl;
-    }
-    (*m_ssLayer) << "  2"      << endl;
-    (*m_ssLayer) << "0"        << endl;
-    (*m_ssLayer) << " 70"      << endl;
-    (*m_ssLayer) << "   0"     << endl;
-    (*m_ssLayer) << " 62"      << endl;
-    (*m_ssLayer) << "   7"     << endl;
-    (*m_ssLayer) << "  6"      << endl;
-    (*m_ssLayer) << "CONTINUOUS" << endl;
+        (*m_ssLayer) << "330"      << '\n';
+        (*m_ssLayer) << tablehash  << '\n';
+        (*m_ssLayer) << "100"      << '\n';
+        (*m_ssLayer) << "AcDbSymbolTableRecord"      << '\n';
+        (*m_ssLayer) << "100"      << '\n';
+        (*m_ssLayer) << "AcDbLayerTableRecord"      << '\n';
+    }
+    (*m_ssLayer) << "  2"      << '\n';
+    (*m_ssLayer) << "0"        << '\n';
+    (*m_ssLayer) << " 70"      << '\n';
+    (*m_ssLayer) << "   0"     << '\n';
+    (*m_ssLayer) << " 62"      << '\n';
+    (*m_ssLayer) << "   7"     << '\n';
+    (*m_ssLayer) << "  6"      << '\n';
+    (*m_ssLayer) << "CONTINUOUS" << '\n';
 
     for (auto& l: m_layerList) {
-        (*m_ssLayer) << "  0"      << endl;
-        (*m_ssLayer) << "LAYER"      << endl;
-        (*m_ssLayer) << "  5"      << endl;
-        (*m_ssLayer) << getLayerHandle() << endl;
+        (*m_ssLayer) << "  0"      << '\n';
+        (*m_ssLayer) << "LAYER"      << '\n';
+        (*m_ssLayer) << "  5"      << '\n';
+        (*m_ssLayer) << getLayerHandle() << '\n';
         if (m_version > 12) {
-            (*m_ssLayer) << "330"      << endl;
-            (*m_ssLayer) << tablehash  << endl;
-            (*m_ssLayer) << "100"      << endl;
-            (*m_ssLayer) << "AcDbSymbolTableRecord"      << endl;
-            (*m_ssLayer) << "100"      << endl;
-            (*m_ssLayer) << "AcDbLayerTableRecord"      << endl;
+            (*m_ssLayer) << "330"      << '\n';
+            (*m_ssLayer) << tablehash  << '\n';
+            (*m_ssLayer) << "100"      << '\n';
+            (*m_ssLayer) << "AcDbSymbolTableRecord"      << '\n';
+            (*m_ssLayer) << "100"      << '\n';
+            (*m_ssLayer) << "AcDbLayerTableRecord"      << '\n';
         }
-        (*m_ssLayer) << "  2"      << endl;
-        (*m_ssLayer) << l << endl;
-        (*m_ssLayer) << " 70"      << endl;
-        (*m_ssLayer) << "    0"      << endl;
-        (*m_ssLayer) << " 62"      << endl;
-        (*m_ssLayer) << "    7"      << endl;
-        (*m_ssLayer) << "  6"      << endl;
-        (*m_ssLayer) << "CONTINUOUS"      << endl;
+        (*m_ssLayer) << "  2"      << '\n';
+        (*m_ssLayer) << l << '\n';
+        (*m_ssLayer) << " 70"      << '\n';
+        (*m_ssLayer) << "    0"      << '\n';
+        (*m_ssLayer) << " 62"      << '\n';
+        (*m_ssLayer) << "    7"      << '\n';
+        (*m_ssLayer) << "  6"      << '\n';
+        (*m_ssLayer) << "CONTINUOUS"      << '\n';
     }
-    (*m_ssLayer) << "  0"      << endl;
-    (*m_ssLayer) << "ENDTAB"   << endl;
+    (*m_ssLayer) << "  0"      << '\n';
+    (*m_ssLayer) << "ENDTAB"   << '\n';
 }
 
 //***************************
@@ -229,50 +230,50 @@ void CDxfWrite::makeBlockRecordTableHead(void)
     }
         std::string tablehash = getBlkRecordHandle();
         m_saveBlockRecordTableHandle = tablehash;
-        (*m_ssBlkRecord) << "  0"      << endl;
-        (*m_ssBlkRecord) << "TABLE"      << endl;
-        (*m_ssBlkRecord) << "  2"      << endl;
-        (*m_ssBlkRecord) << "BLOCK_RECORD"      << endl;
-        (*m_ssBlkRecord) << "  5"      << endl;
-        (*m_ssBlkRecord) << tablehash  << endl;
-        (*m_ssBlkRecord) << "330"      << endl;
-        (*m_ssBlkRecord) << "0"        << endl;
-        (*m_ssBlkRecord) << "100"      << endl;
-        (*m_ssBlkRecord) << "AcDbSymbolTable"      << endl;
-        (*m_ssBlkRecord) << "  70"      << endl;
-        (*m_ssBlkRecord) << (m_blockList.size() + 5)   << endl;
+        (*m_ssBlkRecord) << "  0"      << '\n';
+        (*m_ssBlkRecord) << "TABLE"      << '\n';
+        (*m_ssBlkRecord) << "  2"      << '\n';
+        (*m_ssBlkRecord) << "BLOCK_RECORD"      << '\n';
+        (*m_ssBlkRecord) << "  5"      << '\n';
+        (*m_ssBlkRecord) << tablehash  << '\n';
+        (*m_ssBlkRecord) << "330"      << '\n';
+        (*m_ssBlkRecord) << "0"        << '\n';
+        (*m_ssBlkRecord) << "100"      << '\n';
+        (*m_ssBlkRecord) << "AcDbSymbolTable"      << '\n';
+        (*m_ssBlkRecord) << "  70"      << '\n';
+        (*m_ssBlkRecord) << (m_blockList.size() + 5)   << '\n';
         
         m_saveModelSpaceHandle = getBlkRecordHandle();
-        (*m_ssBlkRecord) << "  0"      << endl;
-        (*m_ssBlkRecord) << "BLOCK_RECORD"      << endl;
-        (*m_ssBlkRecord) << "  5"      << endl;
-        (*m_ssBlkRecord) << m_saveModelSpaceHandle  << endl;
-        (*m_ssBlkRecord) << "330"      << endl;
-        (*m_ssBlkRecord) << tablehash  << endl;
-        (*m_ssBlkRecord) << "100"      << endl;
-        (*m_ssBlkRecord) << "AcDbSymbolTableRecord"      << endl;
-        (*m_ssBlkRecord) << "100"      << endl;
-        (*m_ssBlkRecord) << "AcDbBlockTableRecord"      << endl;
-        (*m_ssBlkRecord) << "  2"      << endl;
-        (*m_ssBlkRecord) << "*MODEL_SPACE"   << endl;
-//        (*m_ssBlkRecord) << "  1"      << endl;
-//        (*m_ssBlkRecord) << " "        << endl;
+        (*m_ssBlkRecord) << "  0"      << '\n';
+        (*m_ssBlkRecord) << "BLOCK_RECORD"      << '\n';
+        (*m_ssBlkRecord) << "  5"      << '\n';
+        (*m_ssBlkRecord) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssBlkRecord) << "330"      << '\n';
+        (*m_ssBlkRecord) << tablehash  << '\n';
+        (*m_ssBlkRecord) << "100"      << '\n';
+        (*m_ssBlkRecord) << "AcDbSymbolTableRecord"      << '\n';
+        (*m_ssBlkRecord) << "100"      << '\n';
+        (*m_ssBlkRecord) << "AcDbBlockTableRecord"      << '\n';
+        (*m_ssBlkRecord) << "  2"      << '\n';
+        (*m_ssBlkRecord) << "*MODEL_SPACE"   << '\n';
+//        (*m_ssBlkRecord) << "  1"      << '\n';
+//        (*m_ssBlkRecord) << " "        << '\n';
 
         m_savePaperSpaceHandle = getBlkRecordHandle();
-        (*m_ssBlkRecord) << "  0"      << endl;
-        (*m_ssBlkRecord) << "BLOCK_RECORD"  << endl;
-        (*m_ssBlkRecord) << "  5"      << endl;
-        (*m_ssBlkRecord) << m_savePaperSpaceHandle  << endl;
-        (*m_ssBlkRecord) << "330"      << endl;
-        (*m_ssBlkRecord) << tablehash  << endl;
-        (*m_ssBlkRecord) << "100"      << endl;
-        (*m_ssBlkRecord) << "AcDbSymbolTableRecord"      << endl;
-        (*m_ssBlkRecord) << "100"      << endl;
-        (*m_ssBlkRecord) << "AcDbBlockTableRecord"      << endl;
-        (*m_ssBlkRecord) << "  2"      << endl;
-        (*m_ssBlkRecord) << "*PAPER_SPACE"   << endl;
-//        (*m_ssBlkRecord) << "  1"      << endl;
-//        (*m_ssBlkRecord) << " "        << endl;
+        (*m_ssBlkRecord) << "  0"      << '\n';
+        (*m_ssBlkRecord) << "BLOCK_RECORD"  << '\n';
+        (*m_ssBlkRecord) << "  5"      << '\n';
+        (*m_ssBlkRecord) << m_savePaperSpaceHandle  << '\n';
+        (*m_ssBlkRecord) << "330"      << '\n';
+        (*m_ssBlkRecord) << tablehash  << '\n';
+        (*m_ssBlkRecord) << "100"      << '\n';
+        (*m_ssBlkRecord) << "AcDbSymbolTableRecord"      << '\n';
+        (*m_ssBlkRecord) << "100"      << '\n';
+        (*m_ssBlkRecord) << "AcDbBlockTableRecord"      << '\n';
+        (*m_ssBlkRecord) << "  2"      << '\n';
+        (*m_ssBlkRecord) << "*PAPER_SPACE"   << '\n';
+//        (*m_ssBlkRecord) << "  1"      << '\n';
+//        (*m_ssBlkRecord) << " "        << '\n';
 }
  
 //***************************
@@ -286,20 +287,20 @@ void CDxfWrite::makeBlockRecordTableBody(void)
     
     int iBlkRecord = 0;
     for (auto& b: m_blockList) {
-        (*m_ssBlkRecord) << "  0"      << endl;
-        (*m_ssBlkRecord) << "BLOCK_RECORD"      << endl;
-        (*m_ssBlkRecord) << "  5"      << endl;
-        (*m_ssBlkRecord) << m_blkRecordList.at(iBlkRecord)      << endl;
-        (*m_ssBlkRecord) << "330"      << endl;
-        (*m_ssBlkRecord) << m_saveBlockRecordTableHandle  << endl;
-        (*m_ssBlkRecord) << "100"      << endl;
-        (*m_ssBlkRecord) << "AcDbSymbolTableRecord"      << endl;
-        (*m_ssBlkRecord) << "100"      << endl;
-        (*m_ssBlkRecord) << "AcDbBlockTableRecord"      << endl;
-        (*m_ssBlkRecord) << "  2"      << endl;
-        (*m_ssBlkRecord) << b          << endl;
-//        (*m_ssBlkRecord) << " 70"      << endl;
-//        (*m_ssBlkRecord) << "    0"      << endl;
+        (*m_ssBlkRecord) << "  0"      << '\n';
+        (*m_ssBlkRecord) << "BLOCK_RECORD"      << '\n';
+        (*m_ssBlkRecord) << "  5"      << '\n';
+        (*m_ssBlkRecord) << m_blkRecordList.at(iBlkRecord)      << '\n';
+        (*m_ssBlkRecord) << "330"      << '\n';
+        (*m_ssBlkRecord) << m_saveBlockRecordTableHandle  << '\n';
+        (*m_ssBlkRecord) << "100"      << '\n';
+        (*m_ssBlkRecord) << "AcDbSymbolTableRecord"      << '\n';
+        (*m_ssBlkRecord) << "100"      << '\n';
+        (*m_ssBlkRecord) << "AcDbBlockTableRecord"      << '\n';
+        (*m_ssBlkRecord) << "  2"      << '\n';
+        (*m_ssBlkRecord) << b          << '\n';
+//        (*m_ssBlkRecord) << " 70"      << '\n';
+//        (*m_ssBlkRecord) << "    0"      << '\n';
         iBlkRecord++;
     }
 }
@@ -309,108 +310,108 @@ void CDxfWrite::makeBlockRecordTableBody(void)
 //added by Wandererfan 2018 (wandererfan@gmail.com) for FreeCAD project
 void CDxfWrite::makeBlockSectionHead(void)
 {
-    (*m_ssBlock) << "  0"          << endl;
-    (*m_ssBlock) << "SECTION"      << endl;
-    (*m_ssBlock) << "  2"          << endl;
-    (*m_ssBlock) << "BLOCKS"       << endl;
-    (*m_ssBlock) << "  0"          << endl;
-    (*m_ssBlock) << "BLOCK"        << endl;
-    (*m_ssBlock) << "  5"          << endl;
+    (*m_ssBlock) << "  0"          << '\n';
+    (*m_ssBlock) << "SECTION"      << '\n';
+    (*m_ssBlock) << "  2"          << '\n';
+    (*m_ssBlock) << "BLOCKS"       << '\n';
+    (*m_ssBlock) << "  0"          << '\n';
+    (*m_ssBlock) << "BLOCK"        << '\n';
+    (*m_ssBlock) << "  5"          << '\n';
     m_currentBlock = getBlockHandle();
-    (*m_ssBlock) << m_currentBlock << endl;
+    (*m_ssBlock) << m_currentBlock << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "330"      << endl;
-        (*m_ssBlock) << m_saveModelSpaceHandle << endl;
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbEntity"      << endl;
+        (*m_ssBlock) << "330"      << '\n';
+        (*m_ssBlock) << m_saveModelSpaceHandle << '\n';
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbEntity"      << '\n';
     }
-    (*m_ssBlock) << "  8"          << endl;
-    (*m_ssBlock) << "0"            << endl;
+    (*m_ssBlock) << "  8"          << '\n';
+    (*m_ssBlock) << "0"            << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbBlockBegin"  << endl;
-    }
-    (*m_ssBlock) << "  2"          << endl;
-    (*m_ssBlock) << "*MODEL_SPACE" << endl;
-    (*m_ssBlock) << " 70"          << endl;
-    (*m_ssBlock) << "   0"         << endl;
-    (*m_ssBlock) << " 10"          << endl;
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << " 20"          << endl; 
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << " 30"          << endl;
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << "  3"          << endl;
-    (*m_ssBlock) << "*MODEL_SPACE" << endl;
-    (*m_ssBlock) << "  1"          << endl;
-    (*m_ssBlock) << " "            << endl;
-    (*m_ssBlock) << "  0"          << endl;
-    (*m_ssBlock) << "ENDBLK"       << endl;
-    (*m_ssBlock) << "  5"          << endl;
-    (*m_ssBlock) << getBlockHandle()   << endl;
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbBlockBegin"  << '\n';
+    }
+    (*m_ssBlock) << "  2"          << '\n';
+    (*m_ssBlock) << "*MODEL_SPACE" << '\n';
+    (*m_ssBlock) << " 70"          << '\n';
+    (*m_ssBlock) << "   0"         << '\n';
+    (*m_ssBlock) << " 10"          << '\n';
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << " 20"          << '\n'; 
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << " 30"          << '\n';
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << "  3"          << '\n';
+    (*m_ssBlock) << "*MODEL_SPACE" << '\n';
+    (*m_ssBlock) << "  1"          << '\n';
+    (*m_ssBlock) << " "            << '\n';
+    (*m_ssBlock) << "  0"          << '\n';
+    (*m_ssBlock) << "ENDBLK"       << '\n';
+    (*m_ssBlock) << "  5"          << '\n';
+    (*m_ssBlock) << getBlockHandle()   << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "330"      << endl;
-        (*m_ssBlock) << m_saveModelSpaceHandle << endl;
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbEntity"  << endl;
+        (*m_ssBlock) << "330"      << '\n';
+        (*m_ssBlock) << m_saveModelSpaceHandle << '\n';
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbEntity"  << '\n';
     }
-    (*m_ssBlock) << "  8"          << endl;
-    (*m_ssBlock) << "0"            << endl;
+    (*m_ssBlock) << "  8"          << '\n';
+    (*m_ssBlock) << "0"            << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbBlockEnd"      << endl;
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbBlockEnd"      << '\n';
     }
 
-    (*m_ssBlock) << "  0"          << endl;
-    (*m_ssBlock) << "BLOCK"        << endl;
-    (*m_ssBlock) << "  5"          << endl;
+    (*m_ssBlock) << "  0"          << '\n';
+    (*m_ssBlock) << "BLOCK"        << '\n';
+    (*m_ssBlock) << "  5"          << '\n';
     m_currentBlock = getBlockHandle();
-    (*m_ssBlock) << m_currentBlock << endl;
+    (*m_ssBlock) << m_currentBlock << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "330"      << endl;
-        (*m_ssBlock) << m_savePaperSpaceHandle << endl;
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbEntity"      << endl;
-        (*m_ssBlock) << " 67"          << endl;
-        (*m_ssBlock) << "1"            << endl;
-    }
-    (*m_ssBlock) << "  8"          << endl;
-    (*m_ssBlock) << "0"            << endl;
+        (*m_ssBlock) << "330"      << '\n';
+        (*m_ssBlock) << m_savePaperSpaceHandle << '\n';
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbEntity"      << '\n';
+        (*m_ssBlock) << " 67"          << '\n';
+        (*m_ssBlock) << "1"            << '\n';
+    }
+    (*m_ssBlock) << "  8"          << '\n';
+    (*m_ssBlock) << "0"            << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbBlockBegin"  << endl;
-    }
-    (*m_ssBlock) << "  2"          << endl;
-    (*m_ssBlock) << "*PAPER_SPACE" << endl;
-    (*m_ssBlock) << " 70"          << endl;
-    (*m_ssBlock) << "   0"         << endl;
-    (*m_ssBlock) << " 10"          << endl;
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << " 20"          << endl; 
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << " 30"          << endl;
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << "  3"          << endl;
-    (*m_ssBlock) << "*PAPER_SPACE" << endl;
-    (*m_ssBlock) << "  1"          << endl;
-    (*m_ssBlock) << " "            << endl;
-    (*m_ssBlock) << "  0"          << endl;
-    (*m_ssBlock) << "ENDBLK"       << endl;
-    (*m_ssBlock) << "  5"          << endl;
-    (*m_ssBlock) << getBlockHandle()   << endl;
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbBlockBegin"  << '\n';
+    }
+    (*m_ssBlock) << "  2"          << '\n';
+    (*m_ssBlock) << "*PAPER_SPACE" << '\n';
+    (*m_ssBlock) << " 70"          << '\n';
+    (*m_ssBlock) << "   0"         << '\n';
+    (*m_ssBlock) << " 10"          << '\n';
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << " 20"          << '\n'; 
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << " 30"          << '\n';
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << "  3"          << '\n';
+    (*m_ssBlock) << "*PAPER_SPACE" << '\n';
+    (*m_ssBlock) << "  1"          << '\n';
+    (*m_ssBlock) << " "            << '\n';
+    (*m_ssBlock) << "  0"          << '\n';
+    (*m_ssBlock) << "ENDBLK"       << '\n';
+    (*m_ssBlock) << "  5"          << '\n';
+    (*m_ssBlock) << getBlockHandle()   << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "330"      << endl;
-        (*m_ssBlock) << m_savePaperSpaceHandle << endl;
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbEntity"      << endl;
-        (*m_ssBlock) << " 67"      << endl;      //paper_space flag
-        (*m_ssBlock) << "    1"    << endl;
-    }
-    (*m_ssBlock) << "  8"          << endl;
-    (*m_ssBlock) << "0"            << endl;
+        (*m_ssBlock) << "330"      << '\n';
+        (*m_ssBlock) << m_savePaperSpaceHandle << '\n';
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbEntity"      << '\n';
+        (*m_ssBlock) << " 67"      << '\n';      //paper_space flag
+        (*m_ssBlock) << "    1"    << '\n';
+    }
+    (*m_ssBlock) << "  8"          << '\n';
+    (*m_ssBlock) << "0"            << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbBlockEnd" << endl;
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbBlockEnd" << '\n';
     }
 }
 
@@ -435,40 +436,36 @@ std::string CDxfWrite::getPlateFile(std::string fileSpec)
     return outString.str();
 }
 
+// handles are upper case hex numbers with at least two digits
+static std::string formatHandle(int handle)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%02X", static_cast<unsigned int>(handle));
+    return std::string(buf);
+}
+
 std::string CDxfWrite::getEntityHandle(void)
 {
     m_entityHandle++;
-    std::stringstream ss;
-    ss << std::uppercase << std::hex << std::setfill('0') << std::setw(2);
-    ss << m_entityHandle;
-    return ss.str();
+    return formatHandle(m_entityHandle);
 }
 
 std::string CDxfWrite::getLayerHandle(void)
 {
     m_layerHandle++;
-    std::stringstream ss;
-    ss << std::uppercase << std::hex << std::setfill('0') << std::setw(2);
-    ss << m_layerHandle;
-    return ss.str();
+    return formatHandle(m_layerHandle);
 }
 
 std::string CDxfWrite::getBlockHandle(void)
 {
     m_blockHandle++;
-    std::stringstream ss;
-    ss << std::uppercase << std::hex << std::setfill('0') << std::setw(2);
-    ss << m_blockHandle;
-    return ss.str();
+    return formatHandle(m_blockHandle);
 }
 
 std::string CDxfWrite::getBlkRecordHandle(void)
 {
     m_blkRecordHandle++;
-    std::stringstream ss;
-    ss << std::uppercase << std::hex << std::setfill('0') << std::setw(2);
-    ss << m_blkRecordHandle;
-    return ss.str();
+    return formatHandle(m_blkRecordHandle);
 }
 
 void CDxfWrite::addBlockName(std::string b, std::string h) 
@@ -492,34 +489,34 @@ void CDxfWrite::putLine(const Base::Vector3d s, const Base::Vector3d e,
                           std::ostringstream* outStream, const std::string handle,
                           const std::string ownerHandle)
 {
-    (*outStream) << "  0"       << endl;
-    (*outStream) << "LINE"      << endl;
-    (*outStream) << "  5"       << endl;
-    (*outStream) << handle      << endl;
+    (*outStream) << "  0"       << '\n';
+    (*outStream) << "LINE"      << '\n';
+    (*outStream) << "  5"       << '\n';
+    (*outStream) << handle      << '\n';
     if (m_version > 12) {
-        (*outStream) << "330"      << endl;
-        (*outStream) << ownerHandle  << endl;
-        (*outStream) << "100"      << endl;
-        (*outStream) << "AcDbEntity"      << endl;
+        (*outStream) << "330"      << '\n';
+        (*outStream) << ownerHandle  << '\n';
+        (*outStream) << "100"      << '\n';
+        (*outStream) << "AcDbEntity"      << '\n';
     }
-    (*outStream) << "  8"       << endl;    // Group code for layer name
-    (*outStream) << getLayerName()  << endl;    // Layer number
+    (*outStream) << "  8"       << '\n';    // Group code for layer name
+    (*outStream) << getLayerName()  << '\n';    // Layer number
     if (m_version > 12) {
-        (*outStream) << "100"      << endl;
-        (*outStream) << "AcDbLine" << endl;
+        (*outStream) << "100"      << '\n';
+        (*outStream) << "AcDbLine" << '\n';
     }
-    (*outStream) << " 10"       << endl;    // Start point of line
-    (*outStream) << s.x         << endl;    // X in WCS coordinates
-    (*outStream) << " 20"       << endl;
-    (*outStream) << s.y         << endl;    // Y in WCS coordinates
-    (*outStream) << " 30"       << endl;
-    (*outStream) << s.z         << endl;    // Z in WCS coordinates
-    (*outStream) << " 11"       << endl;    // End point of line
-    (*outStream) << e.x         << endl;    // X in WCS coordinates
-    (*outStream) << " 21"       << endl;
-    (*outStream) << e.y         << endl;    // Y in WCS coordinates
-    (*outStream) << " 31"       << endl;
-    (*outStream) << e.z         << endl;    // Z in WCS coordinates
+    (*outStream) << " 10"       << '\n';    // Start point of line
+    (*outStream) << s.x         << '\n';    // X in WCS coordinates
+    (*outStream) << " 20"       << '\n';
+    (*outStream) << s.y         << '\n';    // Y in WCS coordinates
+    (*outStream) << " 30"       << '\n';
+    (*outStream) << s.z         << '\n';    // Z in WCS coordinates
+    (*outStream) << " 11"       << '\n';    // End point of line
+    (*outStream) << e.x         << '\n';    // X in WCS coordinates
+    (*outStream) << " 21"       << '\n';
+    (*outStream) << e.y         << '\n';    // Y in WCS coordinates
+    (*outStream) << " 31"       << '\n';
+    (*outStream) << e.z         << '\n';    // Z in WCS coordinates
 }
 
 
@@ -528,57 +525,57 @@ void CDxfWrite::putLine(const Base::Vector3d s, const Base::Vector3d e,
 //added by Wandererfan 2018 (wandererfan@gmail.com) for FreeCAD project
 void CDxfWrite::writeLWPolyLine(const LWPolyDataOut &pd)
 {
-    (*m_ssEntity) << "  0"               << endl;
-    (*m_ssEntity) << "LWPOLYLINE"     << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"               << '\n';
+    (*m_ssEntity) << "LWPOLYLINE"     << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
     if (m_version > 12) {
-        (*m_ssEntity) << "100"            << endl;    //100 groups are not part of R12
-        (*m_ssEntity) << "AcDbPolyline"   << endl;
-    }
-    (*m_ssEntity) << "  8"            << endl;    // Group code for layer name
-    (*m_ssEntity) << getLayerName()   << endl;    // Layer name
-    (*m_ssEntity) << " 90"            << endl;
-    (*m_ssEntity) << pd.nVert         << endl;    // number of vertices
-    (*m_ssEntity) << " 70"            << endl;
-    (*m_ssEntity) << pd.Flag          << endl;
-    (*m_ssEntity) << " 43"            << endl;
-    (*m_ssEntity) << "0"              << endl;    //Constant width opt
-//    (*m_ssEntity) << pd.Width         << endl;    //Constant width opt
-//    (*m_ssEntity) << " 38"            << endl;
-//    (*m_ssEntity) << pd.Elev          << endl;    // Elevation
-//    (*m_ssEntity) << " 39"            << endl;
-//    (*m_ssEntity) << pd.Thick         << endl;    // Thickness
+        (*m_ssEntity) << "100"            << '\n';    //100 groups are not part of R12
+        (*m_ssEntity) << "AcDbPolyline"   << '\n';
+    }
+    (*m_ssEntity) << "  8"            << '\n';    // Group code for layer name
+    (*m_ssEntity) << getLayerName()   << '\n';    // Layer name
+    (*m_ssEntity) << " 90"            << '\n';
+    (*m_ssEntity) << pd.nVert         << '\n';    // number of vertices
+    (*m_ssEntity) << " 70"            << '\n';
+    (*m_ssEntity) << pd.Flag          << '\n';
+    (*m_ssEntity) << " 43"            << '\n';
+    (*m_ssEntity) << "0"              << '\n';    //Constant width opt
+//    (*m_ssEntity) << pd.Width         << '\n';    //Constant width opt
+//    (*m_ssEntity) << " 38"            << '\n';
+//    (*m_ssEntity) << pd.Elev          << '\n';    // Elevation
+//    (*m_ssEntity) << " 39"            << '\n';
+//    (*m_ssEntity) << pd.Thick         << '\n';    // Thickness
     for (auto& p: pd.Verts) {
-        (*m_ssEntity) << " 10"        << endl;    // Vertices
-        (*m_ssEntity) << p.x          << endl;
-        (*m_ssEntity) << " 20"        << endl;
-        (*m_ssEntity) << p.y          << endl;
+        (*m_ssEntity) << " 10"        << '\n';    // Vertices
+        (*m_ssEntity) << p.x          << '\n';
+        (*m_ssEntity) << " 20"        << '\n';
+        (*m_ssEntity) << p.y          << '\n';
     } 
     for (auto& s: pd.StartWidth) {
-        (*m_ssEntity) << " 40"        << endl;
-        (*m_ssEntity) << s            << endl;    // Start Width
+        (*m_ssEntity) << " 40"        << '\n';
+        (*m_ssEntity) << s            << '\n';    // Start Width
     }
     for (auto& e: pd.EndWidth) {
-        (*m_ssEntity) << " 41"        << endl;
-        (*m_ssEntity) << e            << endl;    // End Width
+        (*m_ssEntity) << " 41"        << '\n';
+        (*m_ssEntity) << e            << '\n';    // End Width
     }
     for (auto& b: pd.Bulge) {                // Bulge
-        (*m_ssEntity) << " 42"        << endl;
-        (*m_ssEntity) << b            << endl;
+        (*m_ssEntity) << " 42"        << '\n';
+        (*m_ssEntity) << b            << '\n';
     }
-//    (*m_ssEntity) << "210"            << endl;    //Extrusion dir
-//    (*m_ssEntity) << pd.Extr.x        << endl;
-//    (*m_ssEntity) << "220"            << endl;
-//    (*m_ssEntity) << pd.Extr.y        << endl;
-//    (*m_ssEntity) << "230"            << endl;
-//    (*m_ssEntity) << pd.Extr.z        << endl;
+//    (*m_ssEntity) << "210"            << '\n';    //Extrusion dir
+//    (*m_ssEntity) << pd.Extr.x        << '\n';
+//    (*m_ssEntity) << "220"            << '\n';
+//    (*m_ssEntity) << pd.Extr.y        << '\n';
+//    (*m_ssEntity) << "230"            << '\n';
+//    (*m_ssEntity) << pd.Extr.z        << '\n';
 }
 
 //***************************
@@ -586,78 +583,78 @@ void CDxfWrite::writeLWPolyLine(const LWPolyDataOut &pd)
 //added by Wandererfan 2018 (wandererfan@gmail.com) for FreeCAD project
 void CDxfWrite::writePolyline(const LWPolyDataOut &pd)
 {
-    (*m_ssEntity) << "  0"            << endl;
-    (*m_ssEntity) << "POLYLINE"       << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"            << '\n';
+    (*m_ssEntity) << "POLYLINE"       << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"            << endl;
-    (*m_ssEntity) << getLayerName()       << endl;    // Layer name
+    (*m_ssEntity) << "  8"            << '\n';
+    (*m_ssEntity) << getLayerName()       << '\n';    // Layer name
     if (m_version > 12) {
-        (*m_ssEntity) << "100"            << endl;    //100 groups are not part of R12
-        (*m_ssEntity) << "AcDbPolyline"   << endl;
-    }
-    (*m_ssEntity) << " 66"            << endl;
-    (*m_ssEntity) << "     1"         << endl;    // vertices follow
-    (*m_ssEntity) << " 10"            << endl;
-    (*m_ssEntity) << "0.0"            << endl;
-    (*m_ssEntity) << " 20"            << endl;
-    (*m_ssEntity) << "0.0"            << endl;
-    (*m_ssEntity) << " 30"            << endl;
-    (*m_ssEntity) << "0.0"            << endl;
-    (*m_ssEntity) << " 70"            << endl;
-    (*m_ssEntity) << "0"              << endl;
+        (*m_ssEntity) << "100"            << '\n';    //100 groups are not part of R12
+        (*m_ssEntity) << "AcDbPolyline"   << '\n';
+    }
+    (*m_ssEntity) << " 66"            << '\n';
+    (*m_ssEntity) << "     1"         << '\n';    // vertices follow
+    (*m_ssEntity) << " 10"            << '\n';
+    (*m_ssEntity) << "0.0"            << '\n';
+    (*m_ssEntity) << " 20"            << '\n';
+    (*m_ssEntity) << "0.0"            << '\n';
+    (*m_ssEntity) << " 30"            << '\n';
+    (*m_ssEntity) << "0.0"            << '\n';
+    (*m_ssEntity) << " 70"            << '\n';
+    (*m_ssEntity) << "0"              << '\n';
     for (auto& p: pd.Verts) {
-        (*m_ssEntity) << "  0"        << endl;
-        (*m_ssEntity) << "VERTEX"     << endl;
-        (*m_ssEntity) << "  5"      << endl;
-        (*m_ssEntity) << getEntityHandle() << endl;
-        (*m_ssEntity) << "  8"        << endl;
-        (*m_ssEntity) << getLayerName()   << endl;
-        (*m_ssEntity) << " 10"        << endl;
-        (*m_ssEntity) << p.x          << endl;
-        (*m_ssEntity) << " 20"        << endl;
-        (*m_ssEntity) << p.y          << endl;
-        (*m_ssEntity) << " 30"        << endl;
-        (*m_ssEntity) << "0.0"        << endl;
+        (*m_ssEntity) << "  0"        << '\n';
+        (*m_ssEntity) << "VERTEX"     << '\n';
+        (*m_ssEntity) << "  5"      << '\n';
+        (*m_ssEntity) << getEntityHandle() << '\n';
+        (*m_ssEntity) << "  8"        << '\n';
+        (*m_ssEntity) << getLayerName()   << '\n';
+        (*m_ssEntity) << " 10"        << '\n';
+        (*m_ssEntity) << p.x          << '\n';
+        (*m_ssEntity) << " 20"        << '\n';
+        (*m_ssEntity) << p.y          << '\n';
+        (*m_ssEntity) << " 30"        << '\n';
+        (*m_ssEntity) << "0.0"        << '\n';
     } 
-    (*m_ssEntity) << "  0"            << endl;
-    (*m_ssEntity) << "SEQEND"         << endl;
-    (*m_ssEntity) << "  5"            << endl;
-    (*m_ssEntity) << getEntityHandle()      << endl;
-    (*m_ssEntity) << "  8"            << endl;
-    (*m_ssEntity) << getLayerName()       << endl;
+    (*m_ssEntity) << "  0"            << '\n';
+    (*m_ssEntity) << "SEQEND"         << '\n';
+    (*m_ssEntity) << "  5"            << '\n';
+    (*m_ssEntity) << getEntityHandle()      << '\n';
+    (*m_ssEntity) << "  8"            << '\n';
+    (*m_ssEntity) << getLayerName()       << '\n';
 }
 
 void CDxfWrite::writePoint(const double* s)
 {
-    (*m_ssEntity) << "  0"            << endl;
-    (*m_ssEntity) << "POINT"          << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"            << '\n';
+    (*m_ssEntity) << "POINT"          << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"            << endl;    // Group code for layer name
-    (*m_ssEntity) << getLayerName()       << endl;    // Layer name
+    (*m_ssEntity) << "  8"            << '\n';    // Group code for layer name
+    (*m_ssEntity) << getLayerName()       << '\n';    // Layer name
     if (m_version > 12) {
-        (*m_ssEntity) << "100"       << endl;
-        (*m_ssEntity) << "AcDbPoint" << endl;
+        (*m_ssEntity) << "100"       << '\n';
+        (*m_ssEntity) << "AcDbPoint" << '\n';
     }
-    (*m_ssEntity) << " 10"            << endl;
-    (*m_ssEntity) << s[0]             << endl;    // X in WCS coordinates
-    (*m_ssEntity) << " 20"            << endl;
-    (*m_ssEntity) << s[1]             << endl;    // Y in WCS coordinates
-    (*m_ssEntity) << " 30"            << endl;
-    (*m_ssEntity) << s[2]             << endl;    // Z in WCS coordinates
+    (*m_ssEntity) << " 10"            << '\n';
+    (*m_ssEntity) << s[0]             << '\n';    // X in WCS coordinates
+    (*m_ssEntity) << " 20"            << '\n';
+    (*m_ssEntity) << s[1]             << '\n';    // Y in WCS coordinates
+    (*m_ssEntity) << " 30"            << '\n';
+    (*m_ssEntity) << s[2]             << '\n';    // Z in WCS coordinates
 }
 
 void CDxfWrite::writeArc(const double* s, const double* e, const double* c, bool dir)
@@ -675,69 +672,69 @@ void CDxfWrite::writeArc(const double* s, const double* e, const double* c, bool
         start_angle = end_angle;
         end_angle = temp;
     }
-    (*m_ssEntity) << "  0"       << endl;
-    (*m_ssEntity) << "ARC"       << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"       << '\n';
+    (*m_ssEntity) << "ARC"       << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
-    }
-    (*m_ssEntity) << "  8"       << endl;    // Group code for layer name
-    (*m_ssEntity) << getLayerName()  << endl;    // Layer number
-//    (*m_ssEntity) << " 62"          << endl;
-//    (*m_ssEntity) << "     0"       << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
+    }
+    (*m_ssEntity) << "  8"       << '\n';    // Group code for layer name
+    (*m_ssEntity) << getLayerName()  << '\n';    // Layer number
+//    (*m_ssEntity) << " 62"          << '\n';
+//    (*m_ssEntity) << "     0"       << '\n';
      if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbCircle"   << endl;
-    }
-    (*m_ssEntity) << " 10"       << endl;    // Centre X
-    (*m_ssEntity) << c[0]        << endl;    // X in WCS coordinates
-    (*m_ssEntity) << " 20"       << endl;
-    (*m_ssEntity) << c[1]        << endl;    // Y in WCS coordinates
-    (*m_ssEntity) << " 30"       << endl;
-    (*m_ssEntity) << c[2]        << endl;    // Z in WCS coordinates
-    (*m_ssEntity) << " 40"       << endl;    //
-    (*m_ssEntity) << radius      << endl;    // Radius
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbCircle"   << '\n';
+    }
+    (*m_ssEntity) << " 10"       << '\n';    // Centre X
+    (*m_ssEntity) << c[0]        << '\n';    // X in WCS coordinates
+    (*m_ssEntity) << " 20"       << '\n';
+    (*m_ssEntity) << c[1]        << '\n';    // Y in WCS coordinates
+    (*m_ssEntity) << " 30"       << '\n';
+    (*m_ssEntity) << c[2]        << '\n';    // Z in WCS coordinates
+    (*m_ssEntity) << " 40"       << '\n';    //
+    (*m_ssEntity) << radius      << '\n';    // Radius
 
     if (m_version > 12) {
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbArc" << endl;
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbArc" << '\n';
     }
-    (*m_ssEntity) << " 50"       << endl;
-    (*m_ssEntity) << start_angle << endl;    // Start angle
-    (*m_ssEntity) << " 51"       << endl;
-    (*m_ssEntity) << end_angle   << endl;    // End angle
+    (*m_ssEntity) << " 50"       << '\n';
+    (*m_ssEntity) << start_angle << '\n';    // Start angle
+    (*m_ssEntity) << " 51"       << '\n';
+    (*m_ssEntity) << end_angle   << '\n';    // End angle
 }
 
 void CDxfWrite::writeCircle(const double* c, double radius)
 {
-    (*m_ssEntity) << "  0"       << endl;
-    (*m_ssEntity) << "CIRCLE"    << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"       << '\n';
+    (*m_ssEntity) << "CIRCLE"    << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"       << endl;    // Group code for layer name
-    (*m_ssEntity) << getLayerName()  << endl;    // Layer number
+    (*m_ssEntity) << "  8"       << '\n';    // Group code for layer name
+    (*m_ssEntity) << getLayerName()  << '\n';    // Layer number
      if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbCircle"   << endl;
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbCircle"   << '\n';
     }
-    (*m_ssEntity) << " 10"       << endl;    // Centre X
-    (*m_ssEntity) << c[0]        << endl;    // X in WCS coordinates
-    (*m_ssEntity) << " 20"       << endl;
-    (*m_ssEntity) << c[1]        << endl;    // Y in WCS coordinates
-//    (*m_ssEntity) << " 30"       << endl;
-//    (*m_ssEntity) << c[2]        << endl;    // Z in WCS coordinates
-    (*m_ssEntity) << " 40"       << endl;    //
-    (*m_ssEntity) << radius      << endl;    // Radius
+    (*m_ssEntity) << " 10"       << '\n';    // Centre X
+    (*m_ssEntity) << c[0]        << '\n';    // X in WCS coordinates
+    (*m_ssEntity) << " 20"       << '\n';
+    (*m_ssEntity) << c[1]        << '\n';    // Y in WCS coordinates
+//    (*m_ssEntity) << " 30"       << '\n';
+//    (*m_ssEntity) << c[2]        << '\n';    // Z in WCS coordinates
+    (*m_ssEntity) << " 40"       << '\n';    //
+    (*m_ssEntity) << radius      << '\n';    // Radius
 }
 
 void CDxfWrite::writeEllipse(const double* c, double major_radius, double minor_radius, 
@@ -756,46 +753,46 @@ void CDxfWrite::writeEllipse(const double* c, double major_radius, double minor_
         start_angle = end_angle;
         end_angle = temp;
     }
-    (*m_ssEntity) << "  0"       << endl;
-    (*m_ssEntity) << "ELLIPSE"   << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"       << '\n';
+    (*m_ssEntity) << "ELLIPSE"   << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"       << endl;    // Group code for layer name
-    (*m_ssEntity) << getLayerName()  << endl;    // Layer number
+    (*m_ssEntity) << "  8"       << '\n';    // Group code for layer name
+    (*m_ssEntity) << getLayerName()  << '\n';    // Layer number
      if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbEllipse"   << endl;
-    }
-    (*m_ssEntity) << " 10"       << endl;    // Centre X
-    (*m_ssEntity) << c[0]        << endl;    // X in WCS coordinates
-    (*m_ssEntity) << " 20"       << endl;
-    (*m_ssEntity) << c[1]        << endl;    // Y in WCS coordinates
-    (*m_ssEntity) << " 30"       << endl;
-    (*m_ssEntity) << c[2]        << endl;    // Z in WCS coordinates
-    (*m_ssEntity) << " 11"       << endl;    //
-    (*m_ssEntity) << m[0]        << endl;    // Major X
-    (*m_ssEntity) << " 21"       << endl;
-    (*m_ssEntity) << m[1]        << endl;    // Major Y
-    (*m_ssEntity) << " 31"       << endl;
-    (*m_ssEntity) << m[2]        << endl;    // Major Z
-    (*m_ssEntity) << " 40"       << endl;    //
-    (*m_ssEntity) << ratio       << endl;    // Ratio
-//    (*m_ssEntity) << "210"       << endl;    //extrusion dir??
-//    (*m_ssEntity) << "0"         << endl;
-//    (*m_ssEntity) << "220"       << endl;
-//    (*m_ssEntity) << "0"         << endl;
-//    (*m_ssEntity) << "230"       << endl;
-//    (*m_ssEntity) << "1"         << endl;
-    (*m_ssEntity) << " 41"       << endl;
-    (*m_ssEntity) << start_angle << endl;    // Start angle (radians [0..2pi])
-    (*m_ssEntity) << " 42"       << endl;
-    (*m_ssEntity) << end_angle   << endl;    // End angle
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbEllipse"   << '\n';
+    }
+    (*m_ssEntity) << " 10"       << '\n';    // Centre X
+    (*m_ssEntity) << c[0]        << '\n';    // X in WCS coordinates
+    (*m_ssEntity) << " 20"       << '\n';
+    (*m_ssEntity) << c[1]        << '\n';    // Y in WCS coordinates
+    (*m_ssEntity) << " 30"       << '\n';
+    (*m_ssEntity) << c[2]        << '\n';    // Z in WCS coordinates
+    (*m_ssEntity) << " 11"       << '\n';    //
+    (*m_ssEntity) << m[0]        << '\n';    // Major X
+    (*m_ssEntity) << " 21"       << '\n';
+    (*m_ssEntity) << m[1]        << '\n';    // Major Y
+    (*m_ssEntity) << " 31"       << '\n';
+    (*m_ssEntity) << m[2]        << '\n';    // Major Z
+    (*m_ssEntity) << " 40"       << '\n';    //
+    (*m_ssEntity) << ratio       << '\n';    // Ratio
+//    (*m_ssEntity) << "210"       << '\n';    //extrusion dir??
+//    (*m_ssEntity) << "0"         << '\n';
+//    (*m_ssEntity) << "220"       << '\n';
+//    (*m_ssEntity) << "0"         << '\n';
+//    (*m_ssEntity) << "230"       << '\n';
+//    (*m_ssEntity) << "1"         << '\n';
+    (*m_ssEntity) << " 41"       << '\n';
+    (*m_ssEntity) << start_angle << '\n';    // Start angle (radians [0..2pi])
+    (*m_ssEntity) << " 42"       << '\n';
+    (*m_ssEntity) << end_angle   << '\n';    // End angle
 }
 
 //***************************
@@ -803,78 +800,78 @@ void CDxfWrite::writeEllipse(const double* c, double major_radius, double minor_
 //added by Wandererfan 2018 (wandererfan@gmail.com) for FreeCAD project
 void CDxfWrite::writeSpline(const SplineDataOut &sd)
 {
-    (*m_ssEntity) << "  0"          << endl;
-    (*m_ssEntity) << "SPLINE"       << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"          << '\n';
+    (*m_ssEntity) << "SPLINE"       << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"          << endl;    // Group code for layer name
-    (*m_ssEntity) << getLayerName()     << endl;    // Layer name
+    (*m_ssEntity) << "  8"          << '\n';    // Group code for layer name
+    (*m_ssEntity) << getLayerName()     << '\n';    // Layer name
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbSpline"   << endl;
-    }
-    (*m_ssEntity) << "210"          << endl;
-    (*m_ssEntity) << "0"            << endl;
-    (*m_ssEntity) << "220"          << endl;
-    (*m_ssEntity) << "0"            << endl;
-    (*m_ssEntity) << "230"          << endl;
-    (*m_ssEntity) << "1"            << endl;
-
-    (*m_ssEntity) << " 70"          << endl;
-    (*m_ssEntity) << sd.flag        << endl;      //flags
-    (*m_ssEntity) << " 71"          << endl; 
-    (*m_ssEntity) << sd.degree      << endl;
-    (*m_ssEntity) << " 72"          << endl;
-    (*m_ssEntity) << sd.knots       << endl;
-    (*m_ssEntity) << " 73"          << endl;
-    (*m_ssEntity) << sd.control_points   << endl;
-    (*m_ssEntity) << " 74"          << endl; 
-    (*m_ssEntity) << 0              << endl;
-
-//    (*m_ssEntity) << " 12"          << endl;
-//    (*m_ssEntity) << sd.starttan.x  << endl;
-//    (*m_ssEntity) << " 22"          << endl;
-//    (*m_ssEntity) << sd.starttan.y  << endl;
-//    (*m_ssEntity) << " 32"          << endl;
-//    (*m_ssEntity) << sd.starttan.z  << endl;
-//    (*m_ssEntity) << " 13"          << endl;
-//    (*m_ssEntity) << sd.endtan.x    << endl;
-//    (*m_ssEntity) << " 23"          << endl;
-//    (*m_ssEntity) << sd.endtan.y    << endl;
-//    (*m_ssEntity) << " 33"          << endl;
-//    (*m_ssEntity) << sd.endtan.z    << endl;
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbSpline"   << '\n';
+    }
+    (*m_ssEntity) << "210"          << '\n';
+    (*m_ssEntity) << "0"            << '\n';
+    (*m_ssEntity) << "220"          << '\n';
+    (*m_ssEntity) << "0"            << '\n';
+    (*m_ssEntity) << "230"          << '\n';
+    (*m_ssEntity) << "1"            << '\n';
+
+    (*m_ssEntity) << " 70"          << '\n';
+    (*m_ssEntity) << sd.flag        << '\n';      //flags
+    (*m_ssEntity) << " 71"          << '\n'; 
+    (*m_ssEntity) << sd.degree      << '\n';
+    (*m_ssEntity) << " 72"          << '\n';
+    (*m_ssEntity) << sd.knots       << '\n';
+    (*m_ssEntity) << " 73"          << '\n';
+    (*m_ssEntity) << sd.control_points   << '\n';
+    (*m_ssEntity) << " 74"          << '\n'; 
+    (*m_ssEntity) << 0              << '\n';
+
+//    (*m_ssEntity) << " 12"          << '\n';
+//    (*m_ssEntity) << sd.starttan.x  << '\n';
+//    (*m_ssEntity) << " 22"          << '\n';
+//    (*m_ssEntity) << sd.starttan.y  << '\n';
+//    (*m_ssEntity) << " 32"          << '\n';
+//    (*m_ssEntity) << sd.starttan.z  << '\n';
+//    (*m_ssEntity) << " 13"          << '\n';
+//    (*m_ssEntity) << sd.endtan.x    << '\n';
+//    (*m_ssEntity) << " 23"          << '\n';
+//    (*m_ssEntity) << sd.endtan.y    << '\n';
+//    (*m_ssEntity) << " 33"          << '\n';
+//    (*m_ssEntity) << sd.endtan.z    << '\n';
 
     for (auto& k: sd.knot) {
-        (*m_ssEntity) << " 40"      << endl;  
-        (*m_ssEntity) << k          << endl;  
+        (*m_ssEntity) << " 40"      << '\n';  
+        (*m_ssEntity) << k          << '\n';  
     }
 
     for (auto& w : sd.weight) {
-        (*m_ssEntity) << " 41"      << endl;  
-        (*m_ssEntity) << w          << endl;  
+        (*m_ssEntity) << " 41"      << '\n';  
+        (*m_ssEntity) << w          << '\n';  
     }
 
     for (auto& c: sd.control) {
-        (*m_ssEntity) << " 10"      << endl;
-        (*m_ssEntity) << c.x        << endl;    // X in WCS coordinates
-        (*m_ssEntity) << " 20"      << endl;
-        (*m_ssEntity) << c.y        << endl;    // Y in WCS coordinates
-        (*m_ssEntity) << " 30"      << endl;
-        (*m_ssEntity) << c.z        << endl;    // Z in WCS coordinates
+        (*m_ssEntity) << " 10"      << '\n';
+        (*m_ssEntity) << c.x        << '\n';    // X in WCS coordinates
+        (*m_ssEntity) << " 20"      << '\n';
+        (*m_ssEntity) << c.y        << '\n';    // Y in WCS coordinates
+        (*m_ssEntity) << " 30"      << '\n';
+        (*m_ssEntity) << c.z        << '\n';    // Z in WCS coordinates
     }
     for (auto& f: sd.fit) {
-        (*m_ssEntity) << " 11"      << endl;
-        (*m_ssEntity) << f.x        << endl;    // X in WCS coordinates
-        (*m_ssEntity) << " 21"      << endl;
-        (*m_ssEntity) << f.y        << endl;    // Y in WCS coordinates
-        (*m_ssEntity) << " 31"      << endl;
-        (*m_ssEntity) << f.z        << endl;    // Z in WCS coordinates
+        (*m_ssEntity) << " 11"      << '\n';
+        (*m_ssEntity) << f.x        << '\n';    // X in WCS coordinates
+        (*m_ssEntity) << " 21"      << '\n';
+        (*m_ssEntity) << f.y        << '\n';    // Y in WCS coordinates
+        (*m_ssEntity) << " 31"      << '\n';
+        (*m_ssEntity) << f.z        << '\n';    // Z in WCS coordinates
     }
 }
 
@@ -883,30 +880,30 @@ void CDxfWrite::writeSpline(const SplineDataOut &sd)
 //added by Wandererfan 2018 (wandererfan@gmail.com) for FreeCAD project
 void CDxfWrite::writeVertex(double x, double y, double z)
 {
-    (*m_ssEntity) << "  0"          << endl;
-    (*m_ssEntity) << "VERTEX"       << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"          << '\n';
+    (*m_ssEntity) << "VERTEX"       << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"          << endl;
-    (*m_ssEntity) << getLayerName()     << endl;
+    (*m_ssEntity) << "  8"          << '\n';
+    (*m_ssEntity) << getLayerName()     << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbVertex"   << endl;
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbVertex"   << '\n';
     }
-    (*m_ssEntity) << " 10"          << endl;
-    (*m_ssEntity) << x              << endl;
-    (*m_ssEntity) << " 20"          << endl; 
-    (*m_ssEntity) << y              << endl;
-    (*m_ssEntity) << " 30"          << endl;
-    (*m_ssEntity) << z              << endl;
-    (*m_ssEntity) << " 70"          << endl;
-    (*m_ssEntity) << 0              << endl;
+    (*m_ssEntity) << " 10"          << '\n';
+    (*m_ssEntity) << x              << '\n';
+    (*m_ssEntity) << " 20"          << '\n'; 
+    (*m_ssEntity) << y              << '\n';
+    (*m_ssEntity) << " 30"          << '\n';
+    (*m_ssEntity) << z              << '\n';
+    (*m_ssEntity) << " 70"          << '\n';
+    (*m_ssEntity) << 0              << '\n';
 }
 
 void CDxfWrite::writeText(const char* text, const double* location1, const double* location2,
@@ -927,64 +924,64 @@ void CDxfWrite::putText(const char* text, const Base::Vector3d location1, const
 {
     (void) location2;
 
-    (*outStream) << "  0"          << endl;
-    (*outStream) << "TEXT"         << endl;
-    (*outStream) << "  5"      << endl;
-    (*outStream) << handle << endl;
+    (*outStream) << "  0"          << '\n';
+    (*outStream) << "TEXT"         << '\n';
+    (*outStream) << "  5"      << '\n';
+    (*outStream) << handle << '\n';
     if (m_version > 12) {
-        (*outStream) << "330"      << endl;
-        (*outStream) << ownerHandle  << endl;
-        (*outStream) << "100"      << endl;
-        (*outStream) << "AcDbEntity"      << endl;
+        (*outStream) << "330"      << '\n';
+        (*outStream) << ownerHandle  << '\n';
+        (*outStream) << "100"      << '\n';
+        (*outStream) << "AcDbEntity"      << '\n';
     }
-    (*outStream) << "  8"          << endl;
-    (*outStream) << getLayerName()     << endl;
+    (*outStream) << "  8"          << '\n';
+    (*outStream) << getLayerName()     << '\n';
     if (m_version > 12) {
-        (*outStream) << "100"          << endl;
-        (*outStream) << "AcDbText"     << endl;
-    }
-//    (*outStream) << " 39"          << endl;
-//    (*outStream) << 0              << endl;     //thickness
-    (*outStream) << " 10"          << endl;     //first alignment point
-    (*outStream) << location1.x    << endl;
-    (*outStream) << " 20"          << endl; 
-    (*outStream) << location1.y    << endl;
-    (*outStream) << " 30"          << endl;
-    (*outStream) << location1.z    << endl;
-    (*outStream) << " 40"          << endl;
-    (*outStream) << height         << endl;
-    (*outStream) << "  1"          << endl;
-    (*outStream) << text           << endl;
-//    (*outStream) << " 50"          << endl;
-//    (*outStream) << 0              << endl;    //rotation
-//    (*outStream) << " 41"          << endl;
-//    (*outStream) << 1              << endl;
-//    (*outStream) << " 51"          << endl;
-//    (*outStream) << 0              << endl;
-
-    (*outStream) << "  7"          << endl;
-    (*outStream) << "STANDARD"     << endl;    //style
-//    (*outStream) << " 71"          << endl;  //default
-//    (*outStream) << "0"            << endl;
-    (*outStream) << " 72"          << endl;
-    (*outStream) << horizJust      << endl;
-////    (*outStream) << " 73"          << endl;
-////    (*outStream) << "0"            << endl;
-    (*outStream) << " 11"          << endl;    //second alignment point
-    (*outStream) << location2.x    << endl;
-    (*outStream) << " 21"          << endl; 
-    (*outStream) << location2.y    << endl;
-    (*outStream) << " 31"          << endl;
-    (*outStream) << location2.z    << endl;
-//    (*outStream) << "210"          << endl;
-//    (*outStream) << "0"            << endl;
-//    (*outStream) << "220"          << endl;
-//    (*outStream) << "0"            << endl;
-//    (*outStream) << "230"          << endl;
-//    (*outStream) << "1"            << endl;
+        (*outStream) << "100"          << '\n';
+        (*outStream) << "AcDbText"     << '\n';
+    }
+//    (*outStream) << " 39"          << '\n';
+//    (*outStream) << 0              << '\n';     //thickness
+    (*outStream) << " 10"          << '\n';     //first alignment point
+    (*outStream) << location1.x    << '\n';
+    (*outStream) << " 20"          << '\n'; 
+    (*outStream) << location1.y    << '\n';
+    (*outStream) << " 30"          << '\n';
+    (*outStream) << location1.z    << '\n';
+    (*outStream) << " 40"          << '\n';
+    (*outStream) << height         << '\n';
+    (*outStream) << "  1"          << '\n';
+    (*outStream) << text           << '\n';
+//    (*outStream) << " 50"          << '\n';
+//    (*outStream) << 0              << '\n';    //rotation
+//    (*outStream) << " 41"          << '\n';
+//    (*outStream) << 1              << '\n';
+//    (*outStream) << " 51"          << '\n';
+//    (*outStream) << 0              << '\n';
+
+    (*outStream) << "  7"          << '\n';
+    (*outStream) << "STANDARD"     << '\n';    //style
+//    (*outStream) << " 71"          << '\n';  //default
+//    (*outStream) << "0"            << '\n';
+    (*outStream) << " 72"          << '\n';
+    (*outStream) << horizJust      << '\n';
+////    (*outStream) << " 73"          << '\n';
+////    (*outStream) << "0"            << '\n';
+    (*outStream) << " 11"          << '\n';    //second alignment point
+    (*outStream) << location2.x    << '\n';
+    (*outStream) << " 21"          << '\n'; 
+    (*outStream) << location2.y    << '\n';
+    (*outStream) << " 31"          << '\n';
+    (*outStream) << location2.z    << '\n';
+//    (*outStream) << "210"          << '\n';
+//    (*outStream) << "0"            << '\n';
+//    (*outStream) << "220"          << '\n';
+//    (*outStream) << "0"            << '\n';
+//    (*outStream) << "230"          << '\n';
+//    (*outStream) << "1"            << '\n';
     if (m_version > 12) {
-        (*outStream) << "100"          << endl;
-        (*outStream) << "AcDbText"     << endl;
+        (*outStream) << "100"          << '\n';
+        (*outStream) << "AcDbText"     << '\n';
     }
     
 }
@@ -993,48 +990,48 @@ void CDxfWrite::putArrow(Base::Vector3d arrowPos, Base::Vector3d barb1Pos, Base:
                          std::ostringstream* outStream, const std::string handle,
                          const std::string ownerHandle)
 {
-    (*outStream) << "  0"          << endl;
-    (*outStream) << "SOLID"        << endl;
-    (*outStream) << "  5"          << endl;
-    (*outStream) << handle         << endl;
+    (*outStream) << "  0"          << '\n';
+    (*outStream) << "SOLID"        << '\n';
+    (*outStream) << "  5"          << '\n';
+    (*outStream) << handle         << '\n';
     if (m_version > 12) {
-        (*outStream) << "330"      << endl;
-        (*outStream) << ownerHandle << endl;
-        (*outStream) << "100"      << endl;
-        (*outStream) << "AcDbEntity"      << endl;
-    }
-    (*outStream) << "  8"          << endl;
-    (*outStream) << "0"            << endl;
-    (*outStream) << " 62"          << endl;
-    (*outStream) << "     0"       << endl;
+        (*outStream) << "330"      << '\n';
+        (*outStream) << ownerHandle << '\n';
+        (*outStream) << "100"      << '\n';
+        (*outStream) << "AcDbEntity"      << '\n';
+    }
+    (*outStream) << "  8"          << '\n';
+    (*outStream) << "0"            << '\n';
+    (*outStream) << " 62"          << '\n';
+    (*outStream) << "     0"       << '\n';
     if (m_version > 12) {
-        (*outStream) << "100"      << endl;
-        (*outStream) << "AcDbTrace" << endl;
-    }
-    (*outStream) << " 10"          << endl;
-    (*outStream) << barb1Pos.x     << endl;
-    (*outStream) << " 20"          << endl;
-    (*outStream) << barb1Pos.y     << endl;
-    (*outStream) << " 30"          << endl;
-    (*outStream) << barb1Pos.z     << endl;
-    (*outStream) << " 11"          << endl;
-    (*outStream) << barb2Pos.x     << endl;
-    (*outStream) << " 21"          << endl;
-    (*outStream) << barb2Pos.y     << endl;
-    (*outStream) << " 31"          << endl;
-    (*outStream) << barb2Pos.z     << endl;
-    (*outStream) << " 12"          << endl;
-    (*outStream) << arrowPos.x     << endl;
-    (*outStream) << " 22"          << endl;
-    (*outStream) << arrowPos.y     << endl;
-    (*outStream) << " 32"          << endl;
-    (*outStream) << arrowPos.z     << endl;
-    (*outStream) << " 13"          << endl;
-    (*outStream) << arrowPos.x     << endl;
-    (*outStream) << " 23"          << endl;
-    (*outStream) << arrowPos.y     << endl;
-    (*outStream) << " 33"          << endl;
-    (*outStream) << arrowPos.z     << endl;
+        (*outStream) << "100"      << '\n';
+        (*outStream) << "AcDbTrace" << '\n';
+    }
+    (*outStream) << " 10"          << '\n';
+    (*outStream) << barb1Pos.x     << '\n';
+    (*outStream) << " 20"          << '\n';
+    (*outStream) << barb1Pos.y     << '\n';
+    (*outStream) << " 30"          << '\n';
+    (*outStream) << barb1Pos.z     << '\n';
+    (*outStream) << " 11"          << '\n';
+    (*outStream) << barb2Pos.x     << '\n';
+    (*outStream) << " 21"          << '\n';
+    (*outStream) << barb2Pos.y     << '\n';
+    (*outStream) << " 31"          << '\n';
+    (*outStream) << barb2Pos.z     << '\n';
+    (*outStream) << " 12"          << '\n';
+    (*outStream) << arrowPos.x     << '\n';
+    (*outStream) << " 22"          << '\n';
+    (*outStream) << arrowPos.y     << '\n';
+    (*outStream) << " 32"          << '\n';
+    (*outStream) << arrowPos.z     << '\n';
+    (*outStream) << " 13"          << '\n';
+    (*outStream) << arrowPos.x     << '\n';
+    (*outStream) << " 23"          << '\n';
+    (*outStream) << arrowPos.y     << '\n';
+    (*outStream) << " 33"          << '\n';
+    (*outStream) << arrowPos.z     << '\n';
 }
 
 //***************************
@@ -1044,61 +1041,61 @@ void CDxfWrite::writeLinearDim(const double* textMidPoint, const double* lineDef
                          const double* extLine1, const double* extLine2,
                          const char* dimText)
 {
-    (*m_ssEntity) << "  0"          << endl;
-    (*m_ssEntity) << "DIMENSION"    << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"          << '\n';
+    (*m_ssEntity) << "DIMENSION"    << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"          << endl;
-    (*m_ssEntity) << getLayerName()     << endl;
+    (*m_ssEntity) << "  8"          << '\n';
+    (*m_ssEntity) << getLayerName()     << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbDimension"     << endl;
-    }
-    (*m_ssEntity) << "  2"          << endl;
-    (*m_ssEntity) << "*" << getLayerName()     << endl;     // blockName
-    (*m_ssEntity) << " 10"          << endl;     //dimension line definition point
-    (*m_ssEntity) << lineDefPoint[0]    << endl;
-    (*m_ssEntity) << " 20"          << endl; 
-    (*m_ssEntity) << lineDefPoint[1]    << endl;
-    (*m_ssEntity) << " 30"          << endl;
-    (*m_ssEntity) << lineDefPoint[2]    << endl;
-    (*m_ssEntity) << " 11"          << endl;     //text mid point
-    (*m_ssEntity) << textMidPoint[0]    << endl;
-    (*m_ssEntity) << " 21"          << endl; 
-    (*m_ssEntity) << textMidPoint[1]    << endl;
-    (*m_ssEntity) << " 31"          << endl;
-    (*m_ssEntity) << textMidPoint[2]    << endl;
-    (*m_ssEntity) << " 70"          << endl;
-    (*m_ssEntity) << 1              << endl;    // dimType1 = Aligned
-//    (*m_ssEntity) << " 71"          << endl;    // not R12
-//    (*m_ssEntity) << 1              << endl;    // attachPoint ??1 = topleft
-    (*m_ssEntity) << "  1"          << endl;
-    (*m_ssEntity) << dimText        << endl;    
-    (*m_ssEntity) << "  3"          << endl;
-    (*m_ssEntity) << "STANDARD"     << endl;    //style
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbDimension"     << '\n';
+    }
+    (*m_ssEntity) << "  2"          << '\n';
+    (*m_ssEntity) << "*" << getLayerName()     << '\n';     // blockName
+    (*m_ssEntity) << " 10"          << '\n';     //dimension line definition point
+    (*m_ssEntity) << lineDefPoint[0]    << '\n';
+    (*m_ssEntity) << " 20"          << '\n'; 
+    (*m_ssEntity) << lineDefPoint[1]    << '\n';
+    (*m_ssEntity) << " 30"          << '\n';
+    (*m_ssEntity) << lineDefPoint[2]    << '\n';
+    (*m_ssEntity) << " 11"          << '\n';     //text mid point
+    (*m_ssEntity) << textMidPoint[0]    << '\n';
+    (*m_ssEntity) << " 21"          << '\n'; 
+    (*m_ssEntity) << textMidPoint[1]    << '\n';
+    (*m_ssEntity) << " 31"          << '\n';
+    (*m_ssEntity) << textMidPoint[2]    << '\n';
+    (*m_ssEntity) << " 70"          << '\n';
+    (*m_ssEntity) << 1              << '\n';    // dimType1 = Aligned
+//    (*m_ssEntity) << " 71"          << '\n';    // not R12
+//    (*m_ssEntity) << 1              << '\n';    // attachPoint ??1 = topleft
+    (*m_ssEntity) << "  1"          << '\n';
+    (*m_ssEntity) << dimText        << '\n';    
+    (*m_ssEntity) << "  3"          << '\n';
+    (*m_ssEntity) << "STANDARD"     << '\n';    //style
 //linear dims
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbAlignedDimension"     << endl;
-    }
-    (*m_ssEntity) << " 13"          << endl;
-    (*m_ssEntity) << extLine1[0]    << endl;
-    (*m_ssEntity) << " 23"          << endl; 
-    (*m_ssEntity) << extLine1[1]    << endl;
-    (*m_ssEntity) << " 33"          << endl;
-    (*m_ssEntity) << extLine1[2]    << endl;
-    (*m_ssEntity) << " 14"          << endl;
-    (*m_ssEntity) << extLine2[0]    << endl;
-    (*m_ssEntity) << " 24"          << endl; 
-    (*m_ssEntity) << extLine2[1]    << endl;
-    (*m_ssEntity) << " 34"          << endl;
-    (*m_ssEntity) << extLine2[2]    << endl;
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbAlignedDimension"     << '\n';
+    }
+    (*m_ssEntity) << " 13"          << '\n';
+    (*m_ssEntity) << extLine1[0]    << '\n';
+    (*m_ssEntity) << " 23"          << '\n'; 
+    (*m_ssEntity) << extLine1[1]    << '\n';
+    (*m_ssEntity) << " 33"          << '\n';
+    (*m_ssEntity) << extLine1[2]    << '\n';
+    (*m_ssEntity) << " 14"          << '\n';
+    (*m_ssEntity) << extLine2[0]    << '\n';
+    (*m_ssEntity) << " 24"          << '\n'; 
+    (*m_ssEntity) << extLine2[1]    << '\n';
+    (*m_ssEntity) << " 34"          << '\n';
+    (*m_ssEntity) << extLine2[2]    << '\n';
 
     writeDimBlockPreamble();
     writeLinearDimBlock(textMidPoint,lineDefPoint,
@@ -1115,80 +1112,80 @@ void CDxfWrite::writeAngularDim(const double* textMidPoint, const double* lineDe
                          const double* startExt2, const double* endExt2,
                          const char* dimText)
 {
-    (*m_ssEntity) << "  0"          << endl;
-    (*m_ssEntity) << "DIMENSION"    << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"          << '\n';
+    (*m_ssEntity) << "DIMENSION"    << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"          << endl;
-    (*m_ssEntity) << getLayerName()     << endl;
+    (*m_ssEntity) << "  8"          << '\n';
+    (*m_ssEntity) << getLayerName()     << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbDimension"     << endl;
-    }
-    (*m_ssEntity) << "  2"          << endl;
-    (*m_ssEntity) << "*" << getLayerName()     << endl;     // blockName
-
-    (*m_ssEntity) << " 10"          << endl;
-    (*m_ssEntity) << endExt2[0]     << endl;
-    (*m_ssEntity) << " 20"          << endl; 
-    (*m_ssEntity) << endExt2[1]     << endl;
-    (*m_ssEntity) << " 30"          << endl;
-    (*m_ssEntity) << endExt2[2]     << endl;
-
-    (*m_ssEntity) << " 11"          << endl;
-    (*m_ssEntity) << textMidPoint[0]  << endl;
-    (*m_ssEntity) << " 21"          << endl; 
-    (*m_ssEntity) << textMidPoint[1]  << endl;
-    (*m_ssEntity) << " 31"          << endl;
-    (*m_ssEntity) << textMidPoint[2]  << endl;
-
-    (*m_ssEntity) << " 70"          << endl;
-    (*m_ssEntity) << 2             << endl;    // dimType 2 = Angular  5 = Angular 3 point
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbDimension"     << '\n';
+    }
+    (*m_ssEntity) << "  2"          << '\n';
+    (*m_ssEntity) << "*" << getLayerName()     << '\n';     // blockName
+
+    (*m_ssEntity) << " 10"          << '\n';
+    (*m_ssEntity) << endExt2[0]     << '\n';
+    (*m_ssEntity) << " 20"          << '\n'; 
+    (*m_ssEntity) << endExt2[1]     << '\n';
+    (*m_ssEntity) << " 30"          << '\n';
+    (*m_ssEntity) << endExt2[2]     << '\n';
+
+    (*m_ssEntity) << " 11"          << '\n';
+    (*m_ssEntity) << textMidPoint[0]  << '\n';
+    (*m_ssEntity) << " 21"          << '\n'; 
+    (*m_ssEntity) << textMidPoint[1]  << '\n';
+    (*m_ssEntity) << " 31"          << '\n';
+    (*m_ssEntity) << textMidPoint[2]  << '\n';
+
+    (*m_ssEntity) << " 70"          << '\n';
+    (*m_ssEntity) << 2             << '\n';    // dimType 2 = Angular  5 = Angular 3 point
                                            // +32 for block?? (not R12)
-//    (*m_ssEntity) << " 71"          << endl;    // not R12?  not required?
-//    (*m_ssEntity) << 5              << endl;    // attachPoint 5 = middle
-    (*m_ssEntity) << "  1"          << endl;
-    (*m_ssEntity) << dimText        << endl;    
-    (*m_ssEntity) << "  3"          << endl;
-    (*m_ssEntity) << "STANDARD"     << endl;    //style
+//    (*m_ssEntity) << " 71"          << '\n';    // not R12?  not required?
+//    (*m_ssEntity) << 5              << '\n';    // attachPoint 5 = middle
+    (*m_ssEntity) << "  1"          << '\n';
+    (*m_ssEntity) << dimText        << '\n';    
+    (*m_ssEntity) << "  3"          << '\n';
+    (*m_ssEntity) << "STANDARD"     << '\n';    //style
 //angular dims
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDb2LineAngularDimension"     << endl;
-    }
-    (*m_ssEntity) << " 13"           << endl;
-    (*m_ssEntity) << startExt1[0]    << endl;
-    (*m_ssEntity) << " 23"           << endl; 
-    (*m_ssEntity) << startExt1[1]    << endl;
-    (*m_ssEntity) << " 33"           << endl;
-    (*m_ssEntity) << startExt1[2]    << endl;
-
-    (*m_ssEntity) << " 14"           << endl;
-    (*m_ssEntity) << endExt1[0]      << endl;
-    (*m_ssEntity) << " 24"           << endl; 
-    (*m_ssEntity) << endExt1[1]      << endl;
-    (*m_ssEntity) << " 34"           << endl;
-    (*m_ssEntity) << endExt1[2]      << endl;
-
-    (*m_ssEntity) << " 15"           << endl;
-    (*m_ssEntity) << startExt2[0]    << endl;
-    (*m_ssEntity) << " 25"           << endl; 
-    (*m_ssEntity) << startExt2[1]    << endl;
-    (*m_ssEntity) << " 35"           << endl;
-    (*m_ssEntity) << startExt2[2]    << endl;
-
-    (*m_ssEntity) << " 16"           << endl;
-    (*m_ssEntity) << lineDefPoint[0] << endl;
-    (*m_ssEntity) << " 26"           << endl; 
-    (*m_ssEntity) << lineDefPoint[1] << endl;
-    (*m_ssEntity) << " 36"           << endl;
-    (*m_ssEntity) << lineDefPoint[2] << endl;
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDb2LineAngularDimension"     << '\n';
+    }
+    (*m_ssEntity) << " 13"           << '\n';
+    (*m_ssEntity) << startExt1[0]    << '\n';
+    (*m_ssEntity) << " 23"           << '\n'; 
+    (*m_ssEntity) << startExt1[1]    << '\n';
+    (*m_ssEntity) << " 33"           << '\n';
+    (*m_ssEntity) << startExt1[2]    << '\n';
+
+    (*m_ssEntity) << " 14"           << '\n';
+    (*m_ssEntity) << endExt1[0]      << '\n';
+    (*m_ssEntity) << " 24"           << '\n'; 
+    (*m_ssEntity) << endExt1[1]      << '\n';
+    (*m_ssEntity) << " 34"           << '\n';
+    (*m_ssEntity) << endExt1[2]      << '\n';
+
+    (*m_ssEntity) << " 15"           << '\n';
+    (*m_ssEntity) << startExt2[0]    << '\n';
+    (*m_ssEntity) << " 25"           << '\n'; 
+    (*m_ssEntity) << startExt2[1]    << '\n';
+    (*m_ssEntity) << " 35"           << '\n';
+    (*m_ssEntity) << startExt2[2]    << '\n';
+
+    (*m_ssEntity) << " 16"           << '\n';
+    (*m_ssEntity) << lineDefPoint[0] << '\n';
+    (*m_ssEntity) << " 26"           << '\n'; 
+    (*m_ssEntity) << lineDefPoint[1] << '\n';
+    (*m_ssEntity) << " 36"           << '\n';
+    (*m_ssEntity) << lineDefPoint[2] << '\n';
     writeDimBlockPreamble();
     writeAngularDimBlock(textMidPoint, lineDefPoint,
                          startExt1, endExt1,
@@ -1204,57 +1201,57 @@ void CDxfWrite::writeRadialDim(const double* centerPoint, const double* textMidP
                          const double* arcPoint,
                          const char* dimText)
 {
-    (*m_ssEntity) << "  0"          << endl;
-    (*m_ssEntity) << "DIMENSION"    << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"          << '\n';
+    (*m_ssEntity) << "DIMENSION"    << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"          << endl;
-    (*m_ssEntity) << getLayerName()     << endl;
+    (*m_ssEntity) << "  8"          << '\n';
+    (*m_ssEntity) << getLayerName()     << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbDimension"     << endl;
-    }
-    (*m_ssEntity) << "  2"          << endl;
-    (*m_ssEntity) << "*" << getLayerName()     << endl;     // blockName
-    (*m_ssEntity) << " 10"          << endl;     // arc center point
-    (*m_ssEntity) << centerPoint[0] << endl;
-    (*m_ssEntity) << " 20"          << endl; 
-    (*m_ssEntity) << centerPoint[1] << endl;
-    (*m_ssEntity) << " 30"          << endl;
-    (*m_ssEntity) << centerPoint[2] << endl;
-    (*m_ssEntity) << " 11"          << endl;     //text mid point
-    (*m_ssEntity) << textMidPoint[0]   << endl;
-    (*m_ssEntity) << " 21"          << endl; 
-    (*m_ssEntity) << textMidPoint[1]   << endl;
-    (*m_ssEntity) << " 31"          << endl;
-    (*m_ssEntity) << textMidPoint[2]   << endl;
-    (*m_ssEntity) << " 70"          << endl;
-    (*m_ssEntity) << 4              << endl;    // dimType 4 = Radius
-//    (*m_ssEntity) << " 71"          << endl;    // not R12
-//    (*m_ssEntity) << 1              << endl;    // attachPoint 5 = middle center
-    (*m_ssEntity) << "  1"          << endl;
-    (*m_ssEntity) << dimText        << endl;    
-    (*m_ssEntity) << "  3"          << endl;
-    (*m_ssEntity) << "STANDARD"     << endl;    //style
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbDimension"     << '\n';
+    }
+    (*m_ssEntity) << "  2"          << '\n';
+    (*m_ssEntity) << "*" << getLayerName()     << '\n';     // blockName
+    (*m_ssEntity) << " 10"          << '\n';     // arc center point
+    (*m_ssEntity) << centerPoint[0] << '\n';
+    (*m_ssEntity) << " 20"          << '\n'; 
+    (*m_ssEntity) << centerPoint[1] << '\n';
+    (*m_ssEntity) << " 30"          << '\n';
+    (*m_ssEntity) << centerPoint[2] << '\n';
+    (*m_ssEntity) << " 11"          << '\n';     //text mid point
+    (*m_ssEntity) << textMidPoint[0]   << '\n';
+    (*m_ssEntity) << " 21"          << '\n'; 
+    (*m_ssEntity) << textMidPoint[1]   << '\n';
+    (*m_ssEntity) << " 31"          << '\n';
+    (*m_ssEntity) << textMidPoint[2]   << '\n';
+    (*m_ssEntity) << " 70"          << '\n';
+    (*m_ssEntity) << 4              << '\n';    // dimType 4 = Radius
+//    (*m_ssEntity) << " 71"          << '\n';    // not R12
+//    (*m_ssEntity) << 1              << '\n';    // attachPoint 5 = middle center
+    (*m_ssEntity) << "  1"          << '\n';
+    (*m_ssEntity) << dimText        << '\n';    
+    (*m_ssEntity) << "  3"          << '\n';
+    (*m_ssEntity) << "STANDARD"     << '\n';    //style
 //radial dims
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbRadialDimension"     << endl;
-    }
-    (*m_ssEntity) << " 15"          << endl;
-    (*m_ssEntity) << arcPoint[0]    << endl;
-    (*m_ssEntity) << " 25"          << endl; 
-    (*m_ssEntity) << arcPoint[1]    << endl;
-    (*m_ssEntity) << " 35"          << endl;
-    (*m_ssEntity) << arcPoint[2]    << endl;
-    (*m_ssEntity) << " 40"          << endl;   // leader length????
-    (*m_ssEntity) << 0              << endl;
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbRadialDimension"     << '\n';
+    }
+    (*m_ssEntity) << " 15"          << '\n';
+    (*m_ssEntity) << arcPoint[0]    << '\n';
+    (*m_ssEntity) << " 25"          << '\n'; 
+    (*m_ssEntity) << arcPoint[1]    << '\n';
+    (*m_ssEntity) << " 35"          << '\n';
+    (*m_ssEntity) << arcPoint[2]    << '\n';
+    (*m_ssEntity) << " 40"          << '\n';   // leader length????
+    (*m_ssEntity) << 0              << '\n';
 
     writeDimBlockPreamble();
     writeRadialDimBlock(centerPoint, textMidPoint, arcPoint, dimText);
@@ -1268,57 +1265,57 @@ void CDxfWrite::writeDiametricDim(const double* textMidPoint,
                          const double* arcPoint1, const double* arcPoint2,
                          const char* dimText)
 {
-    (*m_ssEntity) << "  0"          << endl;
-    (*m_ssEntity) << "DIMENSION"    << endl;
-    (*m_ssEntity) << "  5"      << endl;
-    (*m_ssEntity) << getEntityHandle() << endl;
+    (*m_ssEntity) << "  0"          << '\n';
+    (*m_ssEntity) << "DIMENSION"    << '\n';
+    (*m_ssEntity) << "  5"      << '\n';
+    (*m_ssEntity) << getEntityHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "330"      << endl;
-        (*m_ssEntity) << m_saveModelSpaceHandle  << endl;
-        (*m_ssEntity) << "100"      << endl;
-        (*m_ssEntity) << "AcDbEntity"      << endl;
+        (*m_ssEntity) << "330"      << '\n';
+        (*m_ssEntity) << m_saveModelSpaceHandle  << '\n';
+        (*m_ssEntity) << "100"      << '\n';
+        (*m_ssEntity) << "AcDbEntity"      << '\n';
     }
-    (*m_ssEntity) << "  8"          << endl;
-    (*m_ssEntity) << getLayerName()     << endl;
+    (*m_ssEntity) << "  8"          << '\n';
+    (*m_ssEntity) << getLayerName()     << '\n';
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbDimension"     << endl;
-    }
-    (*m_ssEntity) << "  2"          << endl;
-    (*m_ssEntity) << "*" << getLayerName()     << endl;     // blockName
-    (*m_ssEntity) << " 10"          << endl;
-    (*m_ssEntity) << arcPoint1[0]   << endl;
-    (*m_ssEntity) << " 20"          << endl; 
-    (*m_ssEntity) << arcPoint1[1]   << endl;
-    (*m_ssEntity) << " 30"          << endl;
-    (*m_ssEntity) << arcPoint1[2]   << endl;
-    (*m_ssEntity) << " 11"          << endl;     //text mid point
-    (*m_ssEntity) << textMidPoint[0]   << endl;
-    (*m_ssEntity) << " 21"          << endl; 
-    (*m_ssEntity) << textMidPoint[1]   << endl;
-    (*m_ssEntity) << " 31"          << endl;
-    (*m_ssEntity) << textMidPoint[2]   << endl;
-    (*m_ssEntity) << " 70"          << endl;
-    (*m_ssEntity) << 3              << endl;    // dimType 3 = Diameter
-//    (*m_ssEntity) << " 71"          << endl;    // not R12
-//    (*m_ssEntity) << 5              << endl;    // attachPoint 5 = middle center
-    (*m_ssEntity) << "  1"          << endl;
-    (*m_ssEntity) << dimText        << endl;    
-    (*m_ssEntity) << "  3"          << endl;
-    (*m_ssEntity) << "STANDARD"     << endl;    //style
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbDimension"     << '\n';
+    }
+    (*m_ssEntity) << "  2"          << '\n';
+    (*m_ssEntity) << "*" << getLayerName()     << '\n';     // blockName
+    (*m_ssEntity) << " 10"          << '\n';
+    (*m_ssEntity) << arcPoint1[0]   << '\n';
+    (*m_ssEntity) << " 20"          << '\n'; 
+    (*m_ssEntity) << arcPoint1[1]   << '\n';
+    (*m_ssEntity) << " 30"          << '\n';
+    (*m_ssEntity) << arcPoint1[2]   << '\n';
+    (*m_ssEntity) << " 11"          << '\n';     //text mid point
+    (*m_ssEntity) << textMidPoint[0]   << '\n';
+    (*m_ssEntity) << " 21"          << '\n'; 
+    (*m_ssEntity) << textMidPoint[1]   << '\n';
+    (*m_ssEntity) << " 31"          << '\n';
+    (*m_ssEntity) << textMidPoint[2]   << '\n';
+    (*m_ssEntity) << " 70"          << '\n';
+    (*m_ssEntity) << 3              << '\n';    // dimType 3 = Diameter
+//    (*m_ssEntity) << " 71"          << '\n';    // not R12
+//    (*m_ssEntity) << 5              << '\n';    // attachPoint 5 = middle center
+    (*m_ssEntity) << "  1"          << '\n';
+    (*m_ssEntity) << dimText        << '\n';    
+    (*m_ssEntity) << "  3"          << '\n';
+    (*m_ssEntity) << "STANDARD"     << '\n';    //style
 //diametric dims
     if (m_version > 12) {
-        (*m_ssEntity) << "100"          << endl;
-        (*m_ssEntity) << "AcDbDiametricDimension"     << endl;
-    }
-    (*m_ssEntity) << " 15"          << endl;
-    (*m_ssEntity) << arcPoint2[0]   << endl;
-    (*m_ssEntity) << " 25"          << endl; 
-    (*m_ssEntity) << arcPoint2[1]   << endl;
-    (*m_ssEntity) << " 35"          << endl;
-    (*m_ssEntity) << arcPoint2[2]   << endl;
-    (*m_ssEntity) << " 40"          << endl;   // leader length????
-    (*m_ssEntity) << 0              << endl;
+        (*m_ssEntity) << "100"          << '\n';
+        (*m_ssEntity) << "AcDbDiametricDimension"     << '\n';
+    }
+    (*m_ssEntity) << " 15"          << '\n';
+    (*m_ssEntity) << arcPoint2[0]   << '\n';
+    (*m_ssEntity) << " 25"          << '\n'; 
+    (*m_ssEntity) << arcPoint2[1]   << '\n';
+    (*m_ssEntity) << " 35"          << '\n';
+    (*m_ssEntity) << arcPoint2[2]   << '\n';
+    (*m_ssEntity) << " 40"          << '\n';   // leader length????
+    (*m_ssEntity) << 0              << '\n';
 
     writeDimBlockPreamble();
     writeDiametricDimBlock(textMidPoint, arcPoint1, arcPoint2, dimText);
@@ -1338,36 +1335,36 @@ void CDxfWrite::writeDimBlockPreamble(void)
     }
 
     m_currentBlock = getBlockHandle();
-    (*m_ssBlock) << "  0"          << endl;
-    (*m_ssBlock) << "BLOCK"        << endl;
-    (*m_ssBlock) << "  5"      << endl;
-    (*m_ssBlock) << m_currentBlock << endl;
+    (*m_ssBlock) << "  0"          << '\n';
+    (*m_ssBlock) << "BLOCK"        << '\n';
+    (*m_ssBlock) << "  5"      << '\n';
+    (*m_ssBlock) << m_currentBlock << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "330"      << endl;
-        (*m_ssBlock) << m_saveBlkRecordHandle << endl;
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbEntity"      << endl;
+        (*m_ssBlock) << "330"      << '\n';
+        (*m_ssBlock) << m_saveBlkRecordHandle << '\n';
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbEntity"      << '\n';
     }
-    (*m_ssBlock) << "  8"          << endl;
-    (*m_ssBlock) << getLayerName() << endl;
+    (*m_ssBlock) << "  8"          << '\n';
+    (*m_ssBlock) << getLayerName() << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "100"          << endl;
-        (*m_ssBlock) << "AcDbBlockBegin"  << endl;
-    }
-    (*m_ssBlock) << "  2"          << endl;
-    (*m_ssBlock) << "*" << getLayerName()     << endl;     // blockName
-    (*m_ssBlock) << " 70"          << endl;
-    (*m_ssBlock) << "   1"         << endl;
-    (*m_ssBlock) << " 10"          << endl;
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << " 20"          << endl; 
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << " 30"          << endl;
-    (*m_ssBlock) << 0.0            << endl;
-    (*m_ssBlock) << "  3"          << endl;
-    (*m_ssBlock) << "*" << getLayerName()     << endl;     // blockName
-    (*m_ssBlock) << "  1"          << endl;
-    (*m_ssBlock) << " "            << endl;
+        (*m_ssBlock) << "100"          << '\n';
+        (*m_ssBlock) << "AcDbBlockBegin"  << '\n';
+    }
+    (*m_ssBlock) << "  2"          << '\n';
+    (*m_ssBlock) << "*" << getLayerName()     << '\n';     // blockName
+    (*m_ssBlock) << " 70"          << '\n';
+    (*m_ssBlock) << "   1"         << '\n';
+    (*m_ssBlock) << " 10"          << '\n';
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << " 20"          << '\n'; 
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << " 30"          << '\n';
+    (*m_ssBlock) << 0.0            << '\n';
+    (*m_ssBlock) << "  3"          << '\n';
+    (*m_ssBlock) << "*" << getLayerName()     << '\n';     // blockName
+    (*m_ssBlock) << "  1"          << '\n';
+    (*m_ssBlock) << " "            << '\n';
 }
 
 //***************************
@@ -1375,23 +1372,23 @@ void CDxfWrite::writeDimBlockPreamble(void)
 //added by Wandererfan 2018 (wandererfan@gmail.com) for FreeCAD project
 void CDxfWrite::writeBlockTrailer(void)
 {
-    (*m_ssBlock) << "  0"    << endl;
-    (*m_ssBlock) << "ENDBLK" << endl;
-    (*m_ssBlock) << "  5"      << endl;
-    (*m_ssBlock) << getBlockHandle() << endl;
+    (*m_ssBlock) << "  0"    << '\n';
+    (*m_ssBlock) << "ENDBLK" << '\n';
+    (*m_ssBlock) << "  5"      << '\n';
+    (*m_ssBlock) << getBlockHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "330"    << endl;
-        (*m_ssBlock) << m_saveBlkRecordHandle    << endl;
-        (*m_ssBlock) << "100"    << endl;
-        (*m_ssBlock) << "AcDbEntity"    << endl;
-    }
-//    (*m_ssBlock) << " 67"    << endl;
-//    (*m_ssBlock) << "1"    << endl;
-    (*m_ssBlock) << "  8"    << endl;
-    (*m_ssBlock) << getLayerName() << endl;
+        (*m_ssBlock) << "330"    << '\n';
+        (*m_ssBlock) << m_saveBlkRecordHandle    << '\n';
+        (*m_ssBlock) << "100"    << '\n';
+        (*m_ssBlock) << "AcDbEntity"    << '\n';
+    }
+//    (*m_ssBlock) << " 67"    << '\n';
+//    (*m_ssBlock) << "1"    << '\n';
+    (*m_ssBlock) << "  8"    << '\n';
+    (*m_ssBlock) << getLayerName() << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "100"    << endl;
-        (*m_ssBlock) << "AcDbBlockEnd"    << endl;
+        (*m_ssBlock) << "100"    << '\n';
+        (*m_ssBlock) << "AcDbBlockEnd"    << '\n';
     }
 }
 
@@ -1479,40 +1476,40 @@ void CDxfWrite::writeAngularDimBlock(const double* textMidPoint, const double* l
     Base::Vector3d linePt(lineDefPoint[0],lineDefPoint[1],lineDefPoint[2]);
     double radius = (e2S - linePt).Length();
 
-    (*m_ssBlock) << "  0"          << endl;
-    (*m_ssBlock) << "ARC"          << endl;       //dimline arc
-    (*m_ssBlock) << "  5"          << endl;
-    (*m_ssBlock) << getBlockHandle() << endl;
+    (*m_ssBlock) << "  0"          << '\n';
+    (*m_ssBlock) << "ARC"          << '\n';       //dimline arc
+    (*m_ssBlock) << "  5"          << '\n';
+    (*m_ssBlock) << getBlockHandle() << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "330"      << endl;
-        (*m_ssBlock) << m_saveBlkRecordHandle << endl;
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbEntity"      << endl;
-    }
-    (*m_ssBlock) << "  8"          << endl;
-    (*m_ssBlock) << "0"            << endl;
-//    (*m_ssBlock) << " 62"          << endl;
-//    (*m_ssBlock) << "     0"       << endl;
+        (*m_ssBlock) << "330"      << '\n';
+        (*m_ssBlock) << m_saveBlkRecordHandle << '\n';
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbEntity"      << '\n';
+    }
+    (*m_ssBlock) << "  8"          << '\n';
+    (*m_ssBlock) << "0"            << '\n';
+//    (*m_ssBlock) << " 62"          << '\n';
+//    (*m_ssBlock) << "     0"       << '\n';
     if (m_version > 12) {
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbCircle" << endl;
-    }
-    (*m_ssBlock) << " 10"          << endl;
-    (*m_ssBlock) << startExt2[0]   << endl;      //arc center
-    (*m_ssBlock) << " 20"          << endl;
-    (*m_ssBlock) << startExt2[1]   << endl;
-    (*m_ssBlock) << " 30"          << endl;
-    (*m_ssBlock) << startExt2[2]   << endl;
-    (*m_ssBlock) << " 40"          << endl;
-    (*m_ssBlock) << radius         << endl;      //radius
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbCircle" << '\n';
+    }
+    (*m_ssBlock) << " 10"          << '\n';
+    (*m_ssBlock) << startExt2[0]   << '\n';      //arc center
+    (*m_ssBlock) << " 20"          << '\n';
+    (*m_ssBlock) << startExt2[1]   << '\n';
+    (*m_ssBlock) << " 30"          << '\n';
+    (*m_ssBlock) << startExt2[2]   << '\n';
+    (*m_ssBlock) << " 40"          << '\n';
+    (*m_ssBlock) << radius         << '\n';      //radius
     if (m_version > 12) {
-        (*m_ssBlock) << "100"      << endl;
-        (*m_ssBlock) << "AcDbArc" << endl;
+        (*m_ssBlock) << "100"      << '\n';
+        (*m_ssBlock) << "AcDbArc" << '\n';
     }
-    (*m_ssBlock) << " 50"          << endl;
-    (*m_ssBlock) << startAngle     << endl;            //start angle
-    (*m_ssBlock) << " 51"          << endl;
-    (*m_ssBlock) << endAngle       << endl;            //end angle
+    (*m_ssBlock) << " 50"          << '\n';
+    (*m_ssBlock) << startAngle     << '\n';            //start angle
+    (*m_ssBlock) << " 51"          << '\n';
+    (*m_ssBlock) << endAngle       << '\n';            //end angle
 
     putText(dimText,toVector3d(textMidPoint), toVector3d(textMidPoint),3.5,1,
             m_ssBlock,getBlockHandle(),m_saveBlkRecordHandle);
@@ -1624,8 +1621,8 @@ void CDxfWrite::writeBlocksSection(void)
     //write blocks content
     (*m_ofs) << (*m_ssBlock).str();
 
-    (*m_ofs) << "  0"      << endl;
-    (*m_ofs) << "ENDSEC"   << endl;
+    (*m_ofs) << "  0"      << '\n';
+    (*m_ofs) << "ENDSEC"   << '\n';
 }
 
 //***************************
@@ -1642,8 +1639,8 @@ void CDxfWrite::writeEntitiesSection(void)
     (*m_ofs) << (*m_ssEntity).str();
     
 
-    (*m_ofs) << "  0"      << endl;
-    (*m_ofs) << "ENDSEC"   << endl;
+    (*m_ofs) << "  0"      << '\n';
+    (*m_ofs) << "ENDSEC"   << '\n';
 }
 
 //***************************
@@ -1673,15 +1670,18 @@ CDxfRead::CDxfRead(const char* filepath)
     memset( m_section_name, '\0', sizeof(m_section_name) );
     memset( m_block_name, '\0', sizeof(m_block_name) );
     m_ignore_errors = true;
+    m_bufferPos = 0;
+    m_bufferEnd = 0;
+    m_eof = false;
 
-    m_ifs = new ifstream(filepath);
+    // the file is read in large chunks and split into lines by get_line()
+    m_ifs = new ifstream(filepath, ios::in | ios::binary);
     if(!(*m_ifs)){
         m_fail = true;
         printf("DXF file didn't load\n");
         return;
     }
-    m_ifs->imbue(std::locale("C"));
-
+    m_buffer.resize(1 << 16);
 }
 
 CDxfRead::~CDxfRead()
@@ -1730,19 +1730,17 @@ bool CDxfRead::ReadLine()
     double e[3] = {0, 0, 0};
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
 
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadLine() Failed to read integer from '%s'\n", m_str );
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with line
@@ -1764,37 +1762,43 @@ bool CDxfRead::ReadLine()
             case 10:
                 // start x
                 get_line();
-                ss.str(m_str); ss >> s[0]; s[0] = mm(s[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[0])) return false;
+                s[0] = mm(s[0]);
                 break;
             case 20:
                 // start y
                 get_line();
-                ss.str(m_str); ss >> s[1]; s[1] = mm(s[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[1])) return false;
+                s[1] = mm(s[1]);
                 break;
             case 30:
                 // start z
                 get_line();
-                ss.str(m_str); ss >> s[2]; s[2] = mm(s[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[2])) return false;
+                s[2] = mm(s[2]);
                 break;
             case 11:
                 // end x
                 get_line();
-                ss.str(m_str); ss >> e[0]; e[0] = mm(e[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, e[0])) return false;
+                e[0] = mm(e[0]);
                 break;
             case 21:
                 // end y
                 get_line();
-                ss.str(m_str); ss >> e[1]; e[1] = mm(e[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, e[1])) return false;
+                e[1] = mm(e[1]);
                 break;
             case 31:
                 // end z
                 get_line();
-                ss.str(m_str); ss >> e[2]; e[2] = mm(e[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, e[2])) return false;
+                e[2] = mm(e[2]);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
 
             case 100:
@@ -1828,19 +1832,17 @@ bool CDxfRead::ReadPoint()
 {
     double s[3] = {0, 0, 0};
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
 
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadPoint() Failed to read integer from '%s'\n", m_str );
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with line
@@ -1856,23 +1858,26 @@ bool CDxfRead::ReadPoint()
             case 10:
                 // start x
                 get_line();
-                ss.str(m_str); ss >> s[0]; s[0] = mm(s[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[0])) return false;
+                s[0] = mm(s[0]);
                 break;
             case 20:
                 // start y
                 get_line();
-                ss.str(m_str); ss >> s[1]; s[1] = mm(s[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[1])) return false;
+                s[1] = mm(s[1]);
                 break;
             case 30:
                 // start z
                 get_line();
-                ss.str(m_str); ss >> s[2]; s[2] = mm(s[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[2])) return false;
+                s[2] = mm(s[2]);
                 break;
 
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
 
             case 100:
@@ -1912,18 +1917,16 @@ bool CDxfRead::ReadArc()
     double z_extrusion_dir = 1.0;
     bool hidden = false;
     
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadArc() Failed to read integer from '%s'\n", m_str);
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with arc
@@ -1945,37 +1948,41 @@ bool CDxfRead::ReadArc()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 40:
                 // radius
                 get_line();
-                ss.str(m_str); ss >> radius; radius = mm(radius); if(ss.fail()) return false;
+                if(!parse_value(m_str, radius)) return false;
+                radius = mm(radius);
                 break;
             case 50:
                 // start angle
                 get_line();
-                ss.str(m_str); ss >> start_angle; if(ss.fail()) return false;
+                if(!parse_value(m_str, start_angle)) return false;
                 break;
             case 51:
                 // end angle
                 get_line();
-                ss.str(m_str); ss >> end_angle; if(ss.fail()) return false;
+                if(!parse_value(m_str, end_angle)) return false;
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
 
 
@@ -1990,7 +1997,7 @@ bool CDxfRead::ReadArc()
             case 230:
                 //Z extrusion direction for arc 
                 get_line();
-                ss.str(m_str); ss >> z_extrusion_dir; if(ss.fail()) return false;                                
+                if(!parse_value(m_str, z_extrusion_dir)) return false;                               
                 break;
 
             default:
@@ -2018,17 +2025,15 @@ bool CDxfRead::ReadSpline()
 
     double temp_double;
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadSpline() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with Spline
@@ -2042,130 +2047,144 @@ bool CDxfRead::ReadSpline()
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
             case 210:
                 // normal x
                 get_line();
-                ss.str(m_str); ss >> sd.norm[0]; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.norm[0])) return false;
                 break;
             case 220:
                 // normal y
                 get_line();
-                ss.str(m_str); ss >> sd.norm[1]; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.norm[1])) return false;
                 break;
             case 230:
                 // normal z
                 get_line();
-                ss.str(m_str); ss >> sd.norm[2]; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.norm[2])) return false;
                 break;
             case 70:
                 // flag
                 get_line();
-                ss.str(m_str); ss >> sd.flag; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.flag)) return false;
                 break;
             case 71:
                 // degree
                 get_line();
-                ss.str(m_str); ss >> sd.degree; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.degree)) return false;
                 break;
             case 72:
                 // knots
                 get_line();
-                ss.str(m_str); ss >> sd.knots; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.knots)) return false;
                 break;
             case 73:
                 // control points
                 get_line();
-                ss.str(m_str); ss >> sd.control_points; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.control_points)) return false;
                 break;
             case 74:
                 // fit points
                 get_line();
-                ss.str(m_str); ss >> sd.fit_points; if(ss.fail()) return false;
+                if(!parse_value(m_str, sd.fit_points)) return false;
                 break;
             case 12:
                 // starttan x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.starttanx.push_back(temp_double);
                 break;
             case 22:
                 // starttan y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.starttany.push_back(temp_double);
                 break;
             case 32:
                 // starttan z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.starttanz.push_back(temp_double);
                 break;
             case 13:
                 // endtan x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.endtanx.push_back(temp_double);
                 break;
             case 23:
                 // endtan y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.endtany.push_back(temp_double);
                 break;
             case 33:
                 // endtan z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.endtanz.push_back(temp_double);
                 break;
             case 40:
                 // knot
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.knot.push_back(temp_double);
                 break;
             case 41:
                 // weight
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.weight.push_back(temp_double);
                 break;
             case 10:
                 // control x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.controlx.push_back(temp_double);
                 break;
             case 20:
                 // control y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.controly.push_back(temp_double);
                 break;
             case 30:
                 // control z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.controlz.push_back(temp_double);
                 break;
             case 11:
                 // fit x
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.fitx.push_back(temp_double);
                 break;
             case 21:
                 // fit y
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.fity.push_back(temp_double);
                 break;
             case 31:
                 // fit z
                 get_line();
-                ss.str(m_str); ss >> temp_double; temp_double = mm(temp_double); if(ss.fail()) return false;
+                if(!parse_value(m_str, temp_double)) return false;
+                temp_double = mm(temp_double);
                 sd.fitz.push_back(temp_double);
                 break;
             case 42:
@@ -2192,17 +2211,15 @@ bool CDxfRead::ReadCircle()
     double c[3] = {0,0,0}; // centre
     bool hidden = false;
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadCircle() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with Circle
@@ -2224,27 +2241,31 @@ bool CDxfRead::ReadCircle()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 40:
                 // radius
                 get_line();
-                ss.str(m_str); ss >> radius; radius = mm(radius); if(ss.fail()) return false;
+                if(!parse_value(m_str, radius)) return false;
+                radius = mm(radius);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
 
             case 100:
@@ -2274,17 +2295,15 @@ bool CDxfRead::ReadText()
 
     memset( c, 0, sizeof(c) );
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadText() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 return false;
@@ -2296,22 +2315,26 @@ bool CDxfRead::ReadText()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 40:
                 // text height
                 get_line();
-                ss.str(m_str); ss >> height; height = mm(height); if(ss.fail()) return false;
+                if(!parse_value(m_str, height)) return false;
+                height = mm(height);
                 break;
             case 1:
                 // text
@@ -2323,7 +2346,7 @@ bool CDxfRead::ReadText()
             case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
 
             case 100:
@@ -2353,17 +2376,15 @@ bool CDxfRead::ReadEllipse()
     double start=0; //start of arc
     double end=0;  // end of arc
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadEllipse() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found, so finish with Ellipse
@@ -2378,52 +2399,58 @@ bool CDxfRead::ReadEllipse()
             case 10:
                 // centre x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // centre y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // centre z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 11:
                 // major x
                 get_line();
-                ss.str(m_str); ss >> m[0]; m[0] = mm(m[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, m[0])) return false;
+                m[0] = mm(m[0]);
                 break;
             case 21:
                 // major y
                 get_line();
-                ss.str(m_str); ss >> m[1]; m[1] = mm(m[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, m[1])) return false;
+                m[1] = mm(m[1]);
                 break;
             case 31:
                 // major z
                 get_line();
-                ss.str(m_str); ss >> m[2]; m[2] = mm(m[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, m[2])) return false;
+                m[2] = mm(m[2]);
                 break;
             case 40:
                 // ratio
                 get_line();
-                ss.str(m_str); ss >> ratio; if(ss.fail()) return false;
+                if(!parse_value(m_str, ratio)) return false;
                 break;
             case 41:
                 // start
                 get_line();
-                ss.str(m_str); ss >> start; if(ss.fail()) return false;
+                if(!parse_value(m_str, start)) return false;
                 break;
             case 42:
                 // end
                 get_line();
-                ss.str(m_str); ss >> end; if(ss.fail()) return false;
+                if(!parse_value(m_str, end)) return false;
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
             case 100:
             case 210:
@@ -2523,17 +2550,15 @@ bool CDxfRead::ReadLwPolyLine()
     int flags;
     bool next_item_found = false;
 
-    while(!((*m_ifs).eof()) && !next_item_found)
+    while(!(m_eof) && !next_item_found)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadLwPolyLine() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found
@@ -2562,36 +2587,39 @@ bool CDxfRead::ReadLwPolyLine()
                     x_found = false;
                     y_found = false;
                 }
-                ss.str(m_str); ss >> x; x = mm(x); if(ss.fail()) return false;
+                if(!parse_value(m_str, x)) return false;
+                x = mm(x);
                 x_found = true;
                 break;
             case 20:
                 // y
                 get_line();
-                ss.str(m_str); ss >> y; y = mm(y); if(ss.fail()) return false;
+                if(!parse_value(m_str, y)) return false;
+                y = mm(y);
                 y_found = true;
                 break;
             case 38: 
                 // elevation
                 get_line();
-                ss.str(m_str); ss >> z; z = mm(z); if(ss.fail()) return false;
+                if(!parse_value(m_str, z)) return false;
+                z = mm(z);
                 break;
             case 42:
                 // bulge
                 get_line();
-                ss.str(m_str); ss >> bulge; if(ss.fail()) return false;
+                if(!parse_value(m_str, bulge)) return false;
                 bulge_found = true;
                 break;
             case 70:
                 // flags
                 get_line();
-                if(sscanf(m_str, "%d", &flags) != 1)return false;
+                if(!parse_value(m_str, flags))return false;
                 closed = ((flags & 1) != 0);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
             default:
                 // skip the next line
@@ -2630,15 +2658,13 @@ bool CDxfRead::ReadVertex(double *pVertex, bool *bulge_found, double *bulge)
     pVertex[1] = 0.0;
     pVertex[2] = 0.0;
 
-    while(!(*m_ifs).eof()) {
+    while(!m_eof) {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1) {
+        if(!parse_value(m_str, n)) {
             printf("CDxfRead::ReadVertex() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
         case 0:
         DerefACI();
@@ -2654,30 +2680,33 @@ bool CDxfRead::ReadVertex(double *pVertex, bool *bulge_found, double *bulge)
         case 10:
             // x
             get_line();
-            ss.str(m_str); ss >> x; pVertex[0] = mm(x); if(ss.fail()) return false;
+            if(!parse_value(m_str, x)) return false;
+            pVertex[0] = mm(x);
             x_found = true;
             break;
         case 20:
             // y
             get_line();
-            ss.str(m_str); ss >> y; pVertex[1] = mm(y); if(ss.fail()) return false;
+            if(!parse_value(m_str, y)) return false;
+            pVertex[1] = mm(y);
             y_found = true;
             break;
         case 30:
             // z
             get_line();
-            ss.str(m_str); ss >> z; pVertex[2] = mm(z); if(ss.fail()) return false;
+            if(!parse_value(m_str, z)) return false;
+            pVertex[2] = mm(z);
             break;
 
         case 42:
             get_line();
             *bulge_found = true;
-            ss.str(m_str); ss >> *bulge; if(ss.fail()) return false;
+            if(!parse_value(m_str, *bulge)) return false;
             break;
     case 62:
         // color index
         get_line();
-        ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+        if(!parse_value(m_str, m_aci)) return false;
         break;
 
         default:
@@ -2703,17 +2732,15 @@ bool CDxfRead::ReadPolyLine()
     bool bulge_found;
     double bulge;
 
-    while(!(*m_ifs).eof())
+    while(!m_eof)
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadPolyLine() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0:
                 // next item found
@@ -2745,13 +2772,13 @@ bool CDxfRead::ReadPolyLine()
             case 70:
                 // flags
                 get_line();
-                if(sscanf(m_str, "%d", &flags) != 1)return false;
+                if(!parse_value(m_str, flags))return false;
                 closed = ((flags & 1) != 0);
                 break;
                 case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
             default:
                 // skip the next line
@@ -2825,17 +2852,15 @@ bool CDxfRead::ReadInsert()
     double rot = 0.0; // rotation
     char name[1024] = {0};
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadInsert() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0: 
                 // next item found
@@ -2850,37 +2875,40 @@ bool CDxfRead::ReadInsert()
             case 10:
                 // coord x
                 get_line();
-                ss.str(m_str); ss >> c[0]; c[0] = mm(c[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[0])) return false;
+                c[0] = mm(c[0]);
                 break;
             case 20:
                 // coord y
                 get_line();
-                ss.str(m_str); ss >> c[1]; c[1] = mm(c[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[1])) return false;
+                c[1] = mm(c[1]);
                 break;
             case 30:
                 // coord z
                 get_line();
-                ss.str(m_str); ss >> c[2]; c[2] = mm(c[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, c[2])) return false;
+                c[2] = mm(c[2]);
                 break;
             case 41:
                 // scale x
                 get_line();
-                ss.str(m_str); ss >> s[0]; if(ss.fail()) return false;
+                if(!parse_value(m_str, s[0])) return false;
                 break;
             case 42:
                 // scale y
                 get_line();
-                ss.str(m_str); ss >> s[1]; if(ss.fail()) return false;
+                if(!parse_value(m_str, s[1])) return false;
                 break;
             case 43:
                 // scale z
                 get_line();
-                ss.str(m_str); ss >> s[2]; if(ss.fail()) return false;
+                if(!parse_value(m_str, s[2])) return false;
                 break;
             case 50:
                 // rotation
                 get_line();
-                ss.str(m_str); ss >> rot; if(ss.fail()) return false;
+                if(!parse_value(m_str, rot)) return false;
                 break;
             case 2:
                 // block name
@@ -2890,7 +2918,7 @@ bool CDxfRead::ReadInsert()
             case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
             case 100:
             case 39:
@@ -2917,17 +2945,15 @@ bool CDxfRead::ReadDimension()
     double p[3] = {0,0,0}; // dimpoint
     double rot = -1.0; // rotation
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadInsert() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0: 
                 // next item found
@@ -2942,57 +2968,66 @@ bool CDxfRead::ReadDimension()
             case 13:
                 // start x
                 get_line();
-                ss.str(m_str); ss >> s[0]; s[0] = mm(s[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[0])) return false;
+                s[0] = mm(s[0]);
                 break;
             case 23:
                 // start y
                 get_line();
-                ss.str(m_str); ss >> s[1]; s[1] = mm(s[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[1])) return false;
+                s[1] = mm(s[1]);
                 break;
             case 33:
                 // start z
                 get_line();
-                ss.str(m_str); ss >> s[2]; s[2] = mm(s[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, s[2])) return false;
+                s[2] = mm(s[2]);
                 break;
             case 14:
                 // end x
                 get_line();
-                ss.str(m_str); ss >> e[0]; e[0] = mm(e[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, e[0])) return false;
+                e[0] = mm(e[0]);
                 break;
             case 24:
                 // end y
                 get_line();
-                ss.str(m_str); ss >> e[1]; e[1] = mm(e[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, e[1])) return false;
+                e[1] = mm(e[1]);
                 break;
             case 34:
                 // end z
                 get_line();
-                ss.str(m_str); ss >> e[2]; e[2] = mm(e[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, e[2])) return false;
+                e[2] = mm(e[2]);
                 break;
             case 10:
                 // dimline x
                 get_line();
-                ss.str(m_str); ss >> p[0]; p[0] = mm(p[0]); if(ss.fail()) return false;
+                if(!parse_value(m_str, p[0])) return false;
+                p[0] = mm(p[0]);
                 break;
             case 20:
                 // dimline y
                 get_line();
-                ss.str(m_str); ss >> p[1]; p[1] = mm(p[1]); if(ss.fail()) return false;
+                if(!parse_value(m_str, p[1])) return false;
+                p[1] = mm(p[1]);
                 break;
             case 30:
                 // dimline z
                 get_line();
-                ss.str(m_str); ss >> p[2]; p[2] = mm(p[2]); if(ss.fail()) return false;
+                if(!parse_value(m_str, p[2])) return false;
+                p[2] = mm(p[2]);
                 break;
             case 50:
                 // rotation
                 get_line();
-                ss.str(m_str); ss >> rot; if(ss.fail()) return false;
+                if(!parse_value(m_str, rot)) return false;
                 break;
             case 62:
                 // color index
                 get_line();
-                ss.str(m_str); ss >> m_aci; if(ss.fail()) return false;
+                if(!parse_value(m_str, m_aci)) return false;
                 break;
             case 100:
             case 39:
@@ -3014,17 +3049,15 @@ bool CDxfRead::ReadDimension()
 
 bool CDxfRead::ReadBlockInfo()
 {
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadBlockInfo() Failed to read integer from '%s'\n", m_str);
             return false;
         }
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 2:
                 // block name
@@ -3055,23 +3088,156 @@ void CDxfRead::get_line()
         return;
     }
 
-    m_ifs->getline(m_str, 1024);
-
-    char str[1024];
-    size_t len = strlen(m_str);
-    int j = 0;
+    // copy the next line without leading blanks and carriage returns,
+    // the end of the file is reached when a line isn't terminated
+    size_t len = 0;
     bool non_white_found = false;
-    for(size_t i = 0; i<len; i++){
-        if(non_white_found || (m_str[i] != ' ' && m_str[i] != '\t')){
-            if(m_str[i] != '\r')
-            {
-                str[j] = m_str[i]; j++;
+    bool eol = false;
+    while(!eol)
+    {
+        if(m_bufferPos == m_bufferEnd && !fill_buffer())
+        {
+            m_eof = true;
+            break;
+        }
+        const char* p = &m_buffer[m_bufferPos];
+        const char* end = &m_buffer[0] + m_bufferEnd;
+        for(; p != end; ++p){
+            char c = *p;
+            if(c == '\n'){
+                eol = true;
+                ++p;
+                break;
+            }
+            if(non_white_found || (c != ' ' && c != '\t')){
+                // too long lines are cut
+                if(c != '\r' && len < sizeof(m_str) - 1)
+                {
+                    m_str[len] = c; len++;
+                }
+                non_white_found = true;
+            }
+        }
+        m_bufferPos = p - &m_buffer[0];
+    }
+    m_str[len] = 0;
+}
+
+bool CDxfRead::fill_buffer()
+{
+    m_bufferPos = 0;
+    m_bufferEnd = 0;
+    if(m_buffer.empty())
+        return false;
+    m_ifs->read(&m_buffer[0], m_buffer.size());
+    m_bufferEnd = static_cast<size_t>(m_ifs->gcount());
+    return m_bufferEnd > 0;
+}
+
+// Conversions of the group codes and values. As with the stream and sscanf()
+// conversions used before, leading white space is skipped, anything after
+// the number is ignored and false is returned if there is no number.
+bool CDxfRead::parse_value(const char *str, int& value)
+{
+    while(isspace(static_cast<unsigned char>(*str)))
+        str++;
+    bool negative = (*str == '-');
+    if(*str == '-' || *str == '+')
+        str++;
+    if(!isdigit(static_cast<unsigned char>(*str)))
+        return false;
+    long long result = 0;
+    for(; isdigit(static_cast<unsigned char>(*str)); str++){
+        result = result * 10 + (*str - '0');
+        if(result > static_cast<long long>(INT_MAX) + 1)
+            return false;
+    }
+    if(negative)
+        result = -result;
+    if(result > INT_MAX)
+        return false;
+    value = static_cast<int>(result);
+    return true;
+}
+
+bool CDxfRead::parse_value(const char *str, double& value)
+{
+    // exactly representable powers of ten
+    static const double powers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    const char *p = str;
+    while(isspace(static_cast<unsigned char>(*p)))
+        p++;
+    bool negative = (*p == '-');
+    if(*p == '-' || *p == '+')
+        p++;
+
+    // up to 19 significant digits are collected, the exponent is adjusted
+    // for the decimals and the digits dropped
+    unsigned long long mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool found = false;
+    for(; isdigit(static_cast<unsigned char>(*p)); p++){
+        found = true;
+        if(digits < 19){
+            mantissa = mantissa * 10 + (*p - '0');
+            if(mantissa) digits++;
+        }
+        else
+            exponent++;
+    }
+    if(*p == '.'){
+        for(p++; isdigit(static_cast<unsigned char>(*p)); p++){
+            found = true;
+            if(digits < 19){
+                mantissa = mantissa * 10 + (*p - '0');
+                if(mantissa) digits++;
+                exponent--;
             }
-            non_white_found = true;
         }
     }
-    str[j] = 0;
-    strcpy(m_str, str);
+    if(!found)
+        return false;
+
+    bool exact = true;
+    if(*p == 'e' || *p == 'E'){
+        const char *q = p + 1;
+        bool negexp = (*q == '-');
+        if(*q == '-' || *q == '+')
+            q++;
+        if(isdigit(static_cast<unsigned char>(*q))){
+            int e = 0;
+            for(; isdigit(static_cast<unsigned char>(*q)); q++){
+                if(e < 10000)
+                    e = e * 10 + (*q - '0');
+            }
+            exponent += negexp ? -e : e;
+        }
+        else
+            exact = false;
+    }
+
+    // With at most 15 digits the mantissa and the power of ten are exact
+    // doubles, so a single multiplication or division rounds correctly.
+    // Anything else goes through the slower standard conversion.
+    if(exact && digits <= 15 && exponent >= -22 && exponent <= 22){
+        double result = static_cast<double>(mantissa);
+        if(exponent < 0)
+            result /= powers[-exponent];
+        else
+            result *= powers[exponent];
+        value = negative ? -result : result;
+        return true;
+    }
+
+    std::istringstream ss(str);
+    ss.imbue(std::locale("C"));
+    ss >> value;
+    return !ss.fail();
 }
 
 void CDxfRead::put_line(const char *value)
@@ -3085,7 +3251,7 @@ bool CDxfRead::ReadUnits()
     get_line(); // Skip to next line.
     get_line(); // Skip to next line.
     int n = 0;
-    if(sscanf(m_str, "%d", &n) == 1)
+    if(parse_value(m_str, n))
     {
         m_eUnits = eDxfUnits_t( n );
         return(true);
@@ -3103,19 +3269,17 @@ bool CDxfRead::ReadLayer()
     std::string layername;
     int aci = -1;
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         get_line();
         int n;
 
-        if(sscanf(m_str, "%d", &n) != 1)
+        if(!parse_value(m_str, n))
         {
             printf("CDxfRead::ReadLayer() Failed to read integer from '%s'\n", m_str );
             return false;
         }
 
-        std::istringstream ss;
-        ss.imbue(std::locale("C"));
         switch(n){
             case 0: // next item found, so finish with line
                     if (layername.empty())
@@ -3134,7 +3298,7 @@ bool CDxfRead::ReadLayer()
             case 62:
                 // layer color ; if negative, layer is off
                 get_line();
-                if(sscanf(m_str, "%d", &aci) != 1)return false;
+                if(!parse_value(m_str, aci))return false;
                 break;
 
             case 6: // linetype name
@@ -3162,7 +3326,7 @@ void CDxfRead::DoRead(const bool ignore_errors /* = false */ )
 
     get_line();
 
-    while(!((*m_ifs).eof()))
+    while(!(m_eof))
     {
         if (!strcmp( m_str, "$INSUNITS" )){
             if (!ReadUnits())return;
@@ -3173,7 +3337,7 @@ void CDxfRead::DoRead(const bool ignore_errors /* = false */ )
             get_line();
             get_line();
             int n = 1;
-            if(sscanf(m_str, "%d", &n) == 1)
+            if(parse_value(m_str, n))
             {
                 if(n == 0)m_measurement_inch = true;
             }
@@ -243,6 +243,10 @@ public:
 class ImportExport CDxfRead{
 private:
     std::ifstream* m_ifs;
+    std::vector<char> m_buffer; // chunk of the file being split into lines
+    size_t m_bufferPos;
+    size_t m_bufferEnd;
+    bool m_eof;
 
     bool m_fail;
     char m_str[1024];
@@ -279,6 +283,9 @@ private:
 
     void get_line();
     void put_line(const char *value);
+    bool fill_buffer();
+    static bool parse_value(const char *str, int& value);
+    static bool parse_value(const char *str, double& value);
     void DerefACI();
 
 protected:
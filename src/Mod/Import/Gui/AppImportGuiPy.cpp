@@ -65,6 +65,9 @@
 # include <TopoDS_Iterator.hxx>
 # include <APIHeaderSection_MakeHeader.hxx>
 # include <OSD_Exception.hxx>
+# include <Bnd_Box.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepMesh_IncrementalMesh.hxx>
 #if OCC_VERSION_HEX >= 0x060500
 # include <TDataXtd_Shape.hxx>
 # else
@@ -77,6 +80,7 @@
 
 #include <Base/PyObjectBase.h>
 #include <Base/Console.h>
+#include <Base/TimeInfo.h>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
@@ -292,6 +296,10 @@ public:
     ImportOCAFGui(Handle(TDocStd_Document) h, App::Document* d, const std::string& name)
         : ImportOCAF(h, d, name)
     {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath
+            ("User parameter:BaseApp/Preferences/Mod/Part");
+        deviation = hGrp->GetFloat("MeshDeviation",0.2);
+        angularDeflection = hGrp->GetFloat("MeshAngularDeflection",28.65);
     }
 
 private:
@@ -303,6 +311,35 @@ private:
             static_cast<PartGui::ViewProviderPartExt*>(vp)->DiffuseColor.setValues(colors);
         }
     }
+    void tessellate(const TopoDS_Shape& shape) const
+    {
+        // Mesh with the deflection ViewProviderPartExt::updateVisual() uses, so that
+        // the view providers find the faces already meshed. The bounding box of a
+        // meshed shape comes from its triangulation, hence the second pass.
+        TopoDS_Shape cShape(shape);
+        cShape.Location(TopLoc_Location());
+        for (int pass = 0; pass < 2; pass++) {
+            Bnd_Box bounds;
+            BRepBndLib::Add(cShape, bounds);
+            if (bounds.IsVoid())
+                return;
+            bounds.SetGap(0.0);
+            Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+            bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+            Standard_Real deflection = ((xMax-xMin)+(yMax-yMin)+(zMax-zMin))/300.0 * deviation;
+#if OCC_VERSION_HEX >= 0x060600
+            Standard_Real AngDeflectionRads = angularDeflection / 180.0 * M_PI;
+            BRepMesh_IncrementalMesh(cShape,deflection,Standard_False,
+                    AngDeflectionRads,Standard_False);
+#else
+            BRepMesh_IncrementalMesh(cShape,deflection);
+#endif
+        }
+    }
+
+private:
+    double deviation;
+    double angularDeflection;
 };
 
 class ExportOCAFGui : public Import::ExportOCAF
@@ -377,10 +414,13 @@ private:
             Handle(XCAFApp_Application) hApp = XCAFApp_Application::GetApplication();
             Handle(TDocStd_Document) hDoc;
             bool optionReadShapeCompoundMode = true;
+            bool optionReadShapeInstances = false;
             hApp->NewDocument(TCollection_ExtendedString("MDTV-CAF"), hDoc);
             ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Import/hSTEP");
             optionReadShapeCompoundMode = hGrp->GetBool("ReadShapeCompoundMode", optionReadShapeCompoundMode);
+            optionReadShapeInstances = hGrp->GetBool("ReadShapeInstances", optionReadShapeInstances);
 
+            Base::TimeInfo timer;
             if (file.hasExtension("stp") || file.hasExtension("step")) {
                 try {
                     STEPCAFControl_Reader aReader;
@@ -445,18 +485,25 @@ private:
                 throw Py::Exception(Base::BaseExceptionFreeCADError, "no supported file format");
             }
 
+            Base::Console().Log("Import: %s read and transferred in %.3f s\n",
+                                file.fileName().c_str(), Base::TimeInfo::diffTimeF(timer, Base::TimeInfo()));
+
             ImportOCAFGui ocaf(hDoc, pcDoc, file.fileNamePure());
             // We must recompute the doc before loading shapes as they are going to be
             // inserted into the document and computed at the same time so we are going to
             // purge the document before recomputing it to clear it and settle it in the proper
             // way. This is drastically improving STEP rendering time on complex STEP files.
             pcDoc->recompute();
-            if (file.hasExtension("stp") || file.hasExtension("step"))
+            if (file.hasExtension("stp") || file.hasExtension("step")) {
                 ocaf.setMerge(optionReadShapeCompoundMode);
+                ocaf.setInstancing(optionReadShapeInstances);
+            }
             ocaf.loadShapes();
             pcDoc->purgeTouched();
             pcDoc->recompute();
             hApp->Close(hDoc);
+            Base::Console().Log("Import: %s imported in %.3f s\n",
+                                file.fileName().c_str(), Base::TimeInfo::diffTimeF(timer, Base::TimeInfo()));
         }
         catch (Standard_Failure& e) {
             throw Py::Exception(Base::BaseExceptionFreeCADError, e.GetMessageString());
@@ -0,0 +1,134 @@
+#**************************************************************************
+#   Copyright (c) 2026 FreeCAD Project Association                        *
+#                                                                         *
+#   This file is part of the FreeCAD CAx development system.              *
+#                                                                         *
+#   This program is free software; you can redistribute it and/or modify  *
+#   it under the terms of the GNU Lesser General Public License (LGPL)    *
+#   as published by the Free Software Foundation; either version 2 of     *
+#   the License, or (at your option) any later version.                   *
+#   for detail see the LICENCE text file.                                 *
+#                                                                         *
+#   FreeCAD is distributed in the hope that it will be useful,            *
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+#   GNU Library General Public License for more details.                  *
+#                                                                         *
+#   You should have received a copy of the GNU Library General Public     *
+#   License along with FreeCAD; if not, write to the Free Software        *
+#   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+#   USA                                                                   *
+#**************************************************************************
+
+import FreeCAD, os, tempfile, time, unittest, Part, Import
+
+#---------------------------------------------------------------------------
+# define the test cases to test the DXF reader of the FreeCAD Import module
+#---------------------------------------------------------------------------
+
+
+def makeDxf(lines, circles, arcs, eol="\n", final_eol=True):
+    """makeDxf(lines, circles, arcs, [eol, final_eol]) -> str
+
+    Returns a synthetic DXF file with the given number of LINE, CIRCLE and ARC
+    entities. The coordinates use the number formats found in DXF files:
+    negative values, exponents, leading blanks and integers. Big counts give
+    files for timing the reader, see benchmarkDxf()."""
+    out = ["  0", "SECTION", "  2", "ENTITIES"]
+    for i in range(lines):
+        out += ["  0", "LINE", "  8", "0",
+                " 10", "%.17g" % (i * 0.1), " 20", "-%d" % i, " 30", "0.0",
+                " 11", "%.6e" % (i * 0.1 + 1.0), " 21", " %d.5" % i, " 31", "0"]
+    for i in range(circles):
+        out += ["  0", "CIRCLE", "  8", "0",
+                " 10", "%g" % (i * 3.0), " 20", "1E1", " 30", "0",
+                " 40", "%.15g" % (1.0 + i / 7.0)]
+    for i in range(arcs):
+        out += ["  0", "ARC", "  8", "0",
+                " 10", "%d" % i, " 20", "0", " 30", "0",
+                " 40", "2.5", " 50", "0", " 51", "90"]
+    out += ["  0", "ENDSEC", "  0", "EOF"]
+    text = eol.join(out)
+    if final_eol:
+        text += eol
+    return text
+
+
+def benchmarkDxf(lines=200000, circles=100000, arcs=100000):
+    """benchmarkDxf([lines, circles, arcs]) -> seconds
+
+    Reads a generated DXF file into a new document and returns the time
+    taken. Not run by the unit tests, call it from the Python console."""
+    fd, path = tempfile.mkstemp(suffix=".dxf")
+    try:
+        with os.fdopen(fd, "w") as f:
+            f.write(makeDxf(lines, circles, arcs))
+        doc = FreeCAD.newDocument("DxfBenchmark")
+        start = time.time()
+        Import.readDXF(path, doc.Name)
+        elapsed = time.time() - start
+        FreeCAD.closeDocument(doc.Name)
+        return elapsed
+    finally:
+        os.remove(path)
+
+
+class DxfReadTestCases(unittest.TestCase):
+    def setUp(self):
+        self.Doc = FreeCAD.newDocument("DxfTest")
+        # the reader creates one feature per entity unless layers are grouped
+        self.Params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Draft")
+        self.GroupLayers = self.Params.GetBool("groupLayers", False)
+        self.Scaling = self.Params.GetFloat("dxfScaling", 1.0)
+        self.Params.SetBool("groupLayers", False)
+        self.Params.SetFloat("dxfScaling", 1.0)
+        self.Files = []
+
+    def readDxf(self, text):
+        fd, path = tempfile.mkstemp(suffix=".dxf")
+        self.Files.append(path)
+        # binary, so that the line ends are written as given
+        with os.fdopen(fd, "wb") as f:
+            f.write(text.encode("ascii"))
+        Import.readDXF(path, self.Doc.Name)
+        return [o for o in self.Doc.Objects if o.isDerivedFrom("Part::Feature")]
+
+    def countCurves(self, objs):
+        counts = {}
+        for o in objs:
+            for e in o.Shape.Edges:
+                name = type(e.Curve).__name__
+                counts[name] = counts.get(name, 0) + 1
+        return counts
+
+    def testEntityCounts(self):
+        # more than fits into one read buffer of the tokenizer
+        objs = self.readDxf(makeDxf(2000, 500, 300))
+        self.assertEqual(len(objs), 2800)
+        counts = self.countCurves(objs)
+        self.assertEqual(counts.get("Line", 0) + counts.get("LineSegment", 0), 2000)
+        self.assertEqual(counts.get("Circle", 0), 800)
+
+    def testValues(self):
+        objs = self.readDxf(makeDxf(3, 2, 0))
+        line = objs[2].Shape.Edges[0]
+        self.assertAlmostEqual(line.Vertexes[0].X, 0.2, 12)
+        self.assertAlmostEqual(line.Vertexes[0].Y, -2.0, 12)
+        self.assertAlmostEqual(line.Vertexes[1].X, 1.2, 12)
+        self.assertAlmostEqual(line.Vertexes[1].Y, 2.5, 12)
+        circle = objs[4].Shape.Edges[0].Curve
+        self.assertAlmostEqual(circle.Radius, 1.0 + 1 / 7.0, 12)
+        self.assertAlmostEqual(circle.Center.x, 3.0, 12)
+        self.assertAlmostEqual(circle.Center.y, 10.0, 12)
+
+    def testLineEnds(self):
+        # CRLF line ends and no line end after the last line
+        objs = self.readDxf(makeDxf(10, 10, 10, eol="\r\n", final_eol=False))
+        self.assertEqual(len(objs), 30)
+
+    def tearDown(self):
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Params.SetBool("groupLayers", self.GroupLayers)
+        self.Params.SetFloat("dxfScaling", self.Scaling)
+        for path in self.Files:
+            os.remove(path)
@@ -27,6 +27,8 @@
 
 #include <App/Application.h>
 
+#include <boost/bind.hpp>
+
 #include "OCCError.h"
 #include "TopoShape.h"
 #include "FeaturePartBox.h"
@@ -624,5 +626,10 @@ PyMOD_INIT_FUNC(Part)
     Interface_Static::SetCVal("write.step.product.name", hStepGrp->GetASCII("Product",
        Interface_Static::CVal("write.step.product.name")).c_str());
 
+    // the cached check results and intersections keep their shapes alive,
+    // so they are released together with the documents
+    App::GetApplication().signalDeleteDocument.connect(boost::bind(&Part::TopoShape::clearCheckCache));
+    App::GetApplication().signalDeleteDocument.connect(boost::bind(&Part::TopoShape::clearBooleanCache));
+
     PyMOD_Return(partModule);
 }
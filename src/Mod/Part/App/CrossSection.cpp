@@ -23,10 +23,15 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+# include <algorithm>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
 # include <BRepAdaptor_Surface.hxx>
 # include <BRepAlgoAPI_Common.hxx>
 # include <BRepAlgoAPI_Cut.hxx>
 # include <BRepAlgoAPI_Section.hxx>
+# include <BRepBndLib.hxx>
+# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepGProp_Face.hxx>
@@ -40,14 +45,29 @@
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopoDS.hxx>
+# include <TopoDS_Compound.hxx>
 # include <TopoDS_Edge.hxx>
+# include <TopoDS_Face.hxx>
 # include <TopoDS_Wire.hxx>
 #endif
 
 #include "CrossSection.h"
+#include "Parallel.h"
 
 using namespace Part;
 
+// A solid, or a shell or face that doesn't belong to a solid, with the range
+// of distances of the planes that may intersect it. A shell also keeps the
+// ranges of its faces, so that only the faces reaching a plane are sliced.
+struct CrossSection::SliceShape
+{
+    TopoDS_Shape shape;
+    bool solid;
+    double min, max;
+    std::vector<TopoDS_Face> faces;
+    std::vector<std::pair<double, double> > ranges;
+};
+
 
 CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
   : a(a), b(b), c(c), s(s)
@@ -57,20 +77,158 @@ CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
 std::list<TopoDS_Wire> CrossSection::slice(double d) const
 {
     std::list<TopoDS_Wire> wires;
+    std::vector<SliceShape> shapes;
+    collectShapes(s, shapes, true);
+    sliceShapes(d, shapes, wires);
+    return wires;
+}
+
+std::vector< std::list<TopoDS_Wire> > CrossSection::slices(const std::vector<double>& d) const
+{
+    std::vector< std::list<TopoDS_Wire> > wires(d.size());
+    std::vector<SliceShape> shapes;
+    collectShapes(s, shapes, true);
+
+    int threads = Parallel::threadCount();
+    if (d.size() < 2 || threads < 2) {
+        for (std::size_t i = 0; i < d.size(); i++)
+            sliceShapes(d[i], shapes, wires[i]);
+        return wires;
+    }
+
+    // Each worker gets its own copy of the shape, because the boolean
+    // operations used for slicing may update tolerances of the input shapes.
+    // Distances are distributed round robin, so that the (usually similar)
+    // cost of neighbouring slices is spread evenly.
+    std::size_t workers = std::min<std::size_t>(threads, d.size());
+    Parallel::forEach(workers, [&](std::size_t worker) {
+        // the copy has the same structure, so the ranges can be taken over
+        std::vector<SliceShape> copies;
+        collectShapes(BRepBuilderAPI_Copy(s).Shape(), copies, false);
+        for (std::size_t i = 0; i < copies.size(); i++) {
+            copies[i].min = shapes[i].min;
+            copies[i].max = shapes[i].max;
+            copies[i].ranges = shapes[i].ranges;
+        }
+
+        for (std::size_t i = worker; i < d.size(); i += workers)
+            sliceShapes(d[i], copies, wires[i]);
+    });
+
+    return wires;
+}
+
+void CrossSection::collectShapes(const TopoDS_Shape& shape, std::vector<SliceShape>& shapes, bool bounds) const
+{
     // Fixes: 0001228: Cross section of Torus in Part Workbench fails or give wrong results
     // Fixes: 0001137: Incomplete slices when using Part.slice on a torus
     TopExp_Explorer xp;
-    for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
-        sliceSolid(d, xp.Current(), wires);
+    for (xp.Init(shape, TopAbs_SOLID); xp.More(); xp.Next()) {
+        SliceShape solid;
+        solid.shape = xp.Current();
+        solid.solid = true;
+        solid.min = solid.max = 0.0;
+        if (bounds)
+            getRange(solid.shape, solid.min, solid.max);
+        shapes.push_back(solid);
+    }
+    for (xp.Init(shape, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
+        SliceShape shell;
+        shell.shape = xp.Current();
+        shell.solid = false;
+        shell.min = shell.max = 0.0;
+        TopExp_Explorer xpFace;
+        for (xpFace.Init(shell.shape, TopAbs_FACE); xpFace.More(); xpFace.Next()) {
+            shell.faces.push_back(TopoDS::Face(xpFace.Current()));
+            if (bounds) {
+                std::pair<double, double> range;
+                getRange(xpFace.Current(), range.first, range.second);
+                if (shell.ranges.empty()) {
+                    shell.min = range.first;
+                    shell.max = range.second;
+                }
+                else {
+                    shell.min = std::min(shell.min, range.first);
+                    shell.max = std::max(shell.max, range.second);
+                }
+                shell.ranges.push_back(range);
+            }
+        }
+        shapes.push_back(shell);
     }
-    for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
-        sliceNonSolid(d, xp.Current(), wires);
+    for (xp.Init(shape, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
+        SliceShape face;
+        face.shape = xp.Current();
+        face.solid = false;
+        face.min = face.max = 0.0;
+        if (bounds)
+            getRange(face.shape, face.min, face.max);
+        shapes.push_back(face);
     }
-    for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
-        sliceNonSolid(d, xp.Current(), wires);
+}
+
+void CrossSection::getRange(const TopoDS_Shape& shape, double& min, double& max) const
+{
+    Bnd_Box box;
+    BRepBndLib::Add(shape, box);
+    if (box.IsVoid()) {
+        // nothing to slice
+        min = 1.0;
+        max = -1.0;
+        return;
     }
 
-    return wires;
+    if (box.IsOpenXmin() || box.IsOpenXmax() ||
+        box.IsOpenYmin() || box.IsOpenYmax() ||
+        box.IsOpenZmin() || box.IsOpenZmax()) {
+        min = -Precision::Infinite();
+        max = Precision::Infinite();
+        return;
+    }
+
+    box.Enlarge(Precision::Confusion());
+    double xMin, yMin, zMin, xMax, yMax, zMax;
+    box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+
+    // a plane a*x+b*y+c*z=d intersects the box if d lies between the
+    // smallest and largest value of a*x+b*y+c*z of the box corners
+    min = std::min(a*xMin, a*xMax) + std::min(b*yMin, b*yMax) + std::min(c*zMin, c*zMax);
+    max = std::max(a*xMin, a*xMax) + std::max(b*yMin, b*yMax) + std::max(c*zMin, c*zMax);
+}
+
+void CrossSection::sliceShapes(double d, const std::vector<SliceShape>& shapes, std::list<TopoDS_Wire>& wires) const
+{
+    for (std::vector<SliceShape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
+        if (d < it->min || d > it->max)
+            continue;
+
+        if (it->solid) {
+            sliceSolid(d, it->shape, wires);
+        }
+        else if (it->faces.empty()) {
+            sliceNonSolid(d, it->shape, wires);
+        }
+        else {
+            // only slice the faces of the shell reaching the plane
+            std::vector<TopoDS_Face> faces;
+            for (std::size_t i = 0; i < it->faces.size(); i++) {
+                if (d >= it->ranges[i].first && d <= it->ranges[i].second)
+                    faces.push_back(it->faces[i]);
+            }
+
+            if (faces.size() == it->faces.size()) {
+                sliceNonSolid(d, it->shape, wires);
+            }
+            else if (!faces.empty()) {
+                TopoDS_Compound comp;
+                BRep_Builder builder;
+                builder.MakeCompound(comp);
+                for (std::vector<TopoDS_Face>::iterator jt = faces.begin(); jt != faces.end(); ++jt)
+                    builder.Add(comp, *jt);
+                sliceNonSolid(d, comp, wires);
+            }
+        }
+    }
 }
 
 void CrossSection::sliceNonSolid(double d, const TopoDS_Shape& shape, std::list<TopoDS_Wire>& wires) const
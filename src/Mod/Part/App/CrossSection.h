@@ -25,6 +25,7 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 #include <TopTools_IndexedMapOfShape.hxx>
 
 class TopoDS_Shape;
@@ -37,8 +38,18 @@ class PartExport CrossSection
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /** Slices the shape at all the given distances at once
+     * The shapes not reaching a plane are skipped by their bounding boxes,
+     * and the slices are computed in parallel. The result holds the wires
+     * of each distance in the order of \a d.
+     */
+    std::vector< std::list<TopoDS_Wire> > slices(const std::vector<double>& d) const;
 
 private:
+    struct SliceShape;
+    void collectShapes(const TopoDS_Shape&, std::vector<SliceShape>&, bool bounds) const;
+    void getRange(const TopoDS_Shape&, double& min, double& max) const;
+    void sliceShapes(double d, const std::vector<SliceShape>&, std::list<TopoDS_Wire>& wires) const;
     void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
     void sliceSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
     void connectEdges (const std::list<TopoDS_Edge>& edges, std::list<TopoDS_Wire>& wires) const;
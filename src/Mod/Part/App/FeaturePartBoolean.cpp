@@ -24,7 +24,6 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <BRepAlgoAPI_BooleanOperation.hxx>
-# include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
 # include <memory>
 #endif
@@ -87,7 +86,7 @@ App::DocumentObjectExecReturn *Boolean::execute(void)
         if (ToolShape.IsNull())
             throw NullShapeException("Tool shape is null");
 
-        std::unique_ptr<BRepAlgoAPI_BooleanOperation> mkBool(makeOperation(BaseShape, ToolShape));
+        std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkBool = makeOperation(BaseShape, ToolShape);
         if (!mkBool->IsDone()) {
             std::stringstream error;
             error << "Boolean operation failed";
@@ -107,8 +106,7 @@ App::DocumentObjectExecReturn *Boolean::execute(void)
             .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
 
         if (hGrp->GetBool("CheckModel", false)) {
-            BRepCheck_Analyzer aChecker(resShape);
-            if (! aChecker.IsValid() ) {
+            if (!TopoShape(resShape).isValid()) {
                 return new App::DocumentObjectExecReturn("Resulting shape is invalid");
             }
         }
@@ -24,6 +24,7 @@
 #ifndef PART_FEATUREPARTBOOLEAN_H
 #define PART_FEATUREPARTBOOLEAN_H
 
+#include <memory>
 #include <App/PropertyLinks.h>
 #include "PartFeature.h"
 
@@ -57,7 +58,7 @@ public:
     }
 
 protected:
-    virtual BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const = 0;
+    virtual std::shared_ptr<BRepAlgoAPI_BooleanOperation> makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const = 0;
 };
 
 }
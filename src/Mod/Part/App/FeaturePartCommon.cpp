@@ -25,7 +25,6 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <BRepAlgoAPI_Common.hxx>
-# include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Iterator.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
@@ -48,10 +47,13 @@ Common::Common(void)
 {
 }
 
-BRepAlgoAPI_BooleanOperation* Common::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+std::shared_ptr<BRepAlgoAPI_BooleanOperation> Common::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a section operation:
-    return new BRepAlgoAPI_Common(base, tool);
+    TopTools_ListOfShape shapeArguments,shapeTools;
+    shapeArguments.Append(base);
+    shapeTools.Append(tool);
+    return TopoShape::makeBoolean(BOPAlgo_COMMON, shapeArguments, shapeTools);
 }
 
 // ----------------------------------------------------
@@ -147,8 +149,7 @@ App::DocumentObjectExecReturn *MultiCommon::execute(void)
             Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
                 .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
             if (hGrp->GetBool("CheckModel", false)) {
-                 BRepCheck_Analyzer aChecker(resShape);
-                 if (! aChecker.IsValid() ) {
+                 if (!TopoShape(resShape).isValid()) {
                      return new App::DocumentObjectExecReturn("Resulting shape is invalid");
                  }
             }
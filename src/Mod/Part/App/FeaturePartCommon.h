@@ -41,7 +41,7 @@ public:
     //@{
     /// recalculate the Feature
 protected:
-    BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const;
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const;
     //@}
 };
 
@@ -40,8 +40,11 @@ Cut::Cut(void)
 {
 }
 
-BRepAlgoAPI_BooleanOperation* Cut::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+std::shared_ptr<BRepAlgoAPI_BooleanOperation> Cut::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a cut operation:
-    return new BRepAlgoAPI_Cut(base, tool);
+    TopTools_ListOfShape shapeArguments,shapeTools;
+    shapeArguments.Append(base);
+    shapeTools.Append(tool);
+    return TopoShape::makeBoolean(BOPAlgo_CUT, shapeArguments, shapeTools);
 }
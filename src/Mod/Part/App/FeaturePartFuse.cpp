@@ -24,7 +24,6 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 # include <BRepAlgoAPI_Fuse.hxx>
-# include <BRepCheck_Analyzer.hxx>
 # include <Standard_Failure.hxx>
 # include <TopoDS_Iterator.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
@@ -47,10 +46,13 @@ Fuse::Fuse(void)
 {
 }
 
-BRepAlgoAPI_BooleanOperation* Fuse::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+std::shared_ptr<BRepAlgoAPI_BooleanOperation> Fuse::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a fuse operation:
-    return new BRepAlgoAPI_Fuse(base, tool);
+    TopTools_ListOfShape shapeArguments,shapeTools;
+    shapeArguments.Append(base);
+    shapeTools.Append(tool);
+    return TopoShape::makeBoolean(BOPAlgo_FUSE, shapeArguments, shapeTools);
 }
 
 // ----------------------------------------------------
@@ -142,7 +144,6 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
                 }
             }
 #else
-            BRepAlgoAPI_Fuse mkFuse;
             TopTools_ListOfShape shapeArguments,shapeTools;
             const TopoDS_Shape& shape = s.front();
             if (shape.IsNull())
@@ -155,15 +156,14 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
                 shapeTools.Append(*it);
             }
 
-            mkFuse.SetArguments(shapeArguments);
-            mkFuse.SetTools(shapeTools);
-            mkFuse.Build();
-            if (!mkFuse.IsDone())
+            std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkFuse =
+                TopoShape::makeBoolean(BOPAlgo_FUSE, shapeArguments, shapeTools);
+            if (!mkFuse->IsDone())
                 throw Base::RuntimeError("MultiFusion failed");
 
-            TopoDS_Shape resShape = mkFuse.Shape();
+            TopoDS_Shape resShape = mkFuse->Shape();
             for (std::vector<TopoDS_Shape>::iterator it = s.begin(); it != s.end(); ++it) {
-                history.push_back(buildHistory(mkFuse, TopAbs_FACE, resShape, *it));
+                history.push_back(buildHistory(*mkFuse, TopAbs_FACE, resShape, *it));
             }
 #endif
             if (resShape.IsNull())
@@ -172,8 +172,7 @@ App::DocumentObjectExecReturn *MultiFuse::execute(void)
             Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
                 .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
             if (hGrp->GetBool("CheckModel", false)) {
-                BRepCheck_Analyzer aChecker(resShape);
-                if (! aChecker.IsValid() ) {
+                if (!TopoShape(resShape).isValid()) {
                     return new App::DocumentObjectExecReturn("Resulting shape is invalid");
                 }
             }
@@ -48,20 +48,16 @@ short Section::mustExecute() const
     return 0;
 }
 
-BRepAlgoAPI_BooleanOperation* Section::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
+std::shared_ptr<BRepAlgoAPI_BooleanOperation> Section::makeOperation(const TopoDS_Shape& base, const TopoDS_Shape& tool) const
 {
     // Let's call algorithm computing a section operation:
-#if OCC_VERSION_HEX < 0x060900
-    return new BRepAlgoAPI_Section(base, tool);
-#else
     bool approx = Approximation.getValue();
-    BRepAlgoAPI_Section* mkSection = new BRepAlgoAPI_Section();
-    mkSection->Init1(base);
-    mkSection->Init2(tool);
-    mkSection->Approximation(approx);
-    mkSection->Build();
+    TopTools_ListOfShape shapeArguments,shapeTools;
+    shapeArguments.Append(base);
+    shapeTools.Append(tool);
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkSection =
+        TopoShape::makeBoolean(BOPAlgo_SECTION, shapeArguments, shapeTools, 0.0, approx);
     if (!mkSection->IsDone())
         throw Base::RuntimeError("Section failed");
     return mkSection;
-#endif
 }
@@ -45,7 +45,7 @@ public:
     /// recalculate the Feature
     short mustExecute() const;
 protected:
-    BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const;
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const;
     //@}
 };
 
@@ -25,6 +25,7 @@
 #define __OpenCascadeAll__
 
 // OpenCASCADE
+#include <Standard.hxx>
 #include <Standard_AbortiveTransaction.hxx>
 #include <Standard_Address.hxx>
 #include <Standard_Boolean.hxx>
@@ -507,6 +508,10 @@
 # include <BRepAlgoAPI_Defeaturing.hxx>
 #endif
 
+#if OCC_VERSION_HEX >= 0x070200
+# include <BOPAlgo_PaveFiller.hxx>
+#endif
+
 #if OCC_VERSION_HEX >= 0x060800
 #include <OSD_OpenFile.hxx>
 #endif
@@ -0,0 +1,72 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+# include <exception>
+# include <vector>
+# include <Standard.hxx>
+# include <Standard_Version.hxx>
+# include <QThreadPool>
+# include <QtConcurrentMap>
+#endif
+
+#include "Parallel.h"
+
+using namespace Part;
+
+int Parallel::threadCount()
+{
+    return QThreadPool::globalInstance()->maxThreadCount();
+}
+
+void Parallel::forEach(std::size_t count, const std::function<void(std::size_t)>& job)
+{
+    if (count < 2 || threadCount() < 2) {
+        for (std::size_t i = 0; i < count; i++)
+            job(i);
+        return;
+    }
+
+#if OCC_VERSION_HEX < 0x070000
+    Standard::SetReentrant(Standard_True);
+#endif
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::size_t> indices(count);
+    for (std::size_t i = 0; i < count; i++)
+        indices[i] = i;
+    QtConcurrent::blockingMap(indices, [&](std::size_t i) {
+        try {
+            job(i);
+        }
+        catch (...) {
+            // rethrown below in the calling thread
+            errors[i] = std::current_exception();
+        }
+    });
+
+    for (std::size_t i = 0; i < count; i++) {
+        if (errors[i])
+            std::rethrow_exception(errors[i]);
+    }
+}
@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PART_PARALLEL_H
+#define PART_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace Part
+{
+
+/** Runs independent jobs working on OCC shapes on the global thread pool
+ * The jobs must not share any shape that they may modify, e.g. a boolean
+ * operation may update the tolerances of its arguments.
+ */
+class PartExport Parallel
+{
+public:
+    /// The number of jobs that can run at the same time
+    static int threadCount();
+    /** Calls \a job for every index in [0, \a count)
+     * If there is only one job or one thread the jobs are run in the calling
+     * thread. Otherwise the call blocks until all jobs are done. If jobs
+     * throw, all the other jobs still run, and the exception of the job with
+     * the lowest index is rethrown in the calling thread.
+     */
+    static void forEach(std::size_t count, const std::function<void(std::size_t)>& job);
+};
+
+} //namespace Part
+
+#endif // PART_PARALLEL_H
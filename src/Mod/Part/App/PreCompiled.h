@@ -61,6 +61,8 @@
 #include <list>
 #include <set>
 #include <map>
+#include <algorithm>
+#include <exception>
 
 #include <fstream>
 #include <string>
@@ -70,15 +72,20 @@
 
 #include <cmath>
 #include <ctime>
+#include <mutex>
 
 // QT
 #include <QtGlobal>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 // Boost
 #include <boost/signals2.hpp>
 #include <boost/bind.hpp>
 
 #include <boost/tuple/tuple.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/unordered_map.hpp>
 #include <boost/utility.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
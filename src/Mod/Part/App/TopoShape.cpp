@@ -24,8 +24,13 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <cmath>
 # include <cstdlib>
+# include <list>
+# include <mutex>
+# include <boost/functional/hash.hpp>
+# include <boost/unordered_map.hpp>
 # include <sstream>
 # include <QString>
 
@@ -176,6 +181,10 @@
 # include <BOPAlgo_ListOfCheckResult.hxx>
 #endif
 
+#if OCC_VERSION_HEX >= 0x070200
+# include <BOPAlgo_PaveFiller.hxx>
+#endif
+
 #if OCC_VERSION_HEX >= 0x070300
 # include <BRepAlgoAPI_Defeaturing.hxx>
 #endif
@@ -186,10 +195,13 @@
 #include <Base/Exception.h>
 #include <Base/Tools.h>
 #include <Base/Console.h>
+#include <Base/Parameter.h>
+#include <App/Application.h>
 #include <App/Material.h>
 
 #include "TopoShape.h"
 #include "CrossSection.h"
+#include "Parallel.h"
 #include "TopoShapeFacePy.h"
 #include "TopoShapeEdgePy.h"
 #include "TopoShapeVertexPy.h"
@@ -1216,10 +1228,344 @@ bool TopoShape::isNull() const
     return this->_Shape.IsNull() ? true : false;
 }
 
+namespace Part {
+// A hash of the sub-shapes of a shape with their tolerances, curves, surfaces
+// and vertex points. It changes when the shape is modified in place, e.g. by
+// BRep_Builder or ShapeFix, which keeps the TopoDS_Shape the same.
+static std::size_t shapeFingerprint(const TopoDS_Shape& shape)
+{
+    std::size_t seed = 0;
+    TopLoc_Location loc;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(xp.Current());
+        boost::hash_combine(seed, face.HashCode(IntegerLast()));
+        boost::hash_combine(seed, BRep_Tool::Tolerance(face));
+        boost::hash_combine(seed, ::HashCode(BRep_Tool::Surface(face, loc), IntegerLast()));
+    }
+    for (TopExp_Explorer xp(shape, TopAbs_EDGE); xp.More(); xp.Next()) {
+        const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+        Standard_Real first = 0, last = 0;
+        boost::hash_combine(seed, edge.HashCode(IntegerLast()));
+        boost::hash_combine(seed, BRep_Tool::Tolerance(edge));
+        boost::hash_combine(seed, ::HashCode(BRep_Tool::Curve(edge, loc, first, last), IntegerLast()));
+        boost::hash_combine(seed, first);
+        boost::hash_combine(seed, last);
+    }
+    for (TopExp_Explorer xp(shape, TopAbs_VERTEX); xp.More(); xp.Next()) {
+        const TopoDS_Vertex& vertex = TopoDS::Vertex(xp.Current());
+        gp_Pnt pnt = BRep_Tool::Pnt(vertex);
+        boost::hash_combine(seed, vertex.HashCode(IntegerLast()));
+        boost::hash_combine(seed, BRep_Tool::Tolerance(vertex));
+        boost::hash_combine(seed, pnt.X());
+        boost::hash_combine(seed, pnt.Y());
+        boost::hash_combine(seed, pnt.Z());
+    }
+    return seed;
+}
+
+// The check results of the last few shapes. A shape is only found again if
+// it is the same TopoDS_Shape with the same fingerprint, so any operation
+// that builds a new shape or modifies one in place misses the cache.
+class ShapeCheckCache
+{
+public:
+    struct Entry
+    {
+        std::size_t fingerprint; // shapeFingerprint() of the checked shape
+        int valid;          // result of BRepCheck_Analyzer, -1 if not known yet
+        bool hasReport;     // whether report holds the errors of an invalid shape
+        std::string report;
+        int bopValid;       // result of the BOP check, -1 if not known yet
+        std::string bopReport;
+
+        Entry() : fingerprint(0), valid(-1), hasReport(false), bopValid(-1)
+        {
+        }
+    };
+
+    static ShapeCheckCache& instance()
+    {
+        static ShapeCheckCache cache;
+        return cache;
+    }
+
+    bool get(const TopoDS_Shape& shape, std::size_t fingerprint, Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::list<std::pair<TopoDS_Shape, Entry> >::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if (it->first.IsEqual(shape) && it->second.fingerprint == fingerprint) {
+                entry = it->second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // replaces any entry of the shape, also one of an older fingerprint
+    void put(const TopoDS_Shape& shape, const Entry& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::list<std::pair<TopoDS_Shape, Entry> >::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if (it->first.IsEqual(shape)) {
+                entries.erase(it);
+                break;
+            }
+        }
+        entries.push_front(std::make_pair(shape, entry));
+        // the entries keep the shapes alive
+        if (entries.size() > 32)
+            entries.pop_back();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+    }
+
+private:
+    std::mutex mutex;
+    std::list<std::pair<TopoDS_Shape, Entry> > entries;
+};
+
+// Writes the errors found by the analyzer for all sub-shapes of the shape
+static void reportCheckErrors(const BRepCheck_Analyzer& checker, const TopoDS_Shape& shape, std::ostream& str)
+{
+    std::vector<TopoDS_Shape> shapes;
+
+    TopTools_IndexedMapOfShape vertexOfShape;
+    TopExp::MapShapes(shape, TopAbs_VERTEX, vertexOfShape);
+    for (int i = 1; i <= vertexOfShape.Extent();++i)
+        shapes.push_back(vertexOfShape(i));
+
+    TopTools_IndexedMapOfShape edgeOfShape;
+    TopExp::MapShapes(shape, TopAbs_EDGE, edgeOfShape);
+    for (int i = 1; i <= edgeOfShape.Extent();++i)
+        shapes.push_back(edgeOfShape(i));
+
+    TopTools_IndexedMapOfShape wireOfShape;
+    TopExp::MapShapes(shape, TopAbs_WIRE, wireOfShape);
+    for (int i = 1; i <= wireOfShape.Extent();++i)
+        shapes.push_back(wireOfShape(i));
+
+    TopTools_IndexedMapOfShape faceOfShape;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceOfShape);
+    for (int i = 1; i <= faceOfShape.Extent();++i)
+        shapes.push_back(faceOfShape(i));
+
+    TopTools_IndexedMapOfShape shellOfShape;
+    TopExp::MapShapes(shape, TopAbs_SHELL, shellOfShape);
+    for (int i = 1; i <= shellOfShape.Extent();++i)
+        shapes.push_back(shellOfShape(i));
+
+    TopTools_IndexedMapOfShape solidOfShape;
+    TopExp::MapShapes(shape, TopAbs_SOLID, solidOfShape);
+    for (int i = 1; i <= solidOfShape.Extent();++i)
+        shapes.push_back(solidOfShape(i));
+
+    TopTools_IndexedMapOfShape compOfShape;
+    TopExp::MapShapes(shape, TopAbs_COMPOUND, compOfShape);
+    for (int i = 1; i <= compOfShape.Extent();++i)
+        shapes.push_back(compOfShape(i));
+
+    TopTools_IndexedMapOfShape compsOfShape;
+    TopExp::MapShapes(shape, TopAbs_COMPSOLID, compsOfShape);
+    for (int i = 1; i <= compsOfShape.Extent();++i)
+        shapes.push_back(compsOfShape(i));
+
+    for (std::vector<TopoDS_Shape>::iterator xp = shapes.begin(); xp != shapes.end(); ++xp) {
+        if (!checker.IsValid(*xp)) {
+            const Handle(BRepCheck_Result)& result = checker.Result(*xp);
+            if (result.IsNull())
+                continue;
+            const BRepCheck_ListOfStatus& status = result->StatusOnShape(*xp);
+
+            BRepCheck_ListIteratorOfListOfStatus it(status);
+            while (it.More()) {
+                BRepCheck_Status& val = it.Value();
+                switch (val)
+                {
+                case BRepCheck_NoError:
+                    str << "No error" << std::endl;
+                    break;
+                case BRepCheck_InvalidPointOnCurve:
+                    str << "Invalid point on curve" << std::endl;
+                    break;
+                case BRepCheck_InvalidPointOnCurveOnSurface:
+                    str << "Invalid point on curve on surface" << std::endl;
+                    break;
+                case BRepCheck_InvalidPointOnSurface:
+                    str << "Invalid point on surface" << std::endl;
+                    break;
+                case BRepCheck_No3DCurve:
+                    str << "No 3D curve" << std::endl;
+                    break;
+                case BRepCheck_Multiple3DCurve:
+                    str << "Multiple 3D curve" << std::endl;
+                    break;
+                case BRepCheck_Invalid3DCurve:
+                    str << "Invalid 3D curve" << std::endl;
+                    break;
+                case BRepCheck_NoCurveOnSurface:
+                    str << "No curve on surface" << std::endl;
+                    break;
+                case BRepCheck_InvalidCurveOnSurface:
+                    str << "Invalid curve on surface" << std::endl;
+                    break;
+                case BRepCheck_InvalidCurveOnClosedSurface:
+                    str << "Invalid curve on closed surface" << std::endl;
+                    break;
+                case BRepCheck_InvalidSameRangeFlag:
+                    str << "Invalid same-range flag" << std::endl;
+                    break;
+                case BRepCheck_InvalidSameParameterFlag:
+                    str << "Invalid same-parameter flag" << std::endl;
+                    break;
+                case BRepCheck_InvalidDegeneratedFlag:
+                    str << "Invalid degenerated flag" << std::endl;
+                    break;
+                case BRepCheck_FreeEdge:
+                    str << "Free edge" << std::endl;
+                    break;
+                case BRepCheck_InvalidMultiConnexity:
+                    str << "Invalid multi-connexity" << std::endl;
+                    break;
+                case BRepCheck_InvalidRange:
+                    str << "Invalid range" << std::endl;
+                    break;
+                case BRepCheck_EmptyWire:
+                    str << "Empty wire" << std::endl;
+                    break;
+                case BRepCheck_RedundantEdge:
+                    str << "Redundant edge" << std::endl;
+                    break;
+                case BRepCheck_SelfIntersectingWire:
+                    str << "Self-intersecting wire" << std::endl;
+                    break;
+                case BRepCheck_NoSurface:
+                    str << "No surface" << std::endl;
+                    break;
+                case BRepCheck_InvalidWire:
+                    str << "Invalid wires" << std::endl;
+                    break;
+                case BRepCheck_RedundantWire:
+                    str << "Redundant wires" << std::endl;
+                    break;
+                case BRepCheck_IntersectingWires:
+                    str << "Intersecting wires" << std::endl;
+                    break;
+                case BRepCheck_InvalidImbricationOfWires:
+                    str << "Invalid imbrication of wires" << std::endl;
+                    break;
+                case BRepCheck_EmptyShell:
+                    str << "Empty shell" << std::endl;
+                    break;
+                case BRepCheck_RedundantFace:
+                    str << "Redundant face" << std::endl;
+                    break;
+                case BRepCheck_UnorientableShape:
+                    str << "Unorientable shape" << std::endl;
+                    break;
+                case BRepCheck_NotClosed:
+                    str << "Not closed" << std::endl;
+                    break;
+                case BRepCheck_NotConnected:
+                    str << "Not connected" << std::endl;
+                    break;
+                case BRepCheck_SubshapeNotInShape:
+                    str << "Sub-shape not in shape" << std::endl;
+                    break;
+                case BRepCheck_BadOrientation:
+                    str << "Bad orientation" << std::endl;
+                    break;
+                case BRepCheck_BadOrientationOfSubshape:
+                    str << "Bad orientation of sub-shape" << std::endl;
+                    break;
+                case BRepCheck_InvalidToleranceValue:
+                    str << "Invalid tolerance value" << std::endl;
+                    break;
+                case BRepCheck_CheckFail:
+                    str << "Check failed" << std::endl;
+                    break;
+                default:
+                    str << "Undetermined error" << std::endl;
+                    break;
+                }
+
+                it.Next();
+            }
+        }
+    }
+
+}
+
+// The sub-shapes of a compound are checked independently of each other, so
+// the children of a compound are checked in parallel. If the shape is invalid
+// and report is given, the errors are written to it.
+static bool checkShape(const TopoDS_Shape& shape, std::ostream* report)
+{
+    std::vector<TopoDS_Shape> children;
+    if (shape.ShapeType() == TopAbs_COMPOUND) {
+        for (TopoDS_Iterator it(shape); it.More(); it.Next())
+            children.push_back(it.Value());
+    }
+    if (children.size() == 1 && !report)
+        return checkShape(children.front(), report);
+
+#if OCC_VERSION_HEX < 0x070000
+    // the analyzer fills the caches of the BSplines it evaluates, which isn't
+    // thread safe for a BSpline shared by several children before OCC 7
+    bool parallel = false;
+#else
+    bool parallel = Parallel::threadCount() > 1;
+#endif
+    if (children.size() < 2 || !parallel) {
+        BRepCheck_Analyzer aChecker(shape);
+        if (aChecker.IsValid())
+            return true;
+        if (report)
+            reportCheckErrors(aChecker, shape, *report);
+        return false;
+    }
+
+    std::vector<char> valid(children.size(), 0);
+    Parallel::forEach(children.size(), [&](std::size_t i) {
+        BRepCheck_Analyzer aChecker(children[i]);
+        valid[i] = aChecker.IsValid() ? 1 : 0;
+    });
+
+    bool isValid = std::find(valid.begin(), valid.end(), 0) == valid.end();
+
+    // the errors are listed by the type of the sub-shapes of the whole shape
+    if (!isValid && report) {
+        BRepCheck_Analyzer aChecker(shape);
+        reportCheckErrors(aChecker, shape, *report);
+    }
+    return isValid;
+}
+}
+
 bool TopoShape::isValid() const
 {
-    BRepCheck_Analyzer aChecker(this->_Shape);
-    return aChecker.IsValid() ? true : false;
+    if (this->_Shape.IsNull()) {
+        BRepCheck_Analyzer aChecker(this->_Shape);
+        return aChecker.IsValid() ? true : false;
+    }
+
+    ShapeCheckCache::Entry entry;
+    std::size_t fingerprint = shapeFingerprint(this->_Shape);
+    if (!ShapeCheckCache::instance().get(this->_Shape, fingerprint, entry))
+        entry.fingerprint = fingerprint;
+    if (entry.valid < 0) {
+        entry.valid = checkShape(this->_Shape, 0) ? 1 : 0;
+        ShapeCheckCache::instance().put(this->_Shape, entry);
+    }
+    return entry.valid > 0;
+}
+
+void TopoShape::clearCheckCache()
+{
+    ShapeCheckCache::instance().clear();
 }
 
 namespace Part {
@@ -1255,233 +1601,97 @@ std::vector<std::string> buildBOPCheckResultVector()
   results.push_back("BOPAlgo NotValid");                   //BOPAlgo_NotValid
   return results;
 }
-}
 
-bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
+// Runs the BOP argument check on a copy of the shape and writes the errors found
+static bool checkBopShape(const TopoDS_Shape& shape, std::ostream& str)
 {
-    if (!this->_Shape.IsNull()) {
-        BRepCheck_Analyzer aChecker(this->_Shape);
-        if (!aChecker.IsValid()) {
-            std::vector<TopoDS_Shape> shapes;
-
-            TopTools_IndexedMapOfShape vertexOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_VERTEX, vertexOfShape);
-            for (int i = 1; i <= vertexOfShape.Extent();++i)
-                shapes.push_back(vertexOfShape(i));
-
-            TopTools_IndexedMapOfShape edgeOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_EDGE, edgeOfShape);
-            for (int i = 1; i <= edgeOfShape.Extent();++i)
-                shapes.push_back(edgeOfShape(i));
-
-            TopTools_IndexedMapOfShape wireOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_WIRE, wireOfShape);
-            for (int i = 1; i <= wireOfShape.Extent();++i)
-                shapes.push_back(wireOfShape(i));
-
-            TopTools_IndexedMapOfShape faceOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_FACE, faceOfShape);
-            for (int i = 1; i <= faceOfShape.Extent();++i)
-                shapes.push_back(faceOfShape(i));
-
-            TopTools_IndexedMapOfShape shellOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_SHELL, shellOfShape);
-            for (int i = 1; i <= shellOfShape.Extent();++i)
-                shapes.push_back(shellOfShape(i));
-
-            TopTools_IndexedMapOfShape solidOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_SOLID, solidOfShape);
-            for (int i = 1; i <= solidOfShape.Extent();++i)
-                shapes.push_back(solidOfShape(i));
-
-            TopTools_IndexedMapOfShape compOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_COMPOUND, compOfShape);
-            for (int i = 1; i <= compOfShape.Extent();++i)
-                shapes.push_back(compOfShape(i));
-
-            TopTools_IndexedMapOfShape compsOfShape;
-            TopExp::MapShapes(this->_Shape, TopAbs_COMPSOLID, compsOfShape);
-            for (int i = 1; i <= compsOfShape.Extent();++i)
-                shapes.push_back(compsOfShape(i));
-
-            for (std::vector<TopoDS_Shape>::iterator xp = shapes.begin(); xp != shapes.end(); ++xp) {
-                if (!aChecker.IsValid(*xp)) {
-                    const Handle(BRepCheck_Result)& result = aChecker.Result(*xp);
-                    if (result.IsNull())
-                        continue;
-                    const BRepCheck_ListOfStatus& status = result->StatusOnShape(*xp);
-
-                    BRepCheck_ListIteratorOfListOfStatus it(status);
-                    while (it.More()) {
-                        BRepCheck_Status& val = it.Value();
-                        switch (val)
-                        {
-                        case BRepCheck_NoError:
-                            str << "No error" << std::endl;
-                            break;
-                        case BRepCheck_InvalidPointOnCurve:
-                            str << "Invalid point on curve" << std::endl;
-                            break;
-                        case BRepCheck_InvalidPointOnCurveOnSurface:
-                            str << "Invalid point on curve on surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidPointOnSurface:
-                            str << "Invalid point on surface" << std::endl;
-                            break;
-                        case BRepCheck_No3DCurve:
-                            str << "No 3D curve" << std::endl;
-                            break;
-                        case BRepCheck_Multiple3DCurve:
-                            str << "Multiple 3D curve" << std::endl;
-                            break;
-                        case BRepCheck_Invalid3DCurve:
-                            str << "Invalid 3D curve" << std::endl;
-                            break;
-                        case BRepCheck_NoCurveOnSurface:
-                            str << "No curve on surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidCurveOnSurface:
-                            str << "Invalid curve on surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidCurveOnClosedSurface:
-                            str << "Invalid curve on closed surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidSameRangeFlag:
-                            str << "Invalid same-range flag" << std::endl;
-                            break;
-                        case BRepCheck_InvalidSameParameterFlag:
-                            str << "Invalid same-parameter flag" << std::endl;
-                            break;
-                        case BRepCheck_InvalidDegeneratedFlag:
-                            str << "Invalid degenerated flag" << std::endl;
-                            break;
-                        case BRepCheck_FreeEdge:
-                            str << "Free edge" << std::endl;
-                            break;
-                        case BRepCheck_InvalidMultiConnexity:
-                            str << "Invalid multi-connexity" << std::endl;
-                            break;
-                        case BRepCheck_InvalidRange:
-                            str << "Invalid range" << std::endl;
-                            break;
-                        case BRepCheck_EmptyWire:
-                            str << "Empty wire" << std::endl;
-                            break;
-                        case BRepCheck_RedundantEdge:
-                            str << "Redundant edge" << std::endl;
-                            break;
-                        case BRepCheck_SelfIntersectingWire:
-                            str << "Self-intersecting wire" << std::endl;
-                            break;
-                        case BRepCheck_NoSurface:
-                            str << "No surface" << std::endl;
-                            break;
-                        case BRepCheck_InvalidWire:
-                            str << "Invalid wires" << std::endl;
-                            break;
-                        case BRepCheck_RedundantWire:
-                            str << "Redundant wires" << std::endl;
-                            break;
-                        case BRepCheck_IntersectingWires:
-                            str << "Intersecting wires" << std::endl;
-                            break;
-                        case BRepCheck_InvalidImbricationOfWires:
-                            str << "Invalid imbrication of wires" << std::endl;
-                            break;
-                        case BRepCheck_EmptyShell:
-                            str << "Empty shell" << std::endl;
-                            break;
-                        case BRepCheck_RedundantFace:
-                            str << "Redundant face" << std::endl;
-                            break;
-                        case BRepCheck_UnorientableShape:
-                            str << "Unorientable shape" << std::endl;
-                            break;
-                        case BRepCheck_NotClosed:
-                            str << "Not closed" << std::endl;
-                            break;
-                        case BRepCheck_NotConnected:
-                            str << "Not connected" << std::endl;
-                            break;
-                        case BRepCheck_SubshapeNotInShape:
-                            str << "Sub-shape not in shape" << std::endl;
-                            break;
-                        case BRepCheck_BadOrientation:
-                            str << "Bad orientation" << std::endl;
-                            break;
-                        case BRepCheck_BadOrientationOfSubshape:
-                            str << "Bad orientation of sub-shape" << std::endl;
-                            break;
-                        case BRepCheck_InvalidToleranceValue:
-                            str << "Invalid tolerance value" << std::endl;
-                            break;
-                        case BRepCheck_CheckFail:
-                            str << "Check failed" << std::endl;
-                            break;
-                        default:
-                            str << "Undetermined error" << std::endl;
-                            break;
-                        }
-
-                        it.Next();
-                    }
-                }
-            }
-
-            return false; // errors detected
-        }
-        else if (runBopCheck) {
-            // Copied from TaskCheckGeometryResults::goBOPSingleCheck
+    // Copied from TaskCheckGeometryResults::goBOPSingleCheck
 #if OCC_VERSION_HEX >= 0x060600
-            TopoDS_Shape BOPCopy = BRepBuilderAPI_Copy(this->_Shape).Shape();
-            BOPAlgo_ArgumentAnalyzer BOPCheck;
-          //   BOPCheck.StopOnFirstFaulty() = true; //this doesn't run any faster but gives us less results.
-            BOPCheck.SetShape1(BOPCopy);
-            //all settings are false by default. so only turn on what we want.
-            BOPCheck.ArgumentTypeMode() = true;
-            BOPCheck.SelfInterMode() = true;
-            BOPCheck.SmallEdgeMode() = true;
-            BOPCheck.RebuildFaceMode() = true;
+    TopoDS_Shape BOPCopy = BRepBuilderAPI_Copy(shape).Shape();
+    BOPAlgo_ArgumentAnalyzer BOPCheck;
+  //   BOPCheck.StopOnFirstFaulty() = true; //this doesn't run any faster but gives us less results.
+    BOPCheck.SetShape1(BOPCopy);
+    //all settings are false by default. so only turn on what we want.
+    BOPCheck.ArgumentTypeMode() = true;
+    BOPCheck.SelfInterMode() = true;
+    BOPCheck.SmallEdgeMode() = true;
+    BOPCheck.RebuildFaceMode() = true;
 #if OCC_VERSION_HEX >= 0x060700
-            BOPCheck.ContinuityMode() = true;
+    BOPCheck.ContinuityMode() = true;
 #endif
 #if OCC_VERSION_HEX >= 0x060900
-            BOPCheck.SetParallelMode(true); //this doesn't help for speed right now(occt 6.9.1).
-            BOPCheck.TangentMode() = true; //these 4 new tests add about 5% processing time.
-            BOPCheck.MergeVertexMode() = true;
-            BOPCheck.CurveOnSurfaceMode() = true;
-            BOPCheck.MergeEdgeMode() = true;
+    BOPCheck.SetParallelMode(true); //this doesn't help for speed right now(occt 6.9.1).
+    BOPCheck.TangentMode() = true; //these 4 new tests add about 5% processing time.
+    BOPCheck.MergeVertexMode() = true;
+    BOPCheck.CurveOnSurfaceMode() = true;
+    BOPCheck.MergeEdgeMode() = true;
 #endif
 
-            BOPCheck.Perform();
+    BOPCheck.Perform();
 
-            if (!BOPCheck.HasFaulty())
-                return true;
+    if (!BOPCheck.HasFaulty())
+        return true;
 
-            str << "BOP check found the following errors:" << std::endl;
-            static std::vector<std::string> shapeEnumToString = buildShapeEnumVector();
-            static std::vector<std::string> bopEnumToString = buildBOPCheckResultVector();
-            const BOPAlgo_ListOfCheckResult &BOPResults = BOPCheck.GetCheckResult();
-            BOPAlgo_ListIteratorOfListOfCheckResult BOPResultsIt(BOPResults);
-            for (; BOPResultsIt.More(); BOPResultsIt.Next()) {
-                const BOPAlgo_CheckResult &current = BOPResultsIt.Value();
+    str << "BOP check found the following errors:" << std::endl;
+    static std::vector<std::string> shapeEnumToString = buildShapeEnumVector();
+    static std::vector<std::string> bopEnumToString = buildBOPCheckResultVector();
+    const BOPAlgo_ListOfCheckResult &BOPResults = BOPCheck.GetCheckResult();
+    BOPAlgo_ListIteratorOfListOfCheckResult BOPResultsIt(BOPResults);
+    for (; BOPResultsIt.More(); BOPResultsIt.Next()) {
+        const BOPAlgo_CheckResult &current = BOPResultsIt.Value();
 
 #if OCC_VERSION_HEX < 0x070000
-                const BOPCol_ListOfShape &faultyShapes1 = current.GetFaultyShapes1();
-                BOPCol_ListIteratorOfListOfShape faultyShapes1It(faultyShapes1);
+        const BOPCol_ListOfShape &faultyShapes1 = current.GetFaultyShapes1();
+        BOPCol_ListIteratorOfListOfShape faultyShapes1It(faultyShapes1);
 #else
-                const TopTools_ListOfShape &faultyShapes1 = current.GetFaultyShapes1();
-                TopTools_ListIteratorOfListOfShape faultyShapes1It(faultyShapes1);
+        const TopTools_ListOfShape &faultyShapes1 = current.GetFaultyShapes1();
+        TopTools_ListIteratorOfListOfShape faultyShapes1It(faultyShapes1);
 #endif
-                for (;faultyShapes1It.More(); faultyShapes1It.Next()) {
-                    const TopoDS_Shape &faultyShape = faultyShapes1It.Value();
-                    str << "Error in " << shapeEnumToString[faultyShape.ShapeType()] << ": ";
-                    str << bopEnumToString[current.GetCheckStatus()] << std::endl;
-                }
-            }
+        for (;faultyShapes1It.More(); faultyShapes1It.Next()) {
+            const TopoDS_Shape &faultyShape = faultyShapes1It.Value();
+            str << "Error in " << shapeEnumToString[faultyShape.ShapeType()] << ": ";
+            str << bopEnumToString[current.GetCheckStatus()] << std::endl;
+        }
+    }
 
-            return false;
+    return false;
+#else
+    (void)shape;
+    (void)str;
+    return true;
 #endif // 0x060600
+}
+}
+
+bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
+{
+    if (!this->_Shape.IsNull()) {
+        ShapeCheckCache::Entry entry;
+        std::size_t fingerprint = shapeFingerprint(this->_Shape);
+        if (!ShapeCheckCache::instance().get(this->_Shape, fingerprint, entry))
+            entry.fingerprint = fingerprint;
+        if (entry.valid < 0 || (entry.valid == 0 && !entry.hasReport)) {
+            std::stringstream report;
+            entry.valid = checkShape(this->_Shape, &report) ? 1 : 0;
+            entry.hasReport = true;
+            entry.report = report.str();
+            ShapeCheckCache::instance().put(this->_Shape, entry);
+        }
+
+        if (!entry.valid) {
+            str << entry.report;
+            return false; // errors detected
+        }
+        else if (runBopCheck) {
+            if (entry.bopValid < 0) {
+                std::stringstream report;
+                entry.bopValid = checkBopShape(this->_Shape, report) ? 1 : 0;
+                entry.bopReport = report.str();
+                ShapeCheckCache::instance().put(this->_Shape, entry);
+            }
+
+            str << entry.bopReport;
+            return entry.bopValid > 0;
         }
     }
 
@@ -1540,6 +1750,322 @@ bool TopoShape::isClosed() const
     return closed;
 }
 
+// ------------------------------------------------
+
+namespace {
+
+#if OCC_VERSION_HEX >= 0x060900
+// Settings of the boolean operations from the boolean preferences
+struct BooleanOptions
+{
+    bool runParallel;
+    bool useOBB;
+    bool cacheIntersection;
+
+    BooleanOptions()
+    {
+        Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+            .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/Part/Boolean");
+        runParallel = hGrp->GetBool("RunParallel", true);
+        useOBB = hGrp->GetBool("UseOBB", false);
+        cacheIntersection = hGrp->GetBool("CacheIntersection", true);
+    }
+};
+
+#if OCC_VERSION_HEX >= 0x070200
+// The intersection of the shapes of a boolean operation. It doesn't depend on
+// the type of the operation, nor on which shapes are arguments and which are
+// tools, so it can be used to build any boolean operation of the same shapes,
+// except a section, which needs its own attributes on the filler.
+struct PaveFillerEntry
+{
+    std::vector<TopoDS_Shape> shapes; // the shapes as passed to makeBoolean
+    std::vector<TopoDS_Shape> inputs; // the shapes given to the filler
+    Standard_Real tolerance;
+    bool useOBB;
+    unsigned long generation; // the clear() count of the cache when computed
+    BOPAlgo_PaveFiller filler;
+
+    bool matches(const std::vector<TopoDS_Shape>& s, Standard_Real tol, bool obb) const
+    {
+        if (tolerance != tol || useOBB != obb || shapes.size() != s.size())
+            return false;
+        for (std::size_t i = 0; i < shapes.size(); i++) {
+            if (!shapes[i].IsEqual(s[i]))
+                return false;
+        }
+        return true;
+    }
+};
+
+typedef std::shared_ptr<PaveFillerEntry> PaveFillerPtr;
+
+// A few of the last computed intersections. An entry is removed from the
+// cache while an operation uses it, so it is never shared between threads.
+class PaveFillerCache
+{
+public:
+    static PaveFillerCache& instance()
+    {
+        static PaveFillerCache cache;
+        return cache;
+    }
+
+    unsigned long generation()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+    }
+
+    PaveFillerPtr take(const std::vector<TopoDS_Shape>& shapes, Standard_Real tolerance, bool useOBB)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::list<PaveFillerPtr>::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if ((*it)->matches(shapes, tolerance, useOBB)) {
+                PaveFillerPtr entry = *it;
+                entries.erase(it);
+                return entry;
+            }
+        }
+        return PaveFillerPtr();
+    }
+
+    void put(const PaveFillerPtr& entry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // computed before the cache was cleared, the shapes may have changed since
+        if (entry->generation != count)
+            return;
+        for (std::list<PaveFillerPtr>::iterator it = entries.begin(); it != entries.end(); ++it) {
+            if ((*it)->matches(entry->shapes, entry->tolerance, entry->useOBB)) {
+                entries.erase(it);
+                break;
+            }
+        }
+        entries.push_front(entry);
+        // the entries keep the shapes alive, so only hold a few of them
+        if (entries.size() > 4)
+            entries.pop_back();
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        ++count;
+    }
+
+private:
+    PaveFillerCache() : count(0)
+    {
+    }
+
+    std::mutex mutex;
+    std::list<PaveFillerPtr> entries;
+    unsigned long count;
+};
+
+// Deletes the operation before the intersection it was built from, and puts
+// the intersection back into the cache
+struct PaveFillerRelease
+{
+    PaveFillerPtr entry;
+    bool cache;
+
+    void operator()(BRepAlgoAPI_BooleanOperation* mkBool)
+    {
+        delete mkBool;
+        if (cache)
+            PaveFillerCache::instance().put(entry);
+    }
+};
+#endif
+
+BRepAlgoAPI_BooleanOperation* createBoolean(BOPAlgo_Operation op)
+{
+    switch (op) {
+    case BOPAlgo_FUSE:
+        return new BRepAlgoAPI_Fuse();
+    case BOPAlgo_CUT:
+        return new BRepAlgoAPI_Cut();
+    case BOPAlgo_COMMON:
+        return new BRepAlgoAPI_Common();
+    case BOPAlgo_SECTION:
+        return new BRepAlgoAPI_Section();
+    default:
+        throw Base::ValueError("Unsupported boolean operation");
+    }
+}
+
+#if OCC_VERSION_HEX >= 0x070200
+BRepAlgoAPI_BooleanOperation* createBoolean(BOPAlgo_Operation op, const BOPAlgo_PaveFiller& filler)
+{
+    switch (op) {
+    case BOPAlgo_FUSE:
+        return new BRepAlgoAPI_Fuse(filler);
+    case BOPAlgo_CUT:
+        return new BRepAlgoAPI_Cut(filler);
+    case BOPAlgo_COMMON:
+        return new BRepAlgoAPI_Common(filler);
+    case BOPAlgo_SECTION:
+        return new BRepAlgoAPI_Section(filler);
+    default:
+        throw Base::ValueError("Unsupported boolean operation");
+    }
+}
+#endif
+#endif
+
+}
+
+std::shared_ptr<BRepAlgoAPI_BooleanOperation> TopoShape::makeBoolean(BOPAlgo_Operation op,
+    const TopTools_ListOfShape &arguments, const TopTools_ListOfShape &tools,
+    Standard_Real tolerance, Standard_Boolean approximate)
+{
+    if (arguments.IsEmpty() || tools.IsEmpty())
+        throw Base::ValueError("Boolean operation needs arguments and tools");
+    for (TopTools_ListIteratorOfListOfShape it(arguments); it.More(); it.Next()) {
+        if (it.Value().IsNull())
+            throw NullShapeException("Base shape is null");
+    }
+    for (TopTools_ListIteratorOfListOfShape it(tools); it.More(); it.Next()) {
+        if (it.Value().IsNull())
+            throw NullShapeException("Tool shape is null");
+    }
+
+#if OCC_VERSION_HEX < 0x060900
+    if (arguments.Extent() > 1 || tools.Extent() > 1)
+        throw Base::RuntimeError("Boolean operations of several shapes are available only in OCC 6.9.0 and up.");
+    if (tolerance > 0.0)
+        Standard_Failure::Raise("Fuzzy Booleans are not supported in this version of OCCT");
+    (void)approximate;
+
+    const TopoDS_Shape& base = arguments.First();
+    const TopoDS_Shape& tool = tools.First();
+    switch (op) {
+    case BOPAlgo_FUSE:
+        return std::shared_ptr<BRepAlgoAPI_BooleanOperation>(new BRepAlgoAPI_Fuse(base, tool));
+    case BOPAlgo_CUT:
+        return std::shared_ptr<BRepAlgoAPI_BooleanOperation>(new BRepAlgoAPI_Cut(base, tool));
+    case BOPAlgo_COMMON:
+        return std::shared_ptr<BRepAlgoAPI_BooleanOperation>(new BRepAlgoAPI_Common(base, tool));
+    case BOPAlgo_SECTION:
+        return std::shared_ptr<BRepAlgoAPI_BooleanOperation>(new BRepAlgoAPI_Section(base, tool));
+    default:
+        throw Base::ValueError("Unsupported boolean operation");
+    }
+#else
+    BooleanOptions options;
+
+#if OCC_VERSION_HEX >= 0x070200
+    // a section sets its approximation and pcurve attributes on the filler it
+    // computes, the ones of an existing filler can't be changed any more
+    PaveFillerPtr entry;
+    if (op != BOPAlgo_SECTION) {
+        std::vector<TopoDS_Shape> shapes;
+        for (TopTools_ListIteratorOfListOfShape it(arguments); it.More(); it.Next())
+            shapes.push_back(it.Value());
+        for (TopTools_ListIteratorOfListOfShape it(tools); it.More(); it.Next())
+            shapes.push_back(it.Value());
+
+        if (options.cacheIntersection)
+            entry = PaveFillerCache::instance().take(shapes, tolerance, options.useOBB);
+
+        if (!entry) {
+            entry.reset(new PaveFillerEntry());
+            entry->shapes = shapes;
+            entry->tolerance = tolerance;
+            entry->useOBB = options.useOBB;
+            entry->generation = PaveFillerCache::instance().generation();
+
+            TopTools_ListOfShape fillerArguments;
+            std::size_t numArguments = static_cast<std::size_t>(arguments.Extent());
+            for (std::size_t i = 0; i < shapes.size(); i++) {
+                if (tolerance > 0.0 && i >= numArguments)
+                    // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
+                    entry->inputs.push_back(BRepBuilderAPI_Copy(shapes[i]).Shape());
+                else
+                    entry->inputs.push_back(shapes[i]);
+                fillerArguments.Append(entry->inputs.back());
+            }
+
+            BOPAlgo_PaveFiller& filler = entry->filler;
+            filler.SetArguments(fillerArguments);
+            filler.SetRunParallel(options.runParallel);
+            filler.SetNonDestructive(Standard_True);
+            if (tolerance > 0.0)
+                filler.SetFuzzyValue(tolerance);
+#if OCC_VERSION_HEX >= 0x070300
+            filler.SetUseOBB(options.useOBB);
+#endif
+            filler.Perform();
+            // let the operation itself report the failure
+            if (filler.HasErrors())
+                entry.reset();
+        }
+    }
+
+    if (entry) {
+        PaveFillerRelease release;
+        release.entry = entry;
+        release.cache = options.cacheIntersection;
+
+        std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkBool(createBoolean(op, entry->filler), release);
+
+        TopTools_ListOfShape shapeArguments, shapeTools;
+        std::size_t numArguments = static_cast<std::size_t>(arguments.Extent());
+        for (std::size_t i = 0; i < entry->inputs.size(); i++) {
+            if (i < numArguments)
+                shapeArguments.Append(entry->inputs[i]);
+            else
+                shapeTools.Append(entry->inputs[i]);
+        }
+        mkBool->SetArguments(shapeArguments);
+        mkBool->SetTools(shapeTools);
+        mkBool->SetRunParallel(options.runParallel);
+        mkBool->Build();
+        return mkBool;
+    }
+#endif
+
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkBool(createBoolean(op));
+    if (op == BOPAlgo_SECTION)
+        static_cast<BRepAlgoAPI_Section*>(mkBool.get())->Approximation(approximate);
+
+    TopTools_ListOfShape shapeArguments, shapeTools;
+    for (TopTools_ListIteratorOfListOfShape it(arguments); it.More(); it.Next())
+        shapeArguments.Append(it.Value());
+    for (TopTools_ListIteratorOfListOfShape it(tools); it.More(); it.Next()) {
+        if (tolerance > 0.0)
+            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
+            shapeTools.Append(BRepBuilderAPI_Copy(it.Value()).Shape());
+        else
+            shapeTools.Append(it.Value());
+    }
+
+    mkBool->SetArguments(shapeArguments);
+    mkBool->SetTools(shapeTools);
+    mkBool->SetRunParallel(options.runParallel);
+    if (tolerance > 0.0)
+        mkBool->SetFuzzyValue(tolerance);
+#if OCC_VERSION_HEX >= 0x070000
+    mkBool->SetNonDestructive(Standard_True);
+#endif
+#if OCC_VERSION_HEX >= 0x070300
+    mkBool->SetUseOBB(options.useOBB);
+#endif
+    mkBool->Build();
+    return mkBool;
+#endif
+}
+
+void TopoShape::clearBooleanCache()
+{
+#if OCC_VERSION_HEX >= 0x070200
+    PaveFillerCache::instance().clear();
+#endif
+}
+
 TopoDS_Shape TopoShape::cut(TopoDS_Shape shape) const
 {
     if (this->_Shape.IsNull())
@@ -1559,29 +2085,20 @@ TopoDS_Shape TopoShape::cut(const std::vector<TopoDS_Shape>& shapes, Standard_Re
     (void)tolerance;
     throw Base::RuntimeError("Multi cut is available only in OCC 6.9.0 and up.");
 #else
-    BRepAlgoAPI_Cut mkCut;
-    mkCut.SetRunParallel(true);
     TopTools_ListOfShape shapeArguments,shapeTools;
     shapeArguments.Append(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
         if (it->IsNull())
             throw Base::ValueError("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
+        shapeTools.Append(*it);
     }
 
-    mkCut.SetArguments(shapeArguments);
-    mkCut.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkCut.SetFuzzyValue(tolerance);
-    mkCut.Build();
-    if (!mkCut.IsDone())
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkCut =
+        makeBoolean(BOPAlgo_CUT, shapeArguments, shapeTools, tolerance);
+    if (!mkCut->IsDone())
         throw Base::RuntimeError("Multi cut failed");
 
-    TopoDS_Shape resShape = mkCut.Shape();
+    TopoDS_Shape resShape = mkCut->Shape();
     return makeShell(resShape);
 #endif
 }
@@ -1605,29 +2122,20 @@ TopoDS_Shape TopoShape::common(const std::vector<TopoDS_Shape>& shapes, Standard
     (void)tolerance;
     throw Base::RuntimeError("Multi common is available only in OCC 6.9.0 and up.");
 #else
-    BRepAlgoAPI_Common mkCommon;
-    mkCommon.SetRunParallel(true);
     TopTools_ListOfShape shapeArguments,shapeTools;
     shapeArguments.Append(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
         if (it->IsNull())
             throw Base::ValueError("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
+        shapeTools.Append(*it);
     }
 
-    mkCommon.SetArguments(shapeArguments);
-    mkCommon.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkCommon.SetFuzzyValue(tolerance);
-    mkCommon.Build();
-    if (!mkCommon.IsDone())
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkCommon =
+        makeBoolean(BOPAlgo_COMMON, shapeArguments, shapeTools, tolerance);
+    if (!mkCommon->IsDone())
         throw Base::RuntimeError("Multi common failed");
 
-    TopoDS_Shape resShape = mkCommon.Shape();
+    TopoDS_Shape resShape = mkCommon->Shape();
     return makeShell(resShape);
 #endif
 }
@@ -1663,30 +2171,20 @@ TopoDS_Shape TopoShape::fuse(const std::vector<TopoDS_Shape>& shapes, Standard_R
         resShape = mkFuse.Shape();
     }
 #else
-    BRepAlgoAPI_Fuse mkFuse;
-# if OCC_VERSION_HEX >= 0x060900
-    mkFuse.SetRunParallel(true);
-# endif
     TopTools_ListOfShape shapeArguments,shapeTools;
     shapeArguments.Append(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
         if (it->IsNull())
             throw NullShapeException("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
+        shapeTools.Append(*it);
     }
-    mkFuse.SetArguments(shapeArguments);
-    mkFuse.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkFuse.SetFuzzyValue(tolerance);
-    mkFuse.Build();
-    if (!mkFuse.IsDone())
+
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkFuse =
+        makeBoolean(BOPAlgo_FUSE, shapeArguments, shapeTools, tolerance);
+    if (!mkFuse->IsDone())
         throw Base::RuntimeError("Multi fuse failed");
 
-    TopoDS_Shape resShape = mkFuse.Shape();
+    TopoDS_Shape resShape = mkFuse->Shape();
 #endif
     return makeShell(resShape);
 }
@@ -1738,30 +2236,20 @@ TopoDS_Shape TopoShape::section(const std::vector<TopoDS_Shape>& shapes,
     (void)approximate;
     throw Base::RuntimeError("Multi section is available only in OCC 6.9.0 and up.");
 #else
-    BRepAlgoAPI_Section mkSection;
-    mkSection.SetRunParallel(true);
-    mkSection.Approximation(approximate);
     TopTools_ListOfShape shapeArguments,shapeTools;
     shapeArguments.Append(this->_Shape);
     for (std::vector<TopoDS_Shape>::const_iterator it = shapes.begin(); it != shapes.end(); ++it) {
         if (it->IsNull())
             throw Base::ValueError("Tool shape is null");
-        if (tolerance > 0.0)
-            // workaround for http://dev.opencascade.org/index.php?q=node/1056#comment-520
-            shapeTools.Append(BRepBuilderAPI_Copy(*it).Shape());
-        else
-            shapeTools.Append(*it);
+        shapeTools.Append(*it);
     }
 
-    mkSection.SetArguments(shapeArguments);
-    mkSection.SetTools(shapeTools);
-    if (tolerance > 0.0)
-        mkSection.SetFuzzyValue(tolerance);
-    mkSection.Build();
-    if (!mkSection.IsDone())
+    std::shared_ptr<BRepAlgoAPI_BooleanOperation> mkSection =
+        makeBoolean(BOPAlgo_SECTION, shapeArguments, shapeTools, tolerance, approximate);
+    if (!mkSection->IsDone())
         throw Base::RuntimeError("Multi section failed");
 
-    TopoDS_Shape resShape = mkSection.Shape();
+    TopoDS_Shape resShape = mkSection->Shape();
     return resShape;
 #endif
 }
@@ -1774,11 +2262,8 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
 
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
     CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
-    for (std::vector<double>::const_iterator jt = d.begin(); jt != d.end(); ++jt) {
-        wire_list.push_back(cs.slice(*jt));
-    }
+    std::vector< std::list<TopoDS_Wire> > wire_list = cs.slices(d);
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
     TopoDS_Compound comp;
@@ -1807,8 +2292,12 @@ TopoDS_Shape TopoShape::generalFuse(const std::vector<TopoDS_Shape> &sOthers, St
     (void)mapInOut;
     throw Base::AttributeError("GFA is available only in OCC 6.9.0 and up.");
 #else
+    BooleanOptions options;
     BRepAlgoAPI_BuilderAlgo mkGFA;
-    mkGFA.SetRunParallel(true);
+    mkGFA.SetRunParallel(options.runParallel);
+#if OCC_VERSION_HEX >= 0x070300
+    mkGFA.SetUseOBB(options.useOBB);
+#endif
     TopTools_ListOfShape GFAArguments;
     GFAArguments.Append(this->_Shape);
     for (const TopoDS_Shape &it: sOthers) {
@@ -2968,6 +3457,9 @@ bool TopoShape::fix(double precision, double mintol, double maxtol)
         this->_Shape = fix.Shape();
     }
 
+    // the fixes may change sub-shapes in place, e.g. their tolerances
+    clearCheckCache();
+    clearBooleanCache();
     return isValid();
 }
 
@@ -3073,91 +3565,97 @@ TopoDS_Shape TopoShape::removeSplitter() const
     return _Shape;
 }
 
-void TopoShape::getDomains(std::vector<Domain>& domains) const
+namespace Part {
+// Gets the mesh of a face as domain, returns false if the face isn't meshed
+static bool getFaceDomain(const TopoDS_Face& face, TopoShape::Domain& domain)
 {
-    std::size_t countFaces = 0;
-    for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
-        ++countFaces;
-    }
-    domains.reserve(countFaces);
-
-    for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
-        TopoDS_Face face = TopoDS::Face(xp.Current());
-
-        TopLoc_Location loc;
-        Handle(Poly_Triangulation) theTriangulation = BRep_Tool::Triangulation(face, loc);
-        if (theTriangulation.IsNull())
-            continue;
+    TopLoc_Location loc;
+    Handle(Poly_Triangulation) theTriangulation = BRep_Tool::Triangulation(face, loc);
+    if (theTriangulation.IsNull())
+        return false;
 
-        Domain domain;
-        // copy the points
-        const TColgp_Array1OfPnt& points = theTriangulation->Nodes();
-        domain.points.reserve(points.Length());
-        for (int i = 1; i <= points.Length(); i++) {
-            gp_Pnt p = points(i);
-            p.Transform(loc.Transformation());
-            Standard_Real X, Y, Z;
-            p.Coord (X, Y, Z);
-            domain.points.push_back(Base::Vector3d(X, Y, Z));
-        }
+    // copy the points
+    const TColgp_Array1OfPnt& points = theTriangulation->Nodes();
+    domain.points.reserve(points.Length());
+    for (int i = 1; i <= points.Length(); i++) {
+        gp_Pnt p = points(i);
+        p.Transform(loc.Transformation());
+        Standard_Real X, Y, Z;
+        p.Coord (X, Y, Z);
+        domain.points.push_back(Base::Vector3d(X, Y, Z));
+    }
+
+    // copy the triangles
+    const TopAbs_Orientation anOrientation = face.Orientation();
+    bool flip = (anOrientation == TopAbs_REVERSED);
+    const Poly_Array1OfTriangle& faces = theTriangulation->Triangles();
+    domain.facets.reserve(faces.Length());
+    for (int i = 1; i <= faces.Length(); i++) {
+        Standard_Integer N1, N2, N3;
+        faces(i).Get(N1, N2, N3);
+
+        TopoShape::Facet tria;
+        tria.I1 = N1-1; tria.I2 = N2-1; tria.I3 = N3-1;
+        if (flip)
+            std::swap(tria.I1, tria.I2);
+        domain.facets.push_back(tria);
+    }
 
-        // copy the triangles
-        const TopAbs_Orientation anOrientation = face.Orientation();
-        bool flip = (anOrientation == TopAbs_REVERSED);
-        const Poly_Array1OfTriangle& faces = theTriangulation->Triangles();
-        domain.facets.reserve(faces.Length());
-        for (int i = 1; i <= faces.Length(); i++) {
-            Standard_Integer N1, N2, N3;
-            faces(i).Get(N1, N2, N3);
+    return true;
+}
+}
 
-            Facet tria;
-            tria.I1 = N1-1; tria.I2 = N2-1; tria.I3 = N3-1;
-            if (flip)
-                std::swap(tria.I1, tria.I2);
-            domain.facets.push_back(tria);
+void TopoShape::getDomains(std::vector<Domain>& domains) const
+{
+    std::vector<TopoDS_Face> faces;
+    for (TopExp_Explorer xp(this->_Shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        faces.push_back(TopoDS::Face(xp.Current()));
+    }
+
+    // the faces are independent of each other, so copy their meshes in parallel
+    std::vector<Domain> faceDomains(faces.size());
+    std::vector<char> meshed(faces.size(), 0);
+    Parallel::forEach(faces.size(), [&](std::size_t i) {
+        meshed[i] = getFaceDomain(faces[i], faceDomains[i]);
+    });
+
+    domains.reserve(domains.size() + faces.size());
+    for (std::size_t i = 0; i < faces.size(); i++) {
+        if (meshed[i]) {
+            domains.push_back(Domain());
+            domains.back().points.swap(faceDomains[i].points);
+            domains.back().facets.swap(faceDomains[i].facets);
         }
-
-        domains.push_back(domain);
     }
 }
 
 namespace Part {
+// Mesh vertices with the same coordinates are welded. -0.0 is turned into
+// 0.0 by adding 0.0, so that both fall on the same hash value.
 struct MeshVertex
 {
     Standard_Real x,y,z;
-    Standard_Integer i;
 
-    MeshVertex(Standard_Real X, Standard_Real Y, Standard_Real Z)
-        : x(X),y(Y),z(Z),i(0)
-    {
-    }
     MeshVertex(const Base::Vector3d& p)
-        : x(p.x),y(p.y),z(p.z),i(0)
+        : x(p.x + 0.0),y(p.y + 0.0),z(p.z + 0.0)
     {
     }
 
-    Base::Vector3d toPoint() const
-    { return Base::Vector3d(x,y,z); }
-
-    bool operator < (const MeshVertex &v) const
+    bool operator == (const MeshVertex &v) const
     {
-        if (fabs ( this->x - v.x) >= MESH_MIN_PT_DIST)
-            return this->x < v.x;
-        if (fabs ( this->y - v.y) >= MESH_MIN_PT_DIST)
-            return this->y < v.y;
-        if (fabs ( this->z - v.z) >= MESH_MIN_PT_DIST)
-            return this->z < v.z;
-        return false; // points are considered to be equal
+        return x == v.x && y == v.y && z == v.z;
     }
-
-private:
-    // use the same value as used inside the Mesh module
-    static const double MESH_MIN_PT_DIST;
 };
-}
 
-//const double Vertex::MESH_MIN_PT_DIST = 1.0e-6;
-const double MeshVertex::MESH_MIN_PT_DIST = gp::Resolution();
+static std::size_t hash_value(const MeshVertex& v)
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, v.x);
+    boost::hash_combine(seed, v.y);
+    boost::hash_combine(seed, v.z);
+    return seed;
+}
+}
 
 void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
                          std::vector<Facet> &aTopo,
@@ -3171,63 +3669,39 @@ void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
     std::vector<Domain> domains;
     getDomains(domains);
 
-    std::set<MeshVertex> vertices;
-    Standard_Real x1, y1, z1;
-    Standard_Real x2, y2, z2;
-    Standard_Real x3, y3, z3;
+    std::size_t numPoints = 0, numFacets = 0;
+    for (std::vector<Domain>::const_iterator it = domains.begin(); it != domains.end(); ++it) {
+        numPoints += it->points.size();
+        numFacets += it->facets.size();
+    }
 
+    // The points are numbered in the order they are found. Each point of a
+    // domain is looked up once, and its facets use the mapped indices.
+    boost::unordered_map<MeshVertex, std::size_t> vertices;
+    vertices.reserve(numPoints);
+    std::vector<Base::Vector3d> points;
+    points.reserve(numPoints);
+    aTopo.reserve(aTopo.size() + numFacets);
+
+    std::vector<int> index;
     for (std::vector<Domain>::const_iterator it = domains.begin(); it != domains.end(); ++it) {
         const Domain& domain = *it;
+        index.assign(domain.points.size(), -1);
         for (std::vector<Facet>::const_iterator jt = domain.facets.begin(); jt != domain.facets.end(); ++jt) {
-            x1 = domain.points[jt->I1].x;
-            y1 = domain.points[jt->I1].y;
-            z1 = domain.points[jt->I1].z;
-
-            x2 = domain.points[jt->I2].x;
-            y2 = domain.points[jt->I2].y;
-            z2 = domain.points[jt->I2].z;
-
-            x3 = domain.points[jt->I3].x;
-            y3 = domain.points[jt->I3].y;
-            z3 = domain.points[jt->I3].z;
-
             TopoShape::Facet face;
-            std::set<MeshVertex>::iterator vIt;
-
-            // 1st vertex
-            MeshVertex v1(x1,y1,z1);
-            vIt = vertices.find(v1);
-            if (vIt == vertices.end()) {
-                v1.i = vertices.size();
-                face.I1 = v1.i;
-                vertices.insert(v1);
-            }
-            else {
-                face.I1 = vIt->i;
-            }
-
-            // 2nd vertex
-            MeshVertex v2(x2,y2,z2);
-            vIt = vertices.find(v2);
-            if (vIt == vertices.end()) {
-                v2.i = vertices.size();
-                face.I2 = v2.i;
-                vertices.insert(v2);
-            }
-            else {
-                face.I2 = vIt->i;
-            }
-
-            // 3rd vertex
-            MeshVertex v3(x3,y3,z3);
-            vIt = vertices.find(v3);
-            if (vIt == vertices.end()) {
-                v3.i = vertices.size();
-                face.I3 = v3.i;
-                vertices.insert(v3);
-            }
-            else {
-                face.I3 = vIt->i;
+            uint32_t* corners[3] = { &face.I1, &face.I2, &face.I3 };
+            const uint32_t pts[3] = { jt->I1, jt->I2, jt->I3 };
+            for (int k = 0; k < 3; k++) {
+                int& idx = index[pts[k]];
+                if (idx < 0) {
+                    const Base::Vector3d& p = domain.points[pts[k]];
+                    std::pair<boost::unordered_map<MeshVertex, std::size_t>::iterator, bool> ins =
+                        vertices.insert(std::make_pair(MeshVertex(p), points.size()));
+                    if (ins.second)
+                        points.push_back(p);
+                    idx = static_cast<int>(ins.first->second);
+                }
+                *corners[k] = static_cast<uint32_t>(idx);
             }
 
             // make sure that we don't insert invalid facets
@@ -3238,10 +3712,6 @@ void TopoShape::getFaces(std::vector<Base::Vector3d> &aPoints,
         }
     }
 
-    std::vector<Base::Vector3d> points;
-    points.resize(vertices.size());
-    for (std::set<MeshVertex>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-        points[it->i] = it->toPoint();
     aPoints.swap(points);
 }
 
@@ -25,6 +25,8 @@
 #define PART_TOPOSHAPE_H
 
 #include <iostream>
+#include <memory>
+#include <BOPAlgo_Operation.hxx>
 #include <TopoDS_Compound.hxx>
 #include <TopoDS_Wire.hxx>
 #include <TopTools_ListOfShape.hxx>
@@ -34,6 +36,7 @@
 class gp_Ax1;
 class gp_Ax2;
 class gp_Vec;
+class BRepAlgoAPI_BooleanOperation;
 
 namespace App {
 class Color;
@@ -186,8 +189,18 @@ public:
     /** @name Query*/
     //@{
     bool isNull() const;
+    /** The results of isValid() and analyze() are kept for the last few
+     * checked shapes, so checking an unchanged shape again is cheap. A result
+     * is only used again if the sub-shapes, their tolerances, curves, surfaces
+     * and vertex points are still the same. Changes of the geometry objects
+     * themselves, e.g. moving a pole of a B-spline surface in place, or of
+     * the p-curves of the edges are not noticed. The children of a compound
+     * are checked in parallel.
+     */
     bool isValid() const;
     bool analyze(bool runBopCheck, std::ostream&) const;
+    /// forgets the check results, must be called after modifying the geometry of a shape in place
+    static void clearCheckCache();
     bool isClosed() const;
     //@}
 
@@ -226,6 +239,29 @@ public:
      * three solids: two cuts and common.
      */
     TopoDS_Shape generalFuse(const std::vector<TopoDS_Shape> &sOthers, Standard_Real tolerance, std::vector<TopTools_ListOfShape>* mapInOut = nullptr) const;
+    /**
+     * @brief makeBoolean: build a boolean operation with the settings of the
+     * boolean preferences (parallel mode, OBB prefiltering)
+     *
+     * The intersection of the arguments and tools is kept in a small cache,
+     * so that another operation on the same shapes (e.g. a cut followed by a
+     * fuse, or the recompute of a boolean feature) only has to build the
+     * result. The returned operation has been built, check IsDone() for
+     * the result.
+     *
+     * @param op (input): BOPAlgo_FUSE, BOPAlgo_CUT, BOPAlgo_COMMON or
+     * BOPAlgo_SECTION
+     *
+     * @param tolerance (input): fuzzy value, zero to disable fuzzyness
+     *
+     * @param approximate (input): approximation of the section edges, only
+     * used for BOPAlgo_SECTION
+     */
+    static std::shared_ptr<BRepAlgoAPI_BooleanOperation> makeBoolean(BOPAlgo_Operation op,
+        const TopTools_ListOfShape &arguments, const TopTools_ListOfShape &tools,
+        Standard_Real tolerance = 0.0, Standard_Boolean approximate = Standard_False);
+    /// releases the intersections kept for the boolean operations
+    static void clearBooleanCache();
     //@}
 
     /** Sweeping */
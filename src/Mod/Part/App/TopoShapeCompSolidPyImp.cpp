@@ -100,6 +100,9 @@ PyObject*  TopoShapeCompSolidPy::add(PyObject *args)
             builder.Add(comp, sh);
         else
             Standard_Failure::Raise("Cannot empty shape to compound solid");
+        // the compound solid has been changed in place
+        TopoShape::clearCheckCache();
+        TopoShape::clearBooleanCache();
     }
     catch (Standard_Failure& e) {
 
@@ -100,8 +100,12 @@ PyObject*  TopoShapeCompoundPy::add(PyObject *args)
     try {
         const TopoDS_Shape& sh = static_cast<TopoShapePy*>(obj)->
             getTopoShapePtr()->getShape();
-        if (!sh.IsNull())
+        if (!sh.IsNull()) {
             builder.Add(comp, sh);
+            // the compound has been changed in place
+            TopoShape::clearCheckCache();
+            TopoShape::clearBooleanCache();
+        }
     }
     catch (Standard_Failure& e) {
 
@@ -758,6 +758,9 @@ void TopoShapeEdgePy::setTolerance(Py::Float tol)
     BRep_Builder aBuilder;
     const TopoDS_Edge& e = TopoDS::Edge(getTopoShapePtr()->getShape());
     aBuilder.UpdateEdge(e, (double)tol);
+    // the tolerance is changed in place, also for the shapes sharing it
+    TopoShape::clearCheckCache();
+    TopoShape::clearBooleanCache();
 }
 
 Py::Float TopoShapeEdgePy::getLength(void) const
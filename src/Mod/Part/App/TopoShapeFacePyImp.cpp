@@ -895,6 +895,9 @@ void TopoShapeFacePy::setTolerance(Py::Float tol)
     BRep_Builder aBuilder;
     const TopoDS_Face& f = TopoDS::Face(getTopoShapePtr()->getShape());
     aBuilder.UpdateFace(f, (double)tol);
+    // the tolerance is changed in place, also for the shapes sharing it
+    TopoShape::clearCheckCache();
+    TopoShape::clearBooleanCache();
 }
 
 Py::Tuple TopoShapeFacePy::getParameterRange(void) const
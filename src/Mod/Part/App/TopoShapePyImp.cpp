@@ -2354,6 +2354,9 @@ PyObject* TopoShapePy::fixTolerance(PyObject *args)
 
         ShapeFix_ShapeTolerance fix;
         fix.SetTolerance(shape, value, shapetype);
+        // the tolerances are changed in place, also for the shapes sharing the sub-shapes
+        TopoShape::clearCheckCache();
+        TopoShape::clearBooleanCache();
         Py_Return;
     }
     catch (Standard_Failure& e) {
@@ -2395,6 +2398,8 @@ PyObject* TopoShapePy::limitTolerance(PyObject *args)
 
         ShapeFix_ShapeTolerance fix;
         Standard_Boolean ok = fix.LimitTolerance(shape, tmin, tmax, shapetype);
+        TopoShape::clearCheckCache();
+        TopoShape::clearBooleanCache();
         return PyBool_FromLong(ok ? 1 : 0);
     }
     catch (Standard_Failure& e) {
@@ -134,6 +134,9 @@ PyObject*  TopoShapeShellPy::add(PyObject *args)
             getTopoShapePtr()->getShape();
         if (!sh.IsNull()) {
             builder.Add(shell, sh);
+            // the shell has been changed in place
+            TopoShape::clearCheckCache();
+            TopoShape::clearBooleanCache();
             BRepCheck_Analyzer check(shell);
             if (!check.IsValid()) {
                 ShapeUpgrade_ShellSewing sewShell;
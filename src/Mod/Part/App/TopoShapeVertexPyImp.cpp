@@ -144,6 +144,9 @@ void TopoShapeVertexPy::setTolerance(Py::Float tol)
     BRep_Builder aBuilder;
     const TopoDS_Vertex& v = TopoDS::Vertex(getTopoShapePtr()->getShape());
     aBuilder.UpdateVertex(v, (double)tol);
+    // the tolerance is changed in place, also for the shapes sharing it
+    TopoShape::clearCheckCache();
+    TopoShape::clearBooleanCache();
 }
 
 Py::Float TopoShapeVertexPy::getX(void) const
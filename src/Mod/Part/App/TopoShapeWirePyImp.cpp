@@ -217,6 +217,9 @@ PyObject* TopoShapeWirePy::fixWire(PyObject *args)
         aFix.FixConnected();
         aFix.FixClosed();
         getTopoShapePtr()->setShape(aFix.Wire());
+        // the edges of the wire may be changed in place
+        TopoShape::clearCheckCache();
+        TopoShape::clearBooleanCache();
 
         Py_Return;
     }
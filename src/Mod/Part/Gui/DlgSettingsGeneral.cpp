@@ -270,6 +270,7 @@ void DlgImportExportStep::saveSettings()
 
     // (h)STEP of Import module
     ui->checkBoxMergeCompound->onSave();
+    ui->checkBoxShareInstances->onSave();
 }
 
 void DlgImportExportStep::loadSettings()
@@ -304,6 +305,7 @@ void DlgImportExportStep::loadSettings()
 
     // (h)STEP of Import module
     ui->checkBoxMergeCompound->onRestore();
+    ui->checkBoxShareInstances->onRestore();
 }
 
 /**
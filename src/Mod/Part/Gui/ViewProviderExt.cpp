@@ -913,6 +913,13 @@ void ViewProviderPartExt::updateVisual(const TopoDS_Shape& inputShape)
     std::set<int> faceEdges;
 
     try {
+        // We must reset the location here because the transformation data
+        // are set in the placement property. This is done before meshing so
+        // that placed copies of a shape ask for the same deflection and reuse
+        // the triangulation stored on their shared faces.
+        TopLoc_Location aLoc;
+        cShape.Location(aLoc);
+
         // calculating the deflection value
         Bnd_Box bounds;
         BRepBndLib::Add(cShape, bounds);
@@ -930,10 +937,6 @@ void ViewProviderPartExt::updateVisual(const TopoDS_Shape& inputShape)
 #else
         BRepMesh_IncrementalMesh(cShape,deflection);
 #endif
-        // We must reset the location here because the transformation data
-        // are set in the placement property
-        TopLoc_Location aLoc;
-        cShape.Location(aLoc);
 
         // count triangles and nodes in the mesh
         TopTools_IndexedMapOfShape faceMap;
@@ -52,6 +52,108 @@ class PartTestCases(unittest.TestCase):
         #self.Doc.addObject("Part::Feature","Face").Shape = result
         #self.assertTrue(isinstance(result.Surface, Part.BSplineSurface))
 
+    def testBooleansOfSameShapes(self):
+        # the intersection of the shapes is shared between these operations
+        box1 = Part.makeBox(10,10,10)
+        box2 = Part.makeBox(10,10,10,App.Vector(5,5,5))
+        self.assertAlmostEqual(box1.cut(box2).Volume, 875.0)
+        self.assertAlmostEqual(box1.fuse(box2).Volume, 1875.0)
+        self.assertAlmostEqual(box1.common(box2).Volume, 125.0)
+        self.assertAlmostEqual(box1.cut([box2]).Volume, 875.0)
+        self.assertAlmostEqual(box1.fuse([box2]).Volume, 1875.0)
+
+        box3 = self.Doc.addObject("Part::Box","Box1")
+        box4 = self.Doc.addObject("Part::Box","Box2")
+        box4.Placement.Base = App.Vector(5,5,5)
+        cut = self.Doc.addObject("Part::Cut","Cut")
+        cut.Base = box3
+        cut.Tool = box4
+        common = self.Doc.addObject("Part::Common","Common")
+        common.Base = box3
+        common.Tool = box4
+        self.Doc.recompute()
+        self.assertAlmostEqual(cut.Shape.Volume, 875.0)
+        self.assertAlmostEqual(common.Shape.Volume, 125.0)
+
+        box4.Placement.Base = App.Vector(8,8,8)
+        self.Doc.recompute()
+        self.assertAlmostEqual(cut.Shape.Volume, 992.0)
+        self.assertAlmostEqual(common.Shape.Volume, 8.0)
+
+    def testSlices(self):
+        box = Part.makeBox(10,10,10)
+        heights = [0.25 + 0.5 * i for i in range(-4, 24)]
+        comp = box.slices(App.Vector(0,0,1), heights)
+        # the planes outside of the box don't give wires
+        self.assertEqual(len(comp.Wires), 20)
+        for wire, z in zip(comp.Wires, heights[4:]):
+            self.assertAlmostEqual(wire.BoundBox.ZMin, z)
+            self.assertAlmostEqual(wire.Length, 40.0)
+        self.assertEqual(len(box.slice(App.Vector(0,0,1), 20.0)), 0)
+
+        # a shell is only sliced where its faces reach the plane
+        shell = box.Shells[0]
+        comp = shell.slices(App.Vector(1,0,0), [2.0, 5.0, 8.0])
+        self.assertEqual(len(comp.Wires), 3)
+        for wire in comp.Wires:
+            self.assertAlmostEqual(wire.Length, 40.0)
+
+    def testTessellate(self):
+        # the corners shared by the faces are welded
+        box = Part.makeBox(10,10,10)
+        points, facets = box.tessellate(0.1)
+        self.assertEqual(len(points), 8)
+        self.assertEqual(len(facets), 12)
+
+        # each face of the compound is meshed on its own
+        comp = Part.makeCompound([box, Part.makeBox(10,10,10,App.Vector(20,0,0))])
+        points, facets = comp.tessellate(0.1)
+        self.assertEqual(len(points), 16)
+        self.assertEqual(len(facets), 24)
+
+    def testBinaryBrep(self):
+        import tempfile, zipfile
+        box = self.Doc.addObject("Part::Box","Box")
+        self.Doc.recompute()
+        self.Doc.BrepFormat = "Binary"
+        path = os.path.join(tempfile.gettempdir(), "PartTestBinaryBrep.FCStd")
+        self.Doc.saveAs(path)
+        with zipfile.ZipFile(path) as zf:
+            names = zf.namelist()
+        self.assertTrue([n for n in names if n.endswith(".bin")])
+        self.assertFalse([n for n in names if n.endswith(".brp")])
+
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.openDocument(path)
+        self.assertAlmostEqual(self.Doc.Box.Shape.Volume, 1000.0)
+        self.assertEqual(self.Doc.BrepFormat, "Binary")
+        FreeCAD.closeDocument(self.Doc.Name)
+        self.Doc = FreeCAD.newDocument("PartTest")
+        os.remove(path)
+
+    def testCheckShape(self):
+        box = Part.makeBox(10,10,10)
+        self.assertTrue(box.isValid())
+        self.assertTrue(box.isValid())
+        box.check(True)
+
+        # a face with a self-intersecting boundary
+        bowtie = Part.Face(Part.makePolygon([App.Vector(0,0,0), App.Vector(10,10,0),
+                                             App.Vector(10,0,0), App.Vector(0,10,0),
+                                             App.Vector(0,0,0)]))
+        self.assertFalse(bowtie.isValid())
+        self.assertRaises(ValueError, bowtie.check)
+
+        # the children of the compound are checked in parallel
+        comp = Part.makeCompound([Part.makeBox(10,10,10,App.Vector(20*i,0,0)) for i in range(8)])
+        self.assertTrue(comp.isValid())
+        comp.check()
+
+        # the compound is changed in place, so its old result is dropped
+        comp.add(bowtie)
+        self.assertFalse(comp.isValid())
+        self.assertRaises(ValueError, comp.check)
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartTest")
@@ -50,8 +50,10 @@
 #include <Base/Exception.h>
 #include <Base/Parameter.h>
 #include <Base/Reader.h>
+#include <Base/TimeInfo.h>
 #include <App/Application.h>
 #include <Mod/Part/App/modelRefine.h>
+#include <Mod/Part/App/TopoShape.h>
 
 using namespace PartDesign;
 
@@ -247,6 +249,10 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
     typedef std::map<App::DocumentObject*,  trsf_it> rej_it_map;
     rej_it_map nointersect_trsfms;
 
+    Base::TimeInfo timer;
+    int instances = 0;
+    int batched = 0;
+
     // NOTE: It would be possible to build a compound from all original addShapes/subShapes and then
     // transform the compounds as a whole. But we choose to apply the transformations to each
     // Original separately. This way it is easier to discover what feature causes a fuse/cut
@@ -271,9 +277,8 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
         }
 
         // Transform the add/subshape and collect the resulting shapes for overlap testing
-        /*typedef std::vector<std::vector<gp_Trsf>::const_iterator> trsf_it_vec;
-        trsf_it_vec v_transformations;
-        std::vector<TopoDS_Shape> v_transformedShapes;*/
+        std::vector<std::vector<gp_Trsf>::const_iterator> v_transformations;
+        std::vector<TopoDS_Shape> v_transformedShapes;
 
         std::vector<gp_Trsf>::const_iterator t = transformations.begin();
         ++t; // Skip first transformation, which is always the identity transformation
@@ -281,23 +286,81 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
             // Make an explicit copy of the shape because the "true" parameter to BRepBuilderAPI_Transform
             // seems to be pretty broken
             BRepBuilderAPI_Copy copy(shape);
-            shape = copy.Shape();
-            if (shape.IsNull())
+            TopoDS_Shape shapeCopy = copy.Shape();
+            if (shapeCopy.IsNull())
                 return new App::DocumentObjectExecReturn("Transformed: Linked shape object is empty");
 
-            BRepBuilderAPI_Transform mkTrf(shape, *t, false); // No need to copy, now
+            BRepBuilderAPI_Transform mkTrf(shapeCopy, *t, false); // No need to copy, now
             if (!mkTrf.IsDone())
                 return new App::DocumentObjectExecReturn("Transformation failed", (*o));
 
-            // Check for intersection with support
-            try {
+            v_transformations.push_back(t);
+            v_transformedShapes.push_back(mkTrf.Shape());
+        }
+
+        // A transformed shape must intersect the support, including any extra support gained by
+        // the previous transformations. The shapes that don't overlap with any other transformed
+        // shape can only intersect the support as it is now, so they are checked against it and
+        // then fused/cut with the support in a single boolean operation. The overlapping shapes
+        // are done one by one afterwards, as their checks depend on each other.
+        std::vector<bool> overlapping = findOverlappingShapes(v_transformedShapes);
 
-                if (!Part::checkIntersection(support, mkTrf.Shape(), false, true)) {
+        try {
+            std::vector<TopoDS_Shape> tools;
+            for (std::size_t i = 0; i < v_transformedShapes.size(); i++) {
+                if (overlapping[i])
+                    continue;
+                if (!Part::checkIntersection(support, v_transformedShapes[i], false, true)) {
 #ifdef FC_DEBUG // do not write this in release mode because a message appears already in the task view
                     Base::Console().Warning("Transformed shape does not intersect support %s: Removed\n", (*o)->getNameInDocument());
 #endif
-                    nointersect_trsfms[*o].insert(t);
-                } else {
+                    nointersect_trsfms[*o].insert(v_transformations[i]);
+                }
+                else {
+                    tools.push_back(v_transformedShapes[i]);
+                }
+            }
+
+            if (tools.size() > 1) {
+                try {
+                    Part::TopoShape base(support);
+                    TopoDS_Shape current = fuse ? base.fuse(tools) : base.cut(tools);
+                    // we have to get the solids (fuse sometimes creates compounds)
+                    if (fuse)
+                        current = this->getSolid(current);
+                    // if the result is not a solid, do them one by one below
+                    if (!current.IsNull()) {
+                        support = current;
+                        batched += static_cast<int>(tools.size());
+                        tools.clear();
+                    }
+                }
+                catch (Standard_Failure&) {
+                    // the multi-argument boolean failed, do them one by one below
+                }
+                catch (Base::Exception&) {
+                    // e.g. multi-argument booleans are not supported by this version of OCC,
+                    // do them one by one below
+                }
+            }
+
+            for (std::vector<TopoDS_Shape>::const_iterator it = tools.begin(); it != tools.end(); ++it) {
+                App::DocumentObjectExecReturn* ret = fuseOrCut(support, *it, fuse, *o);
+                if (ret)
+                    return ret;
+            }
+
+            for (std::size_t i = 0; i < v_transformedShapes.size(); i++) {
+                if (!overlapping[i])
+                    continue;
+                // Check for intersection with support
+                if (!Part::checkIntersection(support, v_transformedShapes[i], false, true)) {
+#ifdef FC_DEBUG // do not write this in release mode because a message appears already in the task view
+                    Base::Console().Warning("Transformed shape does not intersect support %s: Removed\n", (*o)->getNameInDocument());
+#endif
+                    nointersect_trsfms[*o].insert(v_transformations[i]);
+                }
+                else {
                     // We cannot wait to fuse a transformation with the support until all the transformations are done,
                     // because the "support" potentially changes with every transformation, basically when checking intersection
                     // above you need:
@@ -307,72 +370,28 @@ App::DocumentObjectExecReturn *Transformed::execute(void)
                     //
                     // Therefore, if the transformation succeeded, then we fuse it with the support now, before checking the intersection
                     // of the next transformation.
-                    
-                    /*v_transformations.push_back(t);
-                    v_transformedShapes.push_back(mkTrf.Shape());*/
-
-                    // Note: Transformations that do not intersect the support are ignored in the overlap tests
-                    
-                    //insert scheme here.
-                    /*TopoDS_Compound compoundTool;
-                    std::vector<TopoDS_Shape> individualTools;
-                    divideTools(v_transformedShapes, individualTools, compoundTool);*/
-                    
-                    // Fuse/Cut the compounded transformed shapes with the support
-                    //TopoDS_Shape result;
-                    TopoDS_Shape current = support;
-                    
-                    if (fuse) {
-                        BRepAlgoAPI_Fuse mkFuse(current, mkTrf.Shape());
-                        if (!mkFuse.IsDone())
-                            return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
-                        // we have to get the solids (fuse sometimes creates compounds)
-                        current = this->getSolid(mkFuse.Shape());
-                        // lets check if the result is a solid
-                        if (current.IsNull())
-                            return new App::DocumentObjectExecReturn("Resulting shape is not a solid", *o);
-
-                        /*std::vector<TopoDS_Shape>::const_iterator individualIt;
-                        for (individualIt = individualTools.begin(); individualIt != individualTools.end(); ++individualIt)
-                        {
-                            BRepAlgoAPI_Fuse mkFuse2(current, *individualIt);
-                            if (!mkFuse2.IsDone())
-                                return new App::DocumentObjectExecReturn("Fusion with support failed", *o);
-                            // we have to get the solids (fuse sometimes creates compounds)
-                            current = this->getSolid(mkFuse2.Shape());
-                            // lets check if the result is a solid
-                            if (current.IsNull())
-                                return new App::DocumentObjectExecReturn("Resulting shape is not a solid", *o);
-                        }*/
-                    } else {
-                        BRepAlgoAPI_Cut mkCut(current, mkTrf.Shape());
-                        if (!mkCut.IsDone())
-                            return new App::DocumentObjectExecReturn("Cut out of support failed", *o);
-                        current = mkCut.Shape();
-                        /*std::vector<TopoDS_Shape>::const_iterator individualIt;
-                        for (individualIt = individualTools.begin(); individualIt != individualTools.end(); ++individualIt)
-                        {
-                            BRepAlgoAPI_Cut mkCut2(current, *individualIt);
-                            if (!mkCut2.IsDone())
-                                return new App::DocumentObjectExecReturn("Cut out of support failed", *o);
-                            current = this->getSolid(mkCut2.Shape());
-                            if (current.IsNull())
-                                return new App::DocumentObjectExecReturn("Resulting shape is not a solid", *o);
-                        }*/
-                    }
-                    support = current; // Use result of this operation for fuse/cut of next original
+                    App::DocumentObjectExecReturn* ret = fuseOrCut(support, v_transformedShapes[i], fuse, *o);
+                    if (ret)
+                        return ret;
                 }
-            } catch (Standard_Failure& e) {
-                // Note: Ignoring this failure is probably pointless because if the intersection check fails, the later
-                // fuse operation of the transformation result will also fail
-        
-                std::string msg("Transformation: Intersection check failed");
-                if (e.GetMessageString() != NULL)
-                    msg += std::string(": '") + e.GetMessageString() + "'";
-                return new App::DocumentObjectExecReturn(msg.c_str());
             }
+        } catch (Standard_Failure& e) {
+            // Note: Ignoring this failure is probably pointless because if the intersection check fails, the later
+            // fuse operation of the transformation result will also fail
+
+            std::string msg("Transformation: Intersection check failed");
+            if (e.GetMessageString() != NULL)
+                msg += std::string(": '") + e.GetMessageString() + "'";
+            return new App::DocumentObjectExecReturn(msg.c_str());
         }
+
+        instances += static_cast<int>(v_transformedShapes.size());
     }
+
+    Base::Console().Log("%s: %d transformed shapes, %d of them in single boolean operations, %.3f s\n",
+                        getNameInDocument(), instances, batched,
+                        Base::TimeInfo::diffTimeF(timer, Base::TimeInfo()));
+
     support = refineShapeIfActive(support);
 
     for (rej_it_map::const_iterator it = nointersect_trsfms.begin(); it != nointersect_trsfms.end(); ++it)
@@ -409,6 +428,50 @@ TopoDS_Shape Transformed::refineShapeIfActive(const TopoDS_Shape& oldShape) cons
     return oldShape;
 }
 
+App::DocumentObjectExecReturn* Transformed::fuseOrCut(TopoDS_Shape &support, const TopoDS_Shape &tool,
+                                                      bool fuse, App::DocumentObject* original) const
+{
+    if (fuse) {
+        BRepAlgoAPI_Fuse mkFuse(support, tool);
+        if (!mkFuse.IsDone())
+            return new App::DocumentObjectExecReturn("Fusion with support failed", original);
+        // we have to get the solids (fuse sometimes creates compounds)
+        TopoDS_Shape current = getSolid(mkFuse.Shape());
+        // lets check if the result is a solid
+        if (current.IsNull())
+            return new App::DocumentObjectExecReturn("Resulting shape is not a solid", original);
+        support = current;
+    } else {
+        BRepAlgoAPI_Cut mkCut(support, tool);
+        if (!mkCut.IsDone())
+            return new App::DocumentObjectExecReturn("Cut out of support failed", original);
+        support = mkCut.Shape();
+    }
+
+    return 0;
+}
+
+std::vector<bool> Transformed::findOverlappingShapes(const std::vector<TopoDS_Shape> &shapes)
+{
+    std::vector<Bnd_Box> bounds(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        BRepBndLib::Add(shapes[i], bounds[i]);
+        bounds[i].Enlarge(Precision::Confusion());
+    }
+
+    std::vector<bool> overlapping(shapes.size(), false);
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        for (std::size_t j = i + 1; j < shapes.size(); j++) {
+            if (!bounds[i].IsOut(bounds[j])) {
+                overlapping[i] = true;
+                overlapping[j] = true;
+            }
+        }
+    }
+
+    return overlapping;
+}
+
 void Transformed::divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
                               TopoDS_Compound &compoundOut) const
 {
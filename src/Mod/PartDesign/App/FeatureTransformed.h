@@ -94,6 +94,11 @@ protected:
     TopoDS_Shape refineShapeIfActive(const TopoDS_Shape&) const;
     void divideTools(const std::vector<TopoDS_Shape> &toolsIn, std::vector<TopoDS_Shape> &individualsOut,
 		     TopoDS_Compound &compoundOut) const; 
+    /// fuses the tool to or cuts it out of the support, returns an error if this fails
+    App::DocumentObjectExecReturn* fuseOrCut(TopoDS_Shape &support, const TopoDS_Shape &tool,
+                                             bool fuse, App::DocumentObject* original) const;
+    /// flags the shapes whose bounding box overlaps with the bounding box of another shape
+    static std::vector<bool> findOverlappingShapes(const std::vector<TopoDS_Shape> &shapes);
 
     rejectedMap rejected;
 };
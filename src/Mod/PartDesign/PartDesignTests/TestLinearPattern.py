@@ -138,6 +138,102 @@ class TestLinearPattern(unittest.TestCase):
         self.Doc.recompute()
         self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 1e4)
 
+    def testSeparateInstancesLinearPattern(self):
+        # the holes don't touch each other, so they are cut in a single boolean
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.PadSketch = self.Doc.addObject('Sketcher::SketchObject', 'SketchPad')
+        self.Body.addObject(self.PadSketch)
+        TestSketcherApp.CreateRectangleSketch(self.PadSketch, (0, 0), (100, 10))
+        self.Doc.recompute()
+        self.Pad = self.Doc.addObject("PartDesign::Pad", "Pad")
+        self.Body.addObject(self.Pad)
+        self.Pad.Profile = self.PadSketch
+        self.Pad.Length = 10
+        self.Pad.Reversed = 1
+        self.Doc.recompute()
+        self.PocketSketch = self.Doc.addObject('Sketcher::SketchObject', 'PocketSketch')
+        self.Body.addObject(self.PocketSketch)
+        TestSketcherApp.CreateRectangleSketch(self.PocketSketch, (4, 4), (2, 2))
+        self.Doc.recompute()
+        self.Pocket = self.Doc.addObject("PartDesign::Pocket", "Pocket")
+        self.Body.addObject(self.Pocket)
+        self.Pocket.Profile = self.PocketSketch
+        self.Pocket.Length = 5
+        self.Doc.recompute()
+        self.LinearPattern = self.Doc.addObject("PartDesign::LinearPattern","LinearPattern")
+        self.LinearPattern.Originals = [self.Pocket]
+        self.LinearPattern.Direction = (self.Doc.X_Axis,[""])
+        self.LinearPattern.Length = 80.0
+        self.LinearPattern.Occurrences = 5
+        self.Body.addObject(self.LinearPattern)
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 9900.0)
+        self.assertEqual(self.LinearPattern.State, ["Up-to-date"])
+
+    def testOverlappingInstancesLinearPattern(self):
+        # each hole overlaps the next one, so they are cut one by one
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.PadSketch = self.Doc.addObject('Sketcher::SketchObject', 'SketchPad')
+        self.Body.addObject(self.PadSketch)
+        TestSketcherApp.CreateRectangleSketch(self.PadSketch, (0, 0), (100, 10))
+        self.Doc.recompute()
+        self.Pad = self.Doc.addObject("PartDesign::Pad", "Pad")
+        self.Body.addObject(self.Pad)
+        self.Pad.Profile = self.PadSketch
+        self.Pad.Length = 10
+        self.Pad.Reversed = 1
+        self.Doc.recompute()
+        self.PocketSketch = self.Doc.addObject('Sketcher::SketchObject', 'PocketSketch')
+        self.Body.addObject(self.PocketSketch)
+        TestSketcherApp.CreateRectangleSketch(self.PocketSketch, (4, 4), (4, 2))
+        self.Doc.recompute()
+        self.Pocket = self.Doc.addObject("PartDesign::Pocket", "Pocket")
+        self.Body.addObject(self.Pocket)
+        self.Pocket.Profile = self.PocketSketch
+        self.Pocket.Length = 5
+        self.Doc.recompute()
+        self.LinearPattern = self.Doc.addObject("PartDesign::LinearPattern","LinearPattern")
+        self.LinearPattern.Originals = [self.Pocket]
+        self.LinearPattern.Direction = (self.Doc.X_Axis,[""])
+        self.LinearPattern.Length = 3.0
+        self.LinearPattern.Occurrences = 4
+        self.Body.addObject(self.LinearPattern)
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 9930.0)
+        self.assertEqual(self.LinearPattern.State, ["Up-to-date"])
+
+    def testInstanceOutsideSupportLinearPattern(self):
+        # the last hole lies beyond the end of the pad and is rejected
+        self.Body = self.Doc.addObject('PartDesign::Body','Body')
+        self.PadSketch = self.Doc.addObject('Sketcher::SketchObject', 'SketchPad')
+        self.Body.addObject(self.PadSketch)
+        TestSketcherApp.CreateRectangleSketch(self.PadSketch, (0, 0), (100, 10))
+        self.Doc.recompute()
+        self.Pad = self.Doc.addObject("PartDesign::Pad", "Pad")
+        self.Body.addObject(self.Pad)
+        self.Pad.Profile = self.PadSketch
+        self.Pad.Length = 10
+        self.Pad.Reversed = 1
+        self.Doc.recompute()
+        self.PocketSketch = self.Doc.addObject('Sketcher::SketchObject', 'PocketSketch')
+        self.Body.addObject(self.PocketSketch)
+        TestSketcherApp.CreateRectangleSketch(self.PocketSketch, (4, 4), (2, 2))
+        self.Doc.recompute()
+        self.Pocket = self.Doc.addObject("PartDesign::Pocket", "Pocket")
+        self.Body.addObject(self.Pocket)
+        self.Pocket.Profile = self.PocketSketch
+        self.Pocket.Length = 5
+        self.Doc.recompute()
+        self.LinearPattern = self.Doc.addObject("PartDesign::LinearPattern","LinearPattern")
+        self.LinearPattern.Originals = [self.Pocket]
+        self.LinearPattern.Direction = (self.Doc.X_Axis,[""])
+        self.LinearPattern.Length = 120.0
+        self.LinearPattern.Occurrences = 5
+        self.Body.addObject(self.LinearPattern)
+        self.Doc.recompute()
+        self.assertAlmostEqual(self.LinearPattern.Shape.Volume, 9920.0)
+        self.assertEqual(self.LinearPattern.State, ["Invalid"])
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument("PartDesignTestLinearPattern")
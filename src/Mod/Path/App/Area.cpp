@@ -23,6 +23,8 @@
 
 #ifndef _PreComp_
 # include <cfloat>
+# include <exception>
+# include <sstream>
 # include <boost/version.hpp>
 # include <boost/config.hpp>
 # if defined(BOOST_MSVC) && (BOOST_VERSION == 105500)
@@ -91,6 +93,7 @@
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Part/App/FaceMakerBullseye.h>
 #include <Mod/Part/App/CrossSection.h>
+#include <Mod/Part/App/Parallel.h>
 #include "Area.h"
 #include "../libarea/Area.h"
 
@@ -154,7 +157,7 @@ CAreaConfig::~CAreaConfig() {
 
 TYPESYSTEM_SOURCE(Path::Area, Base::BaseClass);
 
-bool Area::s_aborting;
+std::atomic<bool> Area::s_aborting(false);
 
 Area::Area(const AreaParams *params)
 :myParams(s_params)
@@ -1413,15 +1416,12 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     if(heights.empty())
         throw Base::ValueError("no sections");
 
-    std::vector<shared_ptr<Area> > sections;
-    sections.reserve(heights.size());
-
     std::list<Shape> projectedShapes;
     if(project) {
         projectedShapes = getProjectedShapes(trsf,false);
         if(projectedShapes.empty()) {
             AREA_ERR("empty projection");
-            return sections;
+            return std::vector<shared_ptr<Area> >();
         }
     }
 
@@ -1429,10 +1429,36 @@ std::vector<shared_ptr<Area> > Area::makeSections(
     bool can_retry = fabs(tolerance)>Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
-    for(size_t i=0;i<heights.size();++i) {
+    // Slicing of each height is independent from the others, so it is done
+    // concurrently below. Log messages are collected in SectionInfo, and
+    // reported in height order afterwards, because Base::Console is not
+    // thread safe. Also note that only the OCC part of the work is done here.
+    // libarea keeps its configuration and scratch data in static variables,
+    // so CArea operations on the resulting sections still run one at a time.
+    struct SectionInfo {
+        size_t index;
+        shared_ptr<Area> area;
+        std::vector<std::pair<bool,std::string> > messages;
+        std::exception_ptr error;
+    };
+    std::vector<SectionInfo> infos(heights.size());
+    for(size_t i=0;i<heights.size();++i)
+        infos[i].index = i;
+
+#define AREA_SECTION_MSG(_warn,_msg) do{\
+    std::ostringstream str;\
+    str << _msg;\
+    info.messages.emplace_back(_warn,str.str());\
+}while(0)
+
+    auto makeSection = [&](SectionInfo &info, const std::list<Shape> &shapes) {
+        size_t i = info.index;
         double z = heights[i];
         bool retried = !can_retry;
         while(true) {
+            if(aborting())
+                return;
+
             gp_Pln pln(gp_Pnt(0,0,z),gp_Dir(0,0,1));
             Standard_Real a,b,c,d;
             pln.Coefficients(a,b,c,d);
@@ -1450,24 +1476,24 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                     TopLoc_Location wloc(t);
                     area->add(s.shape.Moved(wloc).Moved(locInverse),s.op);
                 }
-                sections.push_back(area);
+                info.area = area;
                 break;
             }
 
-            for(auto it=myShapes.begin();it!=myShapes.end();++it) {
+            for(auto it=shapes.begin();it!=shapes.end();++it) {
                 const auto &s = *it;
                 BRep_Builder builder;
                 TopoDS_Compound comp;
                 builder.MakeCompound(comp);
 
-                for(TopExp_Explorer xp(s.shape.Moved(loc), TopAbs_SOLID); xp.More(); xp.Next()) {
+                for(TopExp_Explorer xp(s.shape, TopAbs_SOLID); xp.More(); xp.Next()) {
                     showShape(xp.Current(),0,"section_%u_shape",i);
                     std::list<TopoDS_Wire> wires;
                     Part::CrossSection section(a,b,c,xp.Current());
                     wires = section.slice(-d);
                     showShapes(wires,0,"section_%u_wire",i);
                     if(wires.empty()) {
-                        AREA_LOG("Section returns no wires");
+                        AREA_SECTION_MSG(false,"Section returns no wires");
                         continue;
                     }
 
@@ -1482,7 +1508,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                         mkFace.Build();
                         const TopoDS_Shape &shape = mkFace.Shape();
                         if (shape.IsNull())
-                            AREA_WARN("FaceMakerBullseye return null shape on section");
+                            AREA_SECTION_MSG(true,"FaceMakerBullseye return null shape on section");
                         else {
                             showShape(shape,0,"section_%u_face",i);
                             for(auto it=wires.begin(),itNext=it;it!=wires.end();it=itNext) {
@@ -1497,7 +1523,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                             }
                         }
                     }catch (Base::Exception &e){
-                        AREA_WARN("FaceMakerBullseye failed on section: " << e.what());
+                        AREA_SECTION_MSG(true,"FaceMakerBullseye failed on section: " << e.what());
                     }
                     for(const TopoDS_Wire &wire : wires)
                         builder.Add(comp,wire);
@@ -1510,7 +1536,7 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                     area->add(shape,s.op);
                 }else if(area->myShapes.empty()){
                     auto itNext = it;
-                    if(++itNext != myShapes.end() &&
+                    if(++itNext != shapes.end() &&
                         (itNext->op==OperationIntersection ||
                         itNext->op==OperationDifference))
                     {
@@ -1519,20 +1545,78 @@ std::vector<shared_ptr<Area> > Area::makeSections(
                 }
             }
             if(area->myShapes.size()){
-                sections.push_back(area);
-                FC_TIME_LOG(t1,"makeSection " << z);
-                showShape(area->getShape(),0,"section_%u_final",i);
+                info.area = area;
                 break;
             }
             if(retried) {
-                AREA_WARN("Discard empty section");
+                AREA_SECTION_MSG(true,"Discard empty section");
                 break;
             }else{
-                AREA_TRACE("retry section " <<z<<"->"<<z+tolerance);
+                AREA_SECTION_MSG(false,"retry section " <<z<<"->"<<z+tolerance);
                 z += tolerance;
                 retried = true;
             }
         }
+    };
+#undef AREA_SECTION_MSG
+
+    // Shapes are transformed once here instead of once per section
+    std::list<Shape> shapes;
+    for(const Shape &s : myShapes)
+        shapes.emplace_back(s.op,s.shape.Moved(loc));
+
+    // showShape() adds document objects, which must not be done from worker
+    // threads, so stay serial when tracing
+    int threads = Part::Parallel::threadCount();
+    if(project || heights.size()<2 || threads<2 || FC_LOG_INSTANCE.level()>FC_LOGLEVEL_TRACE) {
+        for(auto &info : infos)
+            makeSection(info,shapes);
+    }else{
+        // Each worker gets its own copy of the input shapes, because the
+        // boolean operations used for slicing may update tolerances of the
+        // input shapes. Heights are distributed round robin, so that the
+        // (usually similar) cost of neighbouring sections is spread evenly.
+        size_t workers = std::min<size_t>(threads,heights.size());
+        Part::Parallel::forEach(workers, [&](size_t worker) {
+            std::list<Shape> copies;
+            for(const Shape &s : shapes)
+                copies.emplace_back(s.op,BRepBuilderAPI_Copy(s.shape).Shape());
+            for(size_t i=worker;i<infos.size();i+=workers) {
+                if(aborting())
+                    return;
+                try {
+                    makeSection(infos[i],copies);
+                }catch(...) {
+                    // rethrown below in the calling thread
+                    infos[i].error = std::current_exception();
+                    return;
+                }
+            }
+        });
+    }
+
+    if(aborting())
+        throw Base::AbortException("makeSections aborted");
+    FC_TIME_LOG(t1,"makeSection slicing");
+
+    std::vector<shared_ptr<Area> > sections;
+    sections.reserve(heights.size());
+    for(auto &info : infos) {
+        if(info.error)
+            std::rethrow_exception(info.error);
+        for(auto &msg : info.messages) {
+            if(msg.first)
+                AREA_WARN(msg.second);
+            else
+                AREA_LOG(msg.second);
+        }
+        if(info.area) {
+            sections.push_back(info.area);
+            // getShape() builds the section with libarea, which is not
+            // thread safe, hence it is done here
+            showShape(info.area->getShape(),0,"section_%u_final",info.index);
+            FC_TIME_LOG(t1,"makeSection " << heights[info.index]);
+        }
     }
     FC_TIME_LOG(t,"makeSection count: " << sections.size()<<", total");
     return sections;
@@ -2258,6 +2342,26 @@ TopoDS_Shape Area::toShape(const CArea &area, bool fill, const gp_Trsf *trsf, in
     return compound;
 }
 
+// Check if an open wire with the given end points must be reversed to follow
+// the enforced path direction
+static bool needReverse(short direction, const gp_Pnt &p1, const gp_Pnt &p2) {
+    switch(direction) {
+    case Area::DirectionXPositive:
+        return p1.X()>p2.X();
+    case Area::DirectionXNegative:
+        return p1.X()<p2.X();
+    case Area::DirectionYPositive:
+        return p1.Y()>p2.Y();
+    case Area::DirectionYNegative:
+        return p1.Y()<p2.Y();
+    case Area::DirectionZPositive:
+        return p1.Z()>p2.Z();
+    case Area::DirectionZNegative:
+        return p1.Z()<p2.Z();
+    }
+    return false;
+}
+
 struct WireInfo {
     TopoDS_Wire wire;
     std::deque<gp_Pnt> points;
@@ -2329,28 +2433,7 @@ struct GetWires {
             gp_Pnt p1,p2;
             getEndPoints(info.wire,p1,p2);
             if(!info.isClosed && params.direction!=Area::DirectionNone) {
-                bool reverse = false;
-                switch(params.direction) {
-                case Area::DirectionXPositive:
-                    reverse = p1.X()>p2.X();
-                    break;
-                case Area::DirectionXNegative:
-                    reverse = p1.X()<p2.X();
-                    break;
-                case Area::DirectionYPositive:
-                    reverse = p1.Y()>p2.Y();
-                    break;
-                case Area::DirectionYNegative:
-                    reverse = p1.Y()<p2.Y();
-                    break;
-                case Area::DirectionZPositive:
-                    reverse = p1.Z()>p2.Z();
-                    break;
-                case Area::DirectionZNegative:
-                    reverse = p1.Z()<p2.Z();
-                    break;
-                }
-                if(reverse) {
+                if(needReverse(params.direction,p1,p2)) {
                     info.wire.Reverse();
                     std::swap(p1,p2);
                 }
@@ -2803,29 +2886,233 @@ struct WireOrienter {
         }else if(direction!=Area::DirectionNone) {
             gp_Pnt p1,p2;
             getEndPoints(TopoDS::Wire(wire),p1,p2);
-            bool reverse = false;
-            switch(direction) {
-            case Area::DirectionXPositive:
-                reverse = p1.X()>p2.X();
-                break;
-            case Area::DirectionXNegative:
-                reverse = p1.X()<p2.X();
-                break;
-            case Area::DirectionYPositive:
-                reverse = p1.Y()>p2.Y();
-                break;
-            case Area::DirectionYNegative:
-                reverse = p1.Y()<p2.Y();
-                break;
-            case Area::DirectionZPositive:
-                reverse = p1.Z()>p2.Z();
-                break;
-            case Area::DirectionZNegative:
-                reverse = p1.Z()<p2.Z();
+            if(needReverse(direction,p1,p2))
+                wire.Reverse();
+        }
+    }
+};
+
+/** Travel distance optimizing wire sorter used by sort mode 'Optimized'
+ *
+ * Unlike ShapeInfo, which samples the wires and inserts/removes every point
+ * of the R-tree one at a time, only the end points of the wires are indexed
+ * here. The R-tree is bulk loaded, visited wires are only flagged, and the
+ * tree is rebuilt in one go once half of its entries become stale. The nearest
+ * neighbour order is then refined by 2-opt moves, restricted to the nearest
+ * wires of each end point, until no more improvement is found or the time
+ * limit is reached. Closed wires are entered at their first vertex, i.e. they
+ * are not rebased.
+ */
+struct TravelSorter {
+    struct Node {
+        TopoDS_Wire wire;
+        gp_Pnt pts[2];
+        int ends; // number of end points indexed
+        bool closed;
+        bool flipped;
+
+        const gp_Pnt &entry() const { return pts[flipped?1:0]; }
+        const gp_Pnt &exit() const { return pts[flipped?0:1]; }
+    };
+    // end point, and node index times two plus the end
+    typedef std::pair<gp_Pnt,size_t> PValue;
+    typedef bgi::rtree<PValue,RParameters> PTree;
+
+    std::vector<Node> nodes;
+    std::vector<PValue> values;
+    std::vector<size_t> order;
+    short orientation;
+    short direction;
+    bool flippable;
+
+    TravelSorter(short o, short d)
+        :orientation(o),direction(d),flippable(true)
+    {}
+
+    void add(const TopoDS_Shape &shape, int type) {
+        nodes.emplace_back();
+        Node &node = nodes.back();
+        if(type == TopAbs_WIRE)
+            node.wire = TopoDS::Wire(shape);
+        else
+            node.wire = BRepBuilderAPI_MakeWire(TopoDS::Edge(shape)).Wire();
+        node.closed = BRep_Tool::IsClosed(node.wire);
+        node.flipped = false;
+        node.ends = 1;
+        getEndPoints(node.wire,node.pts[0],node.pts[1]);
+        if(node.closed) {
+            node.pts[1] = node.pts[0];
+            if(orientation == Area::OrientationReversed)
+                node.wire.Reverse();
+        }else if(direction != Area::DirectionNone) {
+            if(needReverse(direction,node.pts[0],node.pts[1])) {
+                node.wire.Reverse();
+                std::swap(node.pts[0],node.pts[1]);
+            }
+            flippable = false;
+        }else
+            node.ends = 2;
+        size_t idx = nodes.size()-1;
+        for(int i=0;i<node.ends;++i)
+            values.push_back(PValue(node.pts[i],idx*2+i));
+    }
+
+    double travel(const gp_Pnt &pstart) const {
+        double d = 0.0;
+        const gp_Pnt *pt = &pstart;
+        for(size_t idx : order) {
+            d += pt->Distance(nodes[idx].entry());
+            pt = &nodes[idx].exit();
+        }
+        return d;
+    }
+
+    void sortNearest(const gp_Pnt &pstart) {
+        size_t count = nodes.size();
+        order.clear();
+        order.reserve(count);
+        std::vector<char> visited(count,0);
+        PTree rtree(values.begin(),values.end());
+        size_t total = values.size();
+        size_t stale = 0;
+        std::vector<PValue> ret;
+        gp_Pnt pt = pstart;
+        while(order.size()<count) {
+            if(stale*2 > total) {
+                std::vector<PValue> live;
+                live.reserve(total-stale);
+                for(auto &v : values) {
+                    if(!visited[v.second/2])
+                        live.push_back(v);
+                }
+                rtree = PTree(live.begin(),live.end());
+                total = live.size();
+                stale = 0;
+            }
+            ret.clear();
+            rtree.query(bgi::nearest(pt,1) && bgi::satisfies(
+                [&visited](const PValue &v){return !visited[v.second/2];}),
+                std::back_inserter(ret));
+            if(ret.empty())
                 break;
+            size_t idx = ret.front().second/2;
+            Node &node = nodes[idx];
+            node.flipped = (ret.front().second&1)!=0;
+            visited[idx] = 1;
+            stale += node.ends;
+            order.push_back(idx);
+            pt = node.exit();
+        }
+    }
+
+    void reverse(size_t i, size_t j, std::vector<size_t> &pos) {
+        std::reverse(order.begin()+i,order.begin()+j+1);
+        for(;i<=j;++i) {
+            Node &node = nodes[order[i]];
+            if(!node.closed)
+                node.flipped = !node.flipped;
+            pos[order[i]] = i;
+        }
+    }
+
+    // Returns false if the time limit is reached before converging
+    bool refine(const gp_Pnt &pstart, int k,
+            const std::chrono::steady_clock::time_point &deadline)
+    {
+        size_t count = order.size();
+        if(!flippable || count<2)
+            return true;
+
+        // Neighbour lists of each node plus the start point, which is stored
+        // at the end
+        PTree rtree(values.begin(),values.end());
+        std::vector<std::vector<size_t> > neighbors(count+1);
+        std::vector<PValue> ret;
+        auto findNeighbors = [&](const gp_Pnt &pt, size_t self) {
+            std::vector<size_t> &res = neighbors[self];
+            ret.clear();
+            rtree.query(bgi::nearest(pt,k*2+1),std::back_inserter(ret));
+            for(auto &v : ret) {
+                size_t idx = v.second/2;
+                if(idx!=self && std::find(res.begin(),res.end(),idx)==res.end())
+                    res.push_back(idx);
+            }
+        };
+        for(size_t i=0;i<count;++i) {
+            for(int j=0;j<nodes[i].ends;++j)
+                findNeighbors(nodes[i].pts[j],i);
+        }
+        findNeighbors(pstart,count);
+
+        std::vector<size_t> pos(count);
+        for(size_t i=0;i<count;++i)
+            pos[order[i]] = i;
+
+        bool improved = true;
+        while(improved) {
+            improved = false;
+            for(size_t i=0;i<count;++i) {
+                if(std::chrono::steady_clock::now() > deadline)
+                    return false;
+
+                // Try to replace the move from pa into pb with a shorter move
+                // from pa, or into pb, to a nearby wire, by reversing the run
+                // of wires in between.
+                const gp_Pnt &pa = i?nodes[order[i-1]].exit():pstart;
+                const gp_Pnt &pb = nodes[order[i]].entry();
+                double dab = pa.Distance(pb);
+                bool found = false;
+                for(size_t idx : neighbors[i?order[i-1]:count]) {
+                    size_t j = pos[idx];
+                    if(j<i)
+                        continue;
+                    const gp_Pnt &pc = nodes[idx].exit();
+                    double delta = pa.Distance(pc) - dab;
+                    if(delta >= 0.0)
+                        continue;
+                    if(j+1<count) {
+                        const gp_Pnt &pd = nodes[order[j+1]].entry();
+                        delta += pb.Distance(pd) - pc.Distance(pd);
+                    }
+                    if(delta < -Precision::Confusion()) {
+                        reverse(i,j,pos);
+                        found = true;
+                        break;
+                    }
+                }
+                if(!found && i) {
+                    for(size_t idx : neighbors[order[i]]) {
+                        size_t j = pos[idx];
+                        if(j>=i)
+                            continue;
+                        const gp_Pnt &pc = nodes[idx].entry();
+                        double delta = pb.Distance(pc) - dab;
+                        if(delta >= 0.0)
+                            continue;
+                        const gp_Pnt &pd = j?nodes[order[j-1]].exit():pstart;
+                        delta += pd.Distance(pa) - pd.Distance(pc);
+                        if(delta < -Precision::Confusion()) {
+                            reverse(j,i-1,pos);
+                            found = true;
+                            break;
+                        }
+                    }
+                }
+                if(found)
+                    improved = true;
             }
-            if(reverse)
-                wire.Reverse();
+        }
+        return true;
+    }
+
+    void getWires(std::list<TopoDS_Shape> &wires, gp_Pnt &pend) const {
+        for(size_t idx : order) {
+            const Node &node = nodes[idx];
+            if(node.flipped)
+                wires.push_back(node.wire.Reversed());
+            else
+                wires.push_back(node.wire);
+            pend = node.exit();
         }
     }
 };
@@ -2930,7 +3217,9 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
         pstart = *_pstart;
     bool use_bound = !has_start || _pstart==NULL;
 
-    if(use_bound || sort_mode == SortMode2D5 || sort_mode == SortModeGreedy) {
+    if(use_bound || sort_mode == SortMode2D5 ||
+       sort_mode == SortModeGreedy || sort_mode == SortModeOptimized)
+    {
         //Second stage, group shape by its plane, and find overall boundary
 
         if(arcPlaneFound || use_bound) {
@@ -2988,6 +3277,15 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
     auto current_it = shape_list.end();
     double current_height = (pstart.*getter)();
     double max_dist = sort_mode==SortModeGreedy?threshold*threshold:0;
+
+    // Time budget and travel statistics of sort mode 'Optimized'
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::microseconds(static_cast<long long>(
+                    std::max(sort_time_limit,0.0)*1e6));
+    bool converged = true;
+    size_t opt_count = 0;
+    double opt_input = 0.0, opt_nearest = 0.0, opt_final = 0.0;
+    FC_DURATION_DECL_INIT2(od,rd);
     while(shape_list.size()) {
         AREA_TRACE("sorting " << shape_list.size() << ' ' << AREA_XYZ(pstart));
         double best_d = DBL_MAX;
@@ -3021,14 +3319,42 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
             }
         }
 
-        wires.splice(wires.end(),
-            best_it->sortWires(pstart,pend,min_dist,max_dist,&pentry));
+        if(sort_mode==SortModeOptimized) {
+            FC_TIME_INIT(t2);
+            TravelSorter sorter(orientation,direction);
+            foreachSubshape(best_it->myShape,
+                [&sorter](const TopoDS_Shape &s, int type){sorter.add(s,type);},
+                TopAbs_WIRE);
+            for(size_t i=0;i<sorter.nodes.size();++i)
+                sorter.order.push_back(i);
+            opt_input += sorter.travel(pstart);
+            sorter.sortNearest(pstart);
+            opt_nearest += sorter.travel(pstart);
+            FC_DURATION_PLUS(od,t2);
+            if(sort_time_limit>0.0 && converged) {
+                FC_TIME_INIT(t3);
+                converged = sorter.refine(pstart,rparams.k,deadline);
+                FC_DURATION_PLUS(rd,t3);
+            }
+            opt_final += sorter.travel(pstart);
+            opt_count += sorter.nodes.size();
+            pend = pstart;
+            if(sorter.order.size())
+                pentry = sorter.nodes[sorter.order.front()].entry();
+            sorter.getWires(wires,pend);
+            best_it->myWires.clear();
+            best_it->myRTree.clear();
+        }else
+            wires.splice(wires.end(),
+                best_it->sortWires(pstart,pend,min_dist,max_dist,&pentry));
 
         if(use_bound && _pstart) {
             use_bound = false;
             *_pstart = pentry;
         }
-        if((sort_mode==SortMode2D5||sort_mode==SortMode3D) && stepdown_hint) {
+        if((sort_mode==SortMode2D5||sort_mode==SortMode3D||
+            sort_mode==SortModeOptimized) && stepdown_hint)
+        {
             if(!best_it->myPlanar)
                 hint_first = true;
             else if(hint_first)
@@ -3068,6 +3394,14 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape> &shapes,
     FC_DURATION_LOG(rparams.qd,"rtree query");
     FC_DURATION_LOG(rparams.rd,"rtree clean");
     FC_DURATION_LOG(rparams.xd,"BRepExtrema");
+    if(sort_mode == SortModeOptimized) {
+        FC_DURATION_LOG(od,"nearest neighbour sort");
+        FC_DURATION_LOG(rd,"2-opt refinement");
+        AREA_LOG("sorted " << opt_count << " wires, rapid distance "
+                << opt_input << " -> " << opt_nearest << " (nearest) -> "
+                << opt_final << (converged?" (2-opt)":" (2-opt, time limit reached)")
+                << ", saved " << opt_input-opt_final);
+    }
     FC_TIME_LOG(t,"sortWires total");
     return wires;
 }
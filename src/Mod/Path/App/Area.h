@@ -24,6 +24,7 @@
 #define PATH_AREA_H
 
 #include <QCoreApplication>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -134,7 +135,8 @@ protected:
     bool myProjecting;
     mutable int mySkippedShapes;
 
-    static bool s_aborting;
+    // set from the GUI thread, polled by the section workers
+    static std::atomic<bool> s_aborting;
     static AreaStaticParams s_params;
 
     /** Called internally to combine children shapes for further processing */
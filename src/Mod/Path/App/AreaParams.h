@@ -212,9 +212,15 @@
         "'3D' makes no assumption of planarity. The sorting is done across 3D space.\n"\
         "'Greedy' like '2D5' but will try to minimize travel by searching for nearest path below\n"\
         "the current milling layer. The path in lower layer is only selected if the moving distance\n"\
-        "is within the value given in 'threshold'.",\
-        (None)(2D5)(3D)(Greedy)))\
+        "is within the value given in 'threshold'.\n"\
+        "'Optimized' like '2D5' but scales to large number of wires. Only the end points of the\n"\
+        "wires are considered, and closed wires are not rebased. The nearest neighbour order is\n"\
+        "further improved by 2-opt within the time given in 'sort_time_limit'.",\
+        (None)(2D5)(3D)(Greedy)(Optimized)))\
     AREA_PARAMS_MIN_DIST \
+    ((double, sort_time_limit, SortTimeLimit, 1.0, "Time limit in seconds for the 2-opt refinement of\n"\
+        "sort mode 'Optimized'. Set to zero to only use nearest neighbour sorting. The refinement is\n"\
+        "skipped if a path direction is enforced.", App::PropertyFloat))\
     ((double, abscissa, SortAbscissa, 3.0, "Controls vertex sampling on wire for nearest point searching\n"\
         "The sampling is dong using OCC GCPnts_UniformAbscissa",App::PropertyLength))\
     ((short, nearest_k, NearestK, 3, "Nearest k sampling vertices are considered during sorting"))\
@@ -0,0 +1,294 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <cctype>
+# include <cinttypes>
+# include <cmath>
+# include <cstdlib>
+# include <iostream>
+# include <memory>
+#endif
+
+#include <Base/Exception.h>
+
+#include "Command.h"
+#include "GCode.h"
+
+using namespace Path;
+
+// size of the chunks used to read and write streams
+static const std::size_t GCodeBufferSize = 1 << 16;
+
+// GCodeLexer
+
+GCodeLexer::GCodeLexer()
+{
+    reset();
+}
+
+void GCodeLexer::reset()
+{
+    mode = None;
+    key = 0;
+    value.clear();
+    name.clear();
+    params.clear();
+}
+
+void GCodeLexer::pushArgument()
+{
+    if (!key || value.empty())
+        throw Base::BadFormatError("Badly formatted GCode argument");
+    params.push_back(std::make_pair(static_cast<char>(toupper(key)), std::atof(value.c_str())));
+    key = 0;
+    value.clear();
+}
+
+void GCodeLexer::feed(char c)
+{
+    int ch = static_cast<unsigned char>(c);
+    if (isdigit(ch) || c == '-' || c == '.') {
+        value += c;
+    } else if (isalpha(ch)) {
+        switch (mode) {
+        case Code:
+            if (!key || value.empty())
+                throw Base::BadFormatError("Badly formatted GCode command");
+            name.assign(1, static_cast<char>(toupper(key)));
+            name += value;
+            value.clear();
+            mode = Argument;
+            break;
+        case None:
+            mode = Code;
+            break;
+        case Argument:
+            pushArgument();
+            break;
+        case Comment:
+            value += c;
+            break;
+        }
+        key = c;
+    } else if (c == '(') {
+        mode = Comment;
+    } else if (c == ')') {
+        key = '(';
+        value += ')';
+    } else if (mode == Comment) {
+        // add non-ascii characters only if this is a comment
+        value += c;
+    }
+}
+
+void GCodeLexer::apply(Command &cmd)
+{
+    cmd.Parameters.clear();
+    if (!key || value.empty())
+        throw Base::BadFormatError("Badly formatted GCode argument");
+
+    if (mode == Argument)
+        pushArgument();
+
+    std::string k(1, 0);
+    for (std::vector<std::pair<char,double> >::const_iterator it = params.begin(); it != params.end(); ++it) {
+        k[0] = it->first;
+        cmd.Parameters[k] = it->second;
+    }
+
+    if (mode == Code) {
+        cmd.Name.assign(1, static_cast<char>(toupper(key)));
+        cmd.Name += value;
+    } else if (mode == Comment) {
+        cmd.Name.assign(1, key);
+        cmd.Name += value;
+    } else {
+        cmd.Name = name;
+    }
+}
+
+// GCodeReader
+
+GCodeReader::GCodeReader(std::vector<Command*> &commands)
+    : commands(commands), inComment(false), active(false), inches(false)
+{
+}
+
+void GCodeReader::addCommand()
+{
+    std::unique_ptr<Command> cmd(new Command());
+    lexer.apply(*cmd);
+    lexer.reset();
+    active = false;
+    if ("G20" == cmd->Name) {
+        inches = true;
+    } else if ("G21" == cmd->Name) {
+        inches = false;
+    } else {
+        if (inches) {
+            cmd->scaleBy(25.4);
+        }
+        commands.push_back(cmd.release());
+    }
+}
+
+void GCodeReader::parse(const char *data, std::size_t len)
+{
+    for (const char *end = data + len; data != end; ++data) {
+        char c = *data;
+        if (inComment) {
+            lexer.feed(c);
+            if (c == ')') {
+                // end of comment
+                inComment = false;
+                addCommand();
+            }
+            continue;
+        }
+        switch (c) {
+        case '(':
+            inComment = true;
+            // fall through
+        case 'g':
+        case 'G':
+        case 'm':
+        case 'M':
+            // start of a new command or comment, flush the last one found
+            if (active)
+                addCommand();
+            active = true;
+            lexer.feed(c);
+            break;
+        default:
+            // anything before the first command is ignored
+            if (active)
+                lexer.feed(c);
+        }
+    }
+}
+
+void GCodeReader::read(std::istream &in)
+{
+    std::vector<char> buffer(GCodeBufferSize);
+    while (in) {
+        in.read(&buffer[0], buffer.size());
+        std::streamsize count = in.gcount();
+        if (count <= 0)
+            break;
+        parse(&buffer[0], static_cast<std::size_t>(count));
+    }
+    finish();
+}
+
+void GCodeReader::finish()
+{
+    // an unterminated comment is dropped
+    if (active && !inComment)
+        addCommand();
+    lexer.reset();
+    active = false;
+    inComment = false;
+}
+
+// GCodeWriter
+
+GCodeWriter::GCodeWriter(std::ostream &out, int precision, bool padzero)
+    : out(out), precision(precision), padzero(padzero)
+{
+    buffer.reserve(GCodeBufferSize + 256);
+}
+
+GCodeWriter::~GCodeWriter()
+{
+    flush();
+}
+
+void GCodeWriter::write(const Command &cmd)
+{
+    format(buffer, cmd, precision, padzero);
+    buffer += '\n';
+    if (buffer.size() >= GCodeBufferSize)
+        flush();
+}
+
+void GCodeWriter::flush()
+{
+    if (buffer.empty())
+        return;
+    out.write(buffer.c_str(), buffer.size());
+    buffer.clear();
+}
+
+static inline void appendDigits(std::string &buf, std::int64_t v, int width)
+{
+    char tmp[32];
+    char *end = tmp + sizeof(tmp);
+    char *start = end;
+    do {
+        *--start = static_cast<char>('0' + v % 10);
+        v /= 10;
+    } while (v && start != tmp);
+    for (int n = static_cast<int>(end - start); n < width; ++n)
+        buf += '0';
+    buf.append(start, end);
+}
+
+void GCodeWriter::format(std::string &buf, const Command &cmd, int precision, bool padzero)
+{
+    buf += cmd.Name;
+    if (precision < 0)
+        precision = 0;
+    double scale = std::pow(10.0, precision + 1);
+    std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
+    for (std::map<std::string,double>::const_iterator i = cmd.Parameters.begin(); i != cmd.Parameters.end(); ++i) {
+        if (i->first == "N") continue;
+
+        buf += ' ';
+        buf += i->first;
+
+        std::int64_t v = static_cast<std::int64_t>(i->second * scale);
+        if (v < 0) {
+            v = -v;
+            buf += '-'; //shall we allow -0 ?
+        }
+        v += 5;
+        v /= 10;
+        appendDigits(buf, v / iscale, 0);
+        if (!precision) continue;
+
+        int width = precision;
+        std::int64_t digits = v % iscale;
+        if (!padzero) {
+            if (!digits) continue;
+            while (digits % 10 == 0) {
+                digits /= 10;
+                --width;
+            }
+        }
+        buf += '.';
+        appendDigits(buf, digits, width);
+    }
+}
@@ -0,0 +1,124 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#ifndef PATH_GCODE_H
+#define PATH_GCODE_H
+
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Path
+{
+    class Command;
+
+    /** Tokenizer for a single G-code command
+     *
+     * Characters are fed one by one, and the resulting name and parameters
+     * are assigned to a Command once the whole command has been seen. The
+     * accepted syntax is the one of Command::setFromGCode().
+     */
+    class PathExport GCodeLexer
+    {
+    public:
+        GCodeLexer();
+
+        void reset();
+        void feed(char c);
+        /// assigns the tokenized command, throws Base::BadFormatError if incomplete
+        void apply(Command &cmd);
+
+    private:
+        void pushArgument();
+
+    private:
+        enum Mode { None, Code, Argument, Comment };
+        Mode mode;
+        char key;
+        std::string value;
+        std::string name;
+        std::vector<std::pair<char,double> > params;
+    };
+
+    /** Single pass, streaming G-code parser
+     *
+     * The input is split into commands at each G, M or comment, the same
+     * way as Toolpath::setFromGCode() always did, and each command is
+     * tokenized while being split. G20/G21 switch between inch and metric
+     * input and are consumed by the reader, inch values are converted to mm.
+     * Input can be given in arbitrary chunks, which allows reading from a
+     * file without loading it into memory first.
+     */
+    class PathExport GCodeReader
+    {
+    public:
+        GCodeReader(std::vector<Command*> &commands);
+
+        /// parses a chunk of input, commands may span several chunks
+        void parse(const char *data, std::size_t len);
+        /// parses the whole stream, and finishes the input
+        void read(std::istream &in);
+        /// flushes the last pending command at the end of input
+        void finish();
+
+    private:
+        void addCommand();
+
+    private:
+        std::vector<Command*> &commands;
+        GCodeLexer lexer;
+        bool inComment;
+        bool active;
+        bool inches;
+    };
+
+    /** Buffered G-code emitter
+     *
+     * Formats commands the same way as Command::toGCode(), but writes them
+     * through a local buffer to the output stream, without going through
+     * std::stringstream or temporary strings.
+     */
+    class PathExport GCodeWriter
+    {
+    public:
+        GCodeWriter(std::ostream &out, int precision=6, bool padzero=true);
+        ~GCodeWriter();
+
+        /// writes the command followed by a newline
+        void write(const Command &cmd);
+        void flush();
+
+        /// appends the G-code representation of the command to the string
+        static void format(std::string &buf, const Command &cmd, int precision=6, bool padzero=true);
+
+    private:
+        std::ostream &out;
+        std::string buffer;
+        int precision;
+        bool padzero;
+    };
+
+} //namespace Path
+
+#endif // PATH_GCODE_H
@@ -39,6 +39,7 @@
 //#include "Mod/Robot/App/kdl_cp/utilities/error.h"
 
 #include "Path.h"
+#include "GCode.h"
 
 using namespace Path;
 using namespace Base;
@@ -145,74 +146,22 @@ double Toolpath::getLength()
     return l;
 }
 
-static void bulkAddCommand(const std::string &gcodestr, std::vector<Command*> &commands, bool &inches)
+void Toolpath::setFromGCode(const std::string instr)
 {
-    Command *cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    } else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    } else {
-        if (inches) {
-            cmd->scaleBy(25.4);
-        }
-        commands.push_back(cmd);
-    }
+    clear();
+
+    GCodeReader reader(vpcCommands);
+    reader.parse(instr.c_str(), instr.size());
+    reader.finish();
+    recalculate();
 }
 
-void Toolpath::setFromGCode(const std::string instr)
+void Toolpath::setFromGCode(std::istream &in)
 {
     clear();
 
-    // remove comments
-    //boost::regex e("\\(.*?\\)");
-    //std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
-
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos)
-    {
-        if (str[found] == '(') {
-            // start of comment
-            if ( (last > -1) && (mode == "command") ) {
-                // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            mode = "comment";
-            last = found;
-            found = str.find_first_of(")", found+1);
-        } else if (str[found] == ')') {
-            // end of comment
-            std::string gcodestr = str.substr(last, found-last+1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found+1);
-            mode = "command";
-        } else if (mode == "command") {
-            // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found-last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
-            }
-            last = found;
-            found = str.find_first_of("(gGmM", found+1);
-        }
-    }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last,std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-        }
-    }
+    GCodeReader reader(vpcCommands);
+    reader.read(in);
     recalculate();
 }
 
@@ -220,12 +169,19 @@ std::string Toolpath::toGCode(void) const
 {
     std::string result;
     for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it) {
-        result += (*it)->toGCode();
+        GCodeWriter::format(result, **it);
         result += "\n";
     }
     return result;
 }
 
+void Toolpath::toGCode(std::ostream &out) const
+{
+    GCodeWriter writer(out);
+    for (std::vector<Command*>::const_iterator it=vpcCommands.begin();it!=vpcCommands.end();++it)
+        writer.write(**it);
+}
+
 void Toolpath::recalculate(void) // recalculates the path cache
 {
 
@@ -329,9 +285,9 @@ void Toolpath::Save (Writer &writer) const
 
 void Toolpath::SaveDocFile (Base::Writer &writer) const
 {
-    if (toGCode().empty())
+    if (vpcCommands.empty())
         return;
-    writer.Stream() << toGCode();
+    toGCode(writer.Stream());
 }
 
 void Toolpath::Restore(XMLReader &reader)
@@ -347,14 +303,7 @@ void Toolpath::Restore(XMLReader &reader)
 
 void Toolpath::RestoreDocFile(Base::Reader &reader)
 {
-    std::string gcode;
-    std::string line;
-    while (reader >> line) {
-        gcode += line;
-        gcode += " ";
-    }
-    setFromGCode(gcode);
-
+    setFromGCode(reader);
 }
 
 
@@ -24,6 +24,7 @@
 #ifndef PATH_Path_H
 #define PATH_Path_H
 
+#include <iosfwd>
 #include "Command.h"
 //#include "Mod/Robot/App/kdl_cp/path_composite.hpp"
 //#include "Mod/Robot/App/kdl_cp/frames_io.hpp"
@@ -61,7 +62,9 @@ namespace Path
             double getLength(void); // return the Length (mm) of the Path
             void recalculate(void); // recalculates the points
             void setFromGCode(const std::string); // sets the path from the contents of the given GCode string
+            void setFromGCode(std::istream&); // sets the path from a GCode stream, read in chunks
             std::string toGCode(void) const; // gets a gcode string representation from the Path
+            void toGCode(std::ostream&) const; // writes the gcode representation of the Path to a stream
             
             // shortcut functions
             unsigned int getSize(void) const { return vpcCommands.size(); }
@@ -55,6 +55,7 @@
 
 #include <cinttypes>
 #include <iomanip>
+#include <exception>
 
 // Python
 #include <Python.h>
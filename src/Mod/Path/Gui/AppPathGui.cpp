@@ -36,6 +36,7 @@
 #include "ViewProviderPathCompound.h"
 #include "ViewProviderPathShape.h"
 #include "ViewProviderArea.h"
+#include "SoPathEdgeSet.h"
 
 // use a different name to CreateCommand()
 void CreatePathCommands(void);
@@ -73,6 +74,7 @@ PyMOD_INIT_FUNC(PathGui)
     CreatePathCommands();
 
     // addition objects
+    PathGui::SoPathEdgeSet                  ::initClass();
     PathGui::ViewProviderPath               ::init();
     PathGui::ViewProviderPathCompound       ::init();
     PathGui::ViewProviderPathCompoundPython ::init();
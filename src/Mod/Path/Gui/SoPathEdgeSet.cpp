@@ -0,0 +1,119 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+# include <Inventor/details/SoLineDetail.h>
+#endif
+
+#include "SoPathEdgeSet.h"
+#include <Gui/SoFCUnifiedSelection.h>
+
+using namespace PathGui;
+
+
+SO_NODE_SOURCE(SoPathEdgeSet);
+
+void SoPathEdgeSet::initClass()
+{
+    SO_NODE_INIT_CLASS(SoPathEdgeSet, PartGui::SoBrepEdgeSet, "BrepEdgeSet");
+}
+
+SoPathEdgeSet::SoPathEdgeSet()
+{
+    SO_NODE_CONSTRUCTOR(SoPathEdgeSet);
+    SO_NODE_ADD_FIELD(lineOffset, (0));
+}
+
+int SoPathEdgeSet::toLocalIndex(const SoDetail *detail) const
+{
+    if (!detail || !detail->isOfType(SoLineDetail::getClassTypeId()))
+        return -1;
+    int index = static_cast<const SoLineDetail*>(detail)->getLineIndex() - lineOffset.getValue();
+    if (index < 0)
+        return -1;
+    const int32_t* cindices = this->coordIndex.getValues(0);
+    int numcindices = this->coordIndex.getNum();
+    int lines = 0;
+    for (int i=0; i<numcindices; i++) {
+        if (cindices[i] < 0)
+            lines++;
+    }
+    return index < lines ? index : -1;
+}
+
+void SoPathEdgeSet::doAction(SoAction* action)
+{
+    // Pass a detail with the local line index to the edge set, or nothing
+    // at all if the line belongs to another chunk.
+    if (action->getTypeId() == Gui::SoHighlightElementAction::getClassTypeId()) {
+        Gui::SoHighlightElementAction* hlaction = static_cast<Gui::SoHighlightElementAction*>(action);
+        const SoDetail* detail = hlaction->getElement();
+        if (hlaction->isHighlighted() && detail) {
+            SoLineDetail line;
+            Gui::SoHighlightElementAction local;
+            int index = toLocalIndex(detail);
+            if (index >= 0) {
+                line.setLineIndex(index);
+                local.setHighlighted(true);
+                local.setColor(hlaction->getColor());
+                local.setElement(&line);
+            }
+            inherited::doAction(&local);
+            return;
+        }
+    }
+    else if (action->getTypeId() == Gui::SoSelectionElementAction::getClassTypeId()) {
+        Gui::SoSelectionElementAction* selaction = static_cast<Gui::SoSelectionElementAction*>(action);
+        const SoDetail* detail = selaction->getElement();
+        if (detail && (selaction->getType() == Gui::SoSelectionElementAction::Append ||
+                       selaction->getType() == Gui::SoSelectionElementAction::Remove)) {
+            int index = toLocalIndex(detail);
+            if (index < 0)
+                return;
+            SoLineDetail line;
+            line.setLineIndex(index);
+            Gui::SoSelectionElementAction local(selaction->getType());
+            local.setColor(selaction->getColor());
+            local.setElement(&line);
+            inherited::doAction(&local);
+            return;
+        }
+    }
+
+    inherited::doAction(action);
+}
+
+SoDetail * SoPathEdgeSet::createLineSegmentDetail(SoRayPickAction * action,
+                                                  const SoPrimitiveVertex * v1,
+                                                  const SoPrimitiveVertex * v2,
+                                                  SoPickedPoint * pp)
+{
+    SoDetail* detail = inherited::createLineSegmentDetail(action, v1, v2, pp);
+    SoLineDetail* line_detail = static_cast<SoLineDetail*>(detail);
+    int index = line_detail->getLineIndex() + lineOffset.getValue();
+    line_detail->setLineIndex(index);
+    line_detail->setPartIndex(index);
+    return detail;
+}
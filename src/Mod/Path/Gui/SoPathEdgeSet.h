@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright (c) 2026 FreeCAD Project Association                        *
+ *                                                                         *
+ *   This file is part of the FreeCAD CAx development system.              *
+ *                                                                         *
+ *   This library is free software; you can redistribute it and/or         *
+ *   modify it under the terms of the GNU Library General Public           *
+ *   License as published by the Free Software Foundation; either          *
+ *   version 2 of the License, or (at your option) any later version.      *
+ *                                                                         *
+ *   This library  is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU Library General Public License for more details.                  *
+ *                                                                         *
+ *   You should have received a copy of the GNU Library General Public     *
+ *   License along with this library; see the file COPYING.LIB. If not,    *
+ *   write to the Free Software Foundation, Inc., 59 Temple Place,         *
+ *   Suite 330, Boston, MA  02111-1307, USA                                *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef PATHGUI_SOPATHEDGESET_H
+#define PATHGUI_SOPATHEDGESET_H
+
+#include <Inventor/fields/SoSFInt32.h>
+#include <Mod/Part/Gui/SoBrepEdgeSet.h>
+
+namespace PathGui {
+
+/** Edge set holding one chunk of a tool path
+ *
+ * The lines of the edge set are numbered from \c lineOffset on, so that the
+ * line index reported by picking, and expected by the highlight and selection
+ * actions, is the index of the edge in the whole tool path. Lines outside of
+ * this chunk are ignored by those actions.
+ */
+class PathGuiExport SoPathEdgeSet : public PartGui::SoBrepEdgeSet {
+    typedef PartGui::SoBrepEdgeSet inherited;
+
+    SO_NODE_HEADER(SoPathEdgeSet);
+
+public:
+    static void initClass();
+    SoPathEdgeSet();
+
+    SoSFInt32 lineOffset;
+
+protected:
+    virtual ~SoPathEdgeSet() {};
+    virtual void doAction(SoAction* action);
+    virtual SoDetail * createLineSegmentDetail(
+        SoRayPickAction *action,
+        const SoPrimitiveVertex *v1,
+        const SoPrimitiveVertex *v2,
+        SoPickedPoint *pp);
+
+private:
+    int toLocalIndex(const SoDetail *detail) const;
+};
+
+} // namespace PathGui
+
+
+#endif // PATHGUI_SOPATHEDGESET_H
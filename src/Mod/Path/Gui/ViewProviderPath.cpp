@@ -25,7 +25,9 @@
 
 #ifndef _PreComp_
 # include <Python.h>
+# include <algorithm>
 # include <Inventor/SbVec3f.h>
+# include <Inventor/nodes/SoGroup.h>
 # include <Inventor/nodes/SoSeparator.h>
 # include <Inventor/nodes/SoTransform.h>
 # include <Inventor/nodes/SoRotation.h>
@@ -44,6 +46,7 @@
 #endif
 
 #include "ViewProviderPath.h"
+#include "SoPathEdgeSet.h"
 
 #include <Mod/Path/App/FeaturePath.h>
 #include <Mod/Path/App/Path.h>
@@ -78,7 +81,7 @@ using namespace PartGui;
 PROPERTY_SOURCE(PathGui::ViewProviderPath, Gui::ViewProviderGeometryObject)
 
 ViewProviderPath::ViewProviderPath()
-    :pt0Index(-1),blockPropertyChange(false),edgeStart(-1),coordStart(-1),coordEnd(-1)
+    :pt0Index(-1),pt0Chunk(-1),blockPropertyChange(false),edgeStart(-1)
 {
     ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
     unsigned long lcol = hGrp->GetUnsigned("DefaultNormalPathColor",11141375UL); // dark green (0,170,0)
@@ -106,9 +109,6 @@ ViewProviderPath::ViewProviderPath()
     ADD_PROPERTY_TYPE(StartIndex,(0),"Show",App::Prop_None,"The index of first GCode to show");
     ADD_PROPERTY_TYPE(ShowCount,(0),"Show",App::Prop_None,"Number of movement GCode to show, 0 means all");
 
-    pcLineCoords = new SoCoordinate3();
-    pcLineCoords->ref();
-
     pcMarkerSwitch = new SoSwitch();
     pcMarkerSwitch->ref();
     pcMarkerSwitch->whichChild = -1;
@@ -126,16 +126,12 @@ ViewProviderPath::ViewProviderPath()
     pcDrawStyle->style = SoDrawStyle::LINES;
     pcDrawStyle->lineWidth = LineWidth.getValue();
 
-    pcLines = new PartGui::SoBrepEdgeSet();
-    pcLines->ref();
-    pcLines->coordIndex.setNum(0);
-
-    pcLineColor = new SoMaterial;
-    pcLineColor->ref();
+    pcLineChunks = new SoGroup();
+    pcLineChunks->ref();
 
     pcMatBind = new SoMaterialBinding;
     pcMatBind->ref();
-    pcMatBind->value = SoMaterialBinding::OVERALL;
+    pcMatBind->value = SoMaterialBinding::PER_PART;
 
     pcMarkerColor = new SoBaseColor;
     pcMarkerColor->ref();
@@ -175,13 +171,11 @@ ViewProviderPath::ViewProviderPath()
 
 ViewProviderPath::~ViewProviderPath()
 {
-    pcLineCoords->unref();
     pcMarkerCoords->unref();
     pcMarkerSwitch->unref();
     pcDrawStyle->unref();
     pcMarkerStyle->unref();
-    pcLines->unref();
-    pcLineColor->unref();
+    pcLineChunks->unref();
     pcMatBind->unref();
     pcMarkerColor->unref();
     pcArrowSwitch->unref();
@@ -193,11 +187,9 @@ void ViewProviderPath::attach(App::DocumentObject *pcObj)
 
     // Draw trajectory lines
     SoSeparator* linesep = new SoSeparator;
-    linesep->addChild(pcLineColor);
     linesep->addChild(pcMatBind);
     linesep->addChild(pcDrawStyle);
-    linesep->addChild(pcLineCoords);
-    linesep->addChild(pcLines);
+    linesep->addChild(pcLineChunks);
 
     // Draw markers
     SoSeparator* markersep = new SoSeparator;
@@ -238,8 +230,10 @@ std::string ViewProviderPath::getElement(const SoDetail* detail) const
 {
     if(edgeStart>=0 && detail && detail->getTypeId() == SoLineDetail::getClassTypeId()) {
         const SoLineDetail* line_detail = static_cast<const SoLineDetail*>(detail);
-        int index = line_detail->getLineIndex()+edgeStart;
+        // SoPathEdgeSet reports the edge index in the whole path
+        int index = line_detail->getLineIndex();
         if(index>=0 && index<(int)edge2Command.size()) {
+            int chunk = index/ChunkSize;
             index = edge2Command[index];
             Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
             const Toolpath &tp = pcPathObj->Path.getValue();
@@ -247,7 +241,9 @@ std::string ViewProviderPath::getElement(const SoDetail* detail) const
                 std::stringstream str;
                 str << index+1 << " " << tp.getCommand(index).toGCode(6,false);
                 pt0Index = line_detail->getPoint0()->getCoordinateIndex();
-                if(pt0Index<0 || pt0Index>=pcLineCoords->point.getNum())
+                pt0Chunk = chunk;
+                if(chunk>=(int)chunks.size() || pt0Index<0 ||
+                   pt0Index>=chunks[chunk].pcCoords->point.getNum())
                     pt0Index = -1;
                 return str.str();
             }
@@ -266,7 +262,7 @@ SoDetail* ViewProviderPath::getDetail(const char* subelement) const
         index = command2Edge[index-1];
         if(index>=0 && edgeStart>=0 && edgeStart<=index) {
             detail = new SoLineDetail();
-            static_cast<SoLineDetail*>(detail)->setLineIndex(index-edgeStart);
+            static_cast<SoLineDetail*>(detail)->setLineIndex(index);
         }
     }
     return detail;
@@ -274,7 +270,8 @@ SoDetail* ViewProviderPath::getDetail(const char* subelement) const
 
 void ViewProviderPath::onSelectionChanged(const Gui::SelectionChanges& msg) {
     if(msg.Type == Gui::SelectionChanges::SetPreselect && msg.pSubName && 
-       pt0Index >= 0 && getObject() && getObject()->getDocument())
+       pt0Index >= 0 && pt0Chunk < (int)chunks.size() &&
+       getObject() && getObject()->getDocument())
     { 
         const char *docName = getObject()->getDocument()->getName();
         const char *objName = getObject()->getNameInDocument();
@@ -285,7 +282,7 @@ void ViewProviderPath::onSelectionChanged(const Gui::SelectionChanges& msg) {
             Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
             Base::Vector3d pt = pcPathObj->Placement.getValue().inverse().toMatrix()*
                                     Base::Vector3d(msg.x,msg.y,msg.z);
-            const SbVec3f &ptTo = *pcLineCoords->point.getValues(pt0Index);
+            const SbVec3f &ptTo = *chunks[pt0Chunk].pcCoords->point.getValues(pt0Index);
             SbVec3f ptFrom(pt.x,pt.y,pt.z);
             if(ptFrom != ptTo) {
                 pcArrowTransform->pointAt(ptFrom,ptTo);
@@ -304,37 +301,11 @@ void ViewProviderPath::onChanged(const App::Property* prop)
     if (prop == &LineWidth) {
         pcDrawStyle->lineWidth = LineWidth.getValue();
     } else if (prop == &NormalColor) {
-        if (colorindex.size() > 0 && coordStart>=0 && coordStart<(int)colorindex.size()) {
-            const App::Color& c = NormalColor.getValue();
-            ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
-            unsigned long rcol = hGrp->GetUnsigned("DefaultRapidPathColor",2852126975UL); // dark red (170,0,0)
-            float rr,rg,rb;
-            rr = ((rcol >> 24) & 0xff) / 255.0; rg = ((rcol >> 16) & 0xff) / 255.0; rb = ((rcol >> 8) & 0xff) / 255.0;
-
-            unsigned long pcol = hGrp->GetUnsigned("DefaultProbePathColor",4293591295UL); // yellow (255,255,5)
-            float pr,pg,pb;
-            pr = ((pcol >> 24) & 0xff) / 255.0; pg = ((pcol >> 16) & 0xff) / 255.0; pb = ((pcol >> 8) & 0xff) / 255.0;
-
-            pcMatBind->value = SoMaterialBinding::PER_PART;
-            // resizing and writing the color vector:
-            
-            int count = coordEnd-coordStart;
-            if(count > (int)colorindex.size()-coordStart) count = colorindex.size()-coordStart;
-            pcLineColor->diffuseColor.setNum(count);
-            SbColor* colors = pcLineColor->diffuseColor.startEditing();
-            for(int i=0;i<count;i++) {
-                switch(colorindex[i+coordStart]){
-                case 0:
-                    colors[i] = SbColor(rr,rg,rb);
-                    break;
-                case 1:
-                    colors[i] = SbColor(c.r,c.g,c.b);
-                    break;
-                default:
-                    colors[i] = SbColor(pr,pg,pb);
-                }
-            }
-            pcLineColor->diffuseColor.finishEditing();
+        SbColor colors[3];
+        getLineColors(colors);
+        for(auto &chunk : chunks) {
+            if(chunk.showStart>=0)
+                showChunk(chunk,chunk.showStart,chunk.showEnd,colors);
         }
     } else if (prop == &MarkerColor) {
         const App::Color& c = MarkerColor.getValue();
@@ -347,9 +318,9 @@ void ViewProviderPath::onChanged(const App::Property* prop)
         updateVisual();
         if (vis) show();
     } else if (prop == &StartPosition) {
-        if(pcLineCoords->point.getNum()){
+        if(chunks.size()){
             const Base::Vector3d &pt = StartPosition.getValue();
-            pcLineCoords->point.set1Value(0,pt.x,pt.y,pt.z);
+            chunks.front().pcCoords->point.set1Value(0,pt.x,pt.y,pt.z);
             pcMarkerCoords->point.set1Value(0,pt.x,pt.y,pt.z);
         }
     } else {
@@ -361,7 +332,7 @@ void ViewProviderPath::onChanged(const App::Property* prop)
 
 void ViewProviderPath::showBoundingBox(bool show) {
     if(show) {
-        if(!pcLineCoords->point.getNum()) 
+        if(chunks.empty())
             return;
     }
     inherited::showBoundingBox(show);
@@ -405,13 +376,15 @@ void ViewProviderPath::updateData(const App::Property* prop)
 }
 
 void ViewProviderPath::hideSelection() {
-    // Clear selection
     SoSelectionElementAction saction(Gui::SoSelectionElementAction::None);
-    saction.apply(pcLines);
-
-    // Clear highlighting
     SoHighlightElementAction haction;
-    haction.apply(pcLines);
+    for(auto &chunk : chunks) {
+        // Clear selection
+        saction.apply(chunk.pcLines);
+
+        // Clear highlighting
+        haction.apply(chunk.pcLines);
+    }
 
     // Hide arrow
     pcArrowSwitch->whichChild = -1;
@@ -437,19 +410,21 @@ void ViewProviderPath::updateVisual(bool rebuild) {
     
     updateShowConstraints();
 
-    pcLines->coordIndex.deleteValues(0);
-
     if(rebuild) {
-        pcLineCoords->point.deleteValues(0);
         pcMarkerCoords->point.deleteValues(0);
 
+        // keep the old edges to find out the unchanged chunks
+        std::vector<int> oldEdgeIndices;
+        std::vector<int> oldColorIndex;
+        oldEdgeIndices.swap(edgeIndices);
+        oldColorIndex.swap(colorindex);
         command2Edge.clear();
         edge2Command.clear();
-        edgeIndices.clear();
 
         Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
         const Toolpath &tp = pcPathObj->Path.getValue();
         if(tp.getSize()==0) {
+            updateChunks(std::vector<SbVec3f>(),oldEdgeIndices,oldColorIndex);
             return;
         }
 
@@ -465,7 +440,6 @@ void ViewProviderPath::updateVisual(bool rebuild) {
         double B = 0.0;
         double C = 0.0;
 
-        colorindex.clear();
         bool absolute = true;
         bool absolutecenter = false;
 
@@ -717,62 +691,175 @@ void ViewProviderPath::updateVisual(bool rebuild) {
             }
         }
 
-        if (!edgeIndices.empty()) {
-            pcLineCoords->point.setNum(points.size());
-            SbVec3f* verts = pcLineCoords->point.startEditing();
-            int i=0;
-            for(const auto &pt : points) 
-                verts[i++].setValue(pt.x,pt.y,pt.z);
-            pcLineCoords->point.finishEditing();
+        std::vector<SbVec3f> verts;
+        verts.reserve(points.size());
+        for(const auto &pt : points)
+            verts.push_back(SbVec3f(pt.x,pt.y,pt.z));
+        updateChunks(verts,oldEdgeIndices,oldColorIndex);
 
+        if (!edgeIndices.empty()) {
             pcMarkerCoords->point.setNum(markers.size());
-            for(unsigned int i=0;i<markers.size();i++)
-                pcMarkerCoords->point.set1Value(i,markers[i].x,markers[i].y,markers[i].z);
+            SbVec3f* mverts = pcMarkerCoords->point.startEditing();
+            int i=0;
+            for(const auto &pt : markers)
+                mverts[i++].setValue(pt.x,pt.y,pt.z);
+            pcMarkerCoords->point.finishEditing();
 
             recomputeBoundingBox();
         }
     }
 
-    // count = index + separators
     edgeStart = -1;
     int i;
     for(i=StartIndex.getValue();i<(int)command2Edge.size();++i)
         if((edgeStart=command2Edge[i])>=0) break;
 
-    if(edgeStart<0) return;
+    int edgeEnd = -1;
+    if(edgeStart>=0) {
+        if(i!=StartIndex.getValue() && StartIndex.getValue()!=0) {
+            blockPropertyChange = true;
+            StartIndex.setValue(i);
+            blockPropertyChange = false;
+            StartIndex.purgeTouched();
+        }
 
-    if(i!=StartIndex.getValue() && StartIndex.getValue()!=0) {
-        blockPropertyChange = true;
-        StartIndex.setValue(i);
-        blockPropertyChange = false;
-        StartIndex.purgeTouched();
+        edgeEnd = edgeStart+ShowCount.getValue();
+        if(edgeEnd==edgeStart || edgeEnd>(int)edgeIndices.size())
+            edgeEnd = edgeIndices.size();
+    }
+
+    // Chunks inside the shown range are switched on as they are, only the
+    // ones at the boundary need to rebuild their line indices.
+    SbColor colors[3];
+    getLineColors(colors);
+    for(std::size_t k=0;k<chunks.size();++k) {
+        PathChunk &chunk = chunks[k];
+        int start = std::max(edgeStart,(int)k*ChunkSize);
+        int end = std::min(edgeEnd,(int)(k+1)*ChunkSize);
+        if(edgeStart<0 || start>=end) {
+            if(chunk.pcSwitch->whichChild.getValue()!=-1)
+                chunk.pcSwitch->whichChild = -1;
+            continue;
+        }
+        if(start!=chunk.showStart || end!=chunk.showEnd)
+            showChunk(chunk,start,end,colors);
+        if(chunk.pcSwitch->whichChild.getValue()!=0)
+            chunk.pcSwitch->whichChild = 0;
+    }
+}
+
+void ViewProviderPath::updateChunks(const std::vector<SbVec3f> &points,
+        const std::vector<int> &oldEdgeIndices, const std::vector<int> &oldColorIndex)
+{
+    int edgeCount = (int)edgeIndices.size();
+    int oldEdgeCount = (int)oldEdgeIndices.size();
+    std::size_t count = (edgeCount+ChunkSize-1)/ChunkSize;
+
+    while(chunks.size()>count) {
+        pcLineChunks->removeChild(pcLineChunks->getNumChildren()-1);
+        chunks.pop_back();
     }
 
-    int edgeEnd = edgeStart+ShowCount.getValue();
-    if(edgeEnd==edgeStart || edgeEnd>(int)edgeIndices.size())
-        edgeEnd = edgeIndices.size();
+    for(std::size_t k=0;k<count;++k) {
+        int start = k*ChunkSize;
+        int end = std::min(edgeCount,start+ChunkSize);
+        int coordStart = start==0?0:(edgeIndices[start-1]-1);
+        int coordEnd = edgeIndices[end-1];
+
+        if(k<chunks.size()) {
+            // Keep the chunk untouched if its discretized geometry has not
+            // changed, so that Coin can keep its render caches.
+            PathChunk &chunk = chunks[k];
+            bool same = std::min(oldEdgeCount,start+ChunkSize)==end &&
+                        chunk.pcCoords->point.getNum()==coordEnd-coordStart;
+            if(same) {
+                int oldCoordStart = start==0?0:(oldEdgeIndices[start-1]-1);
+                for(int e=start;same && e<end;++e)
+                    same = edgeIndices[e]-coordStart == oldEdgeIndices[e]-oldCoordStart;
+                same = same &&
+                    std::equal(colorindex.begin()+coordStart,colorindex.begin()+coordEnd-1,
+                               oldColorIndex.begin()+oldCoordStart) &&
+                    std::equal(points.begin()+coordStart,points.begin()+coordEnd,
+                               chunk.pcCoords->point.getValues(0));
+            }
+            if(same) {
+                chunk.coordBase = coordStart;
+                continue;
+            }
+        } else {
+            PathChunk chunk;
+            chunk.pcSwitch = new SoSwitch();
+            chunk.pcSwitch->whichChild = -1;
+            chunk.pcColor = new SoMaterial();
+            chunk.pcCoords = new SoCoordinate3();
+            chunk.pcLines = new SoPathEdgeSet();
+            SoSeparator* sep = new SoSeparator();
+            sep->addChild(chunk.pcColor);
+            sep->addChild(chunk.pcCoords);
+            sep->addChild(chunk.pcLines);
+            chunk.pcSwitch->addChild(sep);
+            pcLineChunks->addChild(chunk.pcSwitch);
+            chunks.push_back(chunk);
+        }
+
+        PathChunk &chunk = chunks[k];
+        chunk.coordBase = coordStart;
+        chunk.showStart = -1;
+        chunk.showEnd = -1;
+        chunk.pcCoords->point.setNum(coordEnd-coordStart);
+        chunk.pcCoords->point.setValues(0,coordEnd-coordStart,&points[coordStart]);
+    }
+}
 
-    // coord index start
-    coordStart = edgeStart==0?0:(edgeIndices[edgeStart-1]-1);
-    coordEnd = edgeIndices[edgeEnd-1];
+void ViewProviderPath::showChunk(PathChunk &chunk, int start, int end, const SbColor *colors)
+{
+    // coord index range of the shown edges
+    int coordStart = start==0?0:(edgeIndices[start-1]-1);
+    int coordEnd = edgeIndices[end-1];
 
     // count = coord indices + index separators
-    int count = coordEnd-coordStart+2*(edgeEnd-edgeStart-1)+1;
-
-    pcLines->coordIndex.setNum(count);
-    int32_t *idx = pcLines->coordIndex.startEditing();
-    i=0;
-    int start = coordStart;
-    for(int e=edgeStart;e!=edgeEnd;++e) {
-        for(int end=edgeIndices[e];start<end;++start)
-            idx[i++] = start;
+    int count = coordEnd-coordStart+2*(end-start-1)+1;
+
+    chunk.pcLines->coordIndex.setNum(count);
+    int32_t *idx = chunk.pcLines->coordIndex.startEditing();
+    int i=0;
+    int coord = coordStart;
+    for(int e=start;e!=end;++e) {
+        for(int last=edgeIndices[e];coord<last;++coord)
+            idx[i++] = coord-chunk.coordBase;
         idx[i++]=-1;
-        --start;
+        --coord;
     }
-    pcLines->coordIndex.finishEditing();
+    chunk.pcLines->coordIndex.finishEditing();
     assert(i==count);
+    chunk.pcLines->lineOffset.setValue(start);
+
+    // one color per line segment
+    count = coordEnd-coordStart-1;
+    if(count > (int)colorindex.size()-coordStart) count = colorindex.size()-coordStart;
+    chunk.pcColor->diffuseColor.setNum(count);
+    SbColor* diffuse = chunk.pcColor->diffuseColor.startEditing();
+    for(i=0;i<count;i++) {
+        int c = colorindex[i+coordStart];
+        diffuse[i] = colors[(c==0||c==1)?c:2];
+    }
+    chunk.pcColor->diffuseColor.finishEditing();
 
-    NormalColor.touch();
+    chunk.showStart = start;
+    chunk.showEnd = end;
+}
+
+void ViewProviderPath::getLineColors(SbColor *colors) const
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/Path");
+    unsigned long rcol = hGrp->GetUnsigned("DefaultRapidPathColor",2852126975UL); // dark red (170,0,0)
+    colors[0].setValue(((rcol >> 24) & 0xff) / 255.0, ((rcol >> 16) & 0xff) / 255.0, ((rcol >> 8) & 0xff) / 255.0);
+
+    const App::Color& c = NormalColor.getValue();
+    colors[1].setValue(c.r,c.g,c.b);
+
+    unsigned long pcol = hGrp->GetUnsigned("DefaultProbePathColor",4293591295UL); // yellow (255,255,5)
+    colors[2].setValue(((pcol >> 24) & 0xff) / 255.0, ((pcol >> 16) & 0xff) / 255.0, ((pcol >> 8) & 0xff) / 255.0);
 }
 
 void ViewProviderPath::recomputeBoundingBox()
@@ -788,17 +875,21 @@ void ViewProviderPath::recomputeBoundingBox()
     Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
     Base::Placement pl = *(&pcPathObj->Placement.getValue());
     Base::Vector3d pt;
-    for (int i=1;i<pcLineCoords->point.getNum();i++) {
-        pt.x = pcLineCoords->point[i].getValue()[0];
-        pt.y = pcLineCoords->point[i].getValue()[1];
-        pt.z = pcLineCoords->point[i].getValue()[2];
-        pl.multVec(pt,pt);
-        if (pt.x < MinX)  MinX = pt.x;
-        if (pt.y < MinY)  MinY = pt.y;
-        if (pt.z < MinZ)  MinZ = pt.z;
-        if (pt.x > MaxX)  MaxX = pt.x;
-        if (pt.y > MaxY)  MaxY = pt.y;
-        if (pt.z > MaxZ)  MaxZ = pt.z;
+    for (auto &chunk : chunks) {
+        const SbVec3f *points = chunk.pcCoords->point.getValues(0);
+        // skip the start position
+        for (int i=chunk.coordBase?0:1;i<chunk.pcCoords->point.getNum();i++) {
+            pt.x = points[i][0];
+            pt.y = points[i][1];
+            pt.z = points[i][2];
+            pl.multVec(pt,pt);
+            if (pt.x < MinX)  MinX = pt.x;
+            if (pt.y < MinY)  MinY = pt.y;
+            if (pt.z < MinZ)  MinZ = pt.z;
+            if (pt.x > MaxX)  MaxX = pt.x;
+            if (pt.y > MaxY)  MaxY = pt.y;
+            if (pt.z > MaxZ)  MaxZ = pt.z;
+        }
     }
     pcBoundingBox->minBounds.setValue(MinX, MinY, MinZ);
     pcBoundingBox->maxBounds.setValue(MaxX, MaxY, MaxZ);
@@ -29,7 +29,8 @@
 #include <Gui/ViewProviderGeometryObject.h>
 #include <Gui/SoFCSelection.h>
 #include <Gui/ViewProviderPythonFeature.h>
-#include <Mod/Part/Gui/SoBrepEdgeSet.h>
+#include <Inventor/SbColor.h>
+#include <Inventor/SbVec3f.h>
 
 class SoCoordinate3;
 class SoDrawStyle;  
@@ -38,10 +39,13 @@ class SoBaseColor;
 class SoMaterialBinding;
 class SoTransform;
 class SoSwitch;
+class SoGroup;
 
 namespace PathGui
 {
 
+class SoPathEdgeSet;
+
 class PathGuiExport ViewProviderPath : public Gui::ViewProviderGeometryObject
                                      , public Gui::SelectionObserver
 {
@@ -84,19 +88,41 @@ public:
     void updateVisual(bool rebuild = false);
     void hideSelection();
 
+    /// number of edges in each chunk of the visual
+    static const int ChunkSize = 4096;
+
     virtual void showBoundingBox(bool show);
 
 protected:
 
     virtual void onChanged(const App::Property* prop);
     virtual unsigned long getBoundColor() const;
+
+    /** The visual of a fixed number of consecutive edges
+     *
+     * Each chunk keeps its own discretized coordinates, so that changing
+     * the shown range only switches whole chunks on or off, and only the
+     * chunks at the range boundary need their line indices rebuilt.
+     */
+    struct PathChunk {
+        SoSwitch      * pcSwitch;
+        SoCoordinate3 * pcCoords;
+        SoMaterial    * pcColor;
+        SoPathEdgeSet * pcLines;
+        int coordBase; // path coordinate index of the first chunk coordinate
+        int showStart; // first shown edge, or -1 if not built yet
+        int showEnd;
+    };
+
+    void updateChunks(const std::vector<SbVec3f> &points,
+            const std::vector<int> &oldEdgeIndices, const std::vector<int> &oldColorIndex);
+    void showChunk(PathChunk &chunk, int start, int end, const SbColor *colors);
+    void getLineColors(SbColor *colors) const;
  
-    SoCoordinate3         * pcLineCoords;
     SoCoordinate3         * pcMarkerCoords;
     SoDrawStyle           * pcDrawStyle;
     SoDrawStyle           * pcMarkerStyle;
-    PartGui::SoBrepEdgeSet         * pcLines;
-    SoMaterial            * pcLineColor;
+    SoGroup               * pcLineChunks;
     SoBaseColor           * pcMarkerColor;
     SoMaterialBinding     * pcMatBind;
     std::vector<int>        colorindex;
@@ -104,15 +130,15 @@ protected:
     SoSwitch              * pcArrowSwitch;
     SoTransform           * pcArrowTransform;
 
+    std::vector<PathChunk> chunks;
     std::vector<int>   command2Edge;
-    std::deque<int>   edge2Command;
-    std::deque<int>   edgeIndices;
+    std::vector<int>   edge2Command;
+    std::vector<int>   edgeIndices;
 
     mutable int pt0Index;
+    mutable int pt0Chunk;
     bool blockPropertyChange;
     int edgeStart;
-    int coordStart;
-    int coordEnd;
 
  };
  
@@ -243,24 +243,28 @@ class PathSimulation:
             return
         self.busy = True
 
-        cmd = self.opCommands[self.icmd]
-        # for cmd in job.Path.Commands:
-        if cmd.Name in ['G0', 'G1', 'G2', 'G3']:
-            self.curpos = self.voxSim.ApplyCommand(self.curpos, cmd)
-            if not self.disableAnim:
+        if self.disableAnim:
+            # fast forward, simulate the rest of the operation in one go
+            self.curpos = self.voxSim.ApplyPath(self.curpos, Path.Path(self.opCommands[self.icmd:]))
+            self.iprogress += len(self.opCommands) - self.icmd - 1
+            self.icmd = len(self.opCommands) - 1
+        else:
+            cmd = self.opCommands[self.icmd]
+            # for cmd in job.Path.Commands:
+            if cmd.Name in ['G0', 'G1', 'G2', 'G3']:
+                self.curpos = self.voxSim.ApplyCommand(self.curpos, cmd)
                 self.cutTool.Placement = self.curpos  # FreeCAD.Placement(self.curpos, self.stdrot)
                 (self.cutMaterial.Mesh, self.cutMaterialIn.Mesh) = self.voxSim.GetResultMesh()
-        if cmd.Name in ['G81', 'G82', 'G83']:
-            extendcommands = []
-            if self.firstDrill:
-                extendcommands.append(Path.Command('G0', {"X": 0.0, "Y": 0.0, "Z": cmd.r}))
-                self.firstDrill = False
-            extendcommands.append(Path.Command('G0', {"X": cmd.x, "Y": cmd.y, "Z": cmd.r}))
-            extendcommands.append(Path.Command('G1', {"X": cmd.x, "Y": cmd.y, "Z": cmd.z}))
-            extendcommands.append(Path.Command('G1', {"X": cmd.x, "Y": cmd.y, "Z": cmd.r}))
-            for ecmd in extendcommands:
-                self.curpos = self.voxSim.ApplyCommand(self.curpos, ecmd)
-                if not self.disableAnim:
+            if cmd.Name in ['G81', 'G82', 'G83']:
+                extendcommands = []
+                if self.firstDrill:
+                    extendcommands.append(Path.Command('G0', {"X": 0.0, "Y": 0.0, "Z": cmd.r}))
+                    self.firstDrill = False
+                extendcommands.append(Path.Command('G0', {"X": cmd.x, "Y": cmd.y, "Z": cmd.r}))
+                extendcommands.append(Path.Command('G1', {"X": cmd.x, "Y": cmd.y, "Z": cmd.z}))
+                extendcommands.append(Path.Command('G1', {"X": cmd.x, "Y": cmd.y, "Z": cmd.r}))
+                for ecmd in extendcommands:
+                    self.curpos = self.voxSim.ApplyCommand(self.curpos, ecmd)
                     self.cutTool.Placement = self.curpos  # FreeCAD.Placement(self.curpos, self.stdrot)
                     (self.cutMaterial.Mesh, self.cutMaterialIn.Mesh) = self.voxSim.GetResultMesh()
         self.icmd += 1
@@ -24,6 +24,7 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+# include <algorithm>
 # include <boost/regex.hpp>
 #endif
 
@@ -31,6 +32,7 @@
 #include <App/Document.h>
 #include <Base/Exception.h>
 #include <Base/Console.h>
+#include <Base/Sequencer.h>
 
 #include "PathSim.h"
 //#include "VolSim.h"
@@ -58,6 +60,7 @@ PathSim::~PathSim()
 void PathSim::BeginSimulation(Part::TopoShape * stock, float resolution)
 {
 	Base::BoundBox3d bbox = stock->getBoundBox();
+	delete m_stock;
 	m_stock = new cStock(bbox.MinX, bbox.MinY, bbox.MinZ, bbox.LengthX(), bbox.LengthY(), bbox.LengthZ(), resolution);
 }
 
@@ -116,33 +119,14 @@ void PathSim::SetCurrentTool(Tool * tool)
 		angle = 180;
 		break;
 	}
+	delete m_tool;
 	m_tool = new cSimTool(tp, tool->Diameter / 2.0, angle);
 }
 
 Base::Placement * PathSim::ApplyCommand(Base::Placement * pos, Command * cmd)
 {
-	Point3D fromPos(*pos);
 	Point3D toPos(*pos);
-	toPos.UpdateCmd(*cmd);
-	if (m_tool != NULL)
-	{
-		if (cmd->Name == "G0" || cmd->Name == "G1")
-		{
-			m_stock->ApplyLinearTool(fromPos, toPos, *m_tool);
-		}
-		else if (cmd->Name == "G2")
-		{
-			Vector3d vcent = cmd->getCenter();
-			Point3D cent(vcent);
-			m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, false);
-		}
-		else if (cmd->Name == "G3")
-		{
-			Vector3d vcent = cmd->getCenter();
-			Point3D cent(vcent);
-			m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, true);
-		}
-	}
+	ApplyCommand(toPos, *cmd);
 
 	Base::Placement *plc = new Base::Placement();
 	Vector3d vec(toPos.x, toPos.y, toPos.z);
@@ -150,8 +134,63 @@ Base::Placement * PathSim::ApplyCommand(Base::Placement * pos, Command * cmd)
 	return plc;
 }
 
+Base::Placement PathSim::ApplyPath(const Base::Placement & pos, const Toolpath & path)
+{
+	if (m_stock == nullptr)
+		throw Base::RuntimeError("Simulation has no stock object");
+
+	Base::Vector3d vec = pos.getPosition();
+	Point3D curPos(vec);
+	const std::vector<Command*> &cmds = path.getCommands();
+	Base::SequencerLauncher seq("Simulating path...", cmds.size());
+	for (std::vector<Command*>::const_iterator it = cmds.begin(); it != cmds.end(); ++it)
+	{
+		ApplyCommand(curPos, **it);
+		seq.next(true);
+	}
 
+	Base::Placement plc;
+	plc.setPosition(Vector3d(curPos.x, curPos.y, curPos.z));
+	return plc;
+}
 
+void PathSim::GetResultMesh(Mesh::MeshObject & meshOuter, Mesh::MeshObject & meshInner)
+{
+	if (m_stock == nullptr)
+		throw Base::RuntimeError("Simulation has no stock object");
+	m_stock->Tessellate(meshOuter, meshInner);
+}
 
+void PathSim::ApplyCommand(Point3D & pos, const Command & cmd)
+{
+	Point3D fromPos(pos);
+	pos.UpdateCmd(cmd);
+	if (m_tool == nullptr)
+		return;
 
-
+	if (cmd.Name == "G0" || cmd.Name == "G1")
+	{
+		m_stock->ApplyLinearTool(fromPos, pos, *m_tool);
+	}
+	else if (cmd.Name == "G2" || cmd.Name == "G3")
+	{
+		Vector3d vcent = cmd.getCenter();
+		Point3D cent(vcent);
+		m_stock->ApplyCircularTool(fromPos, pos, cent, *m_tool, cmd.Name == "G3");
+	}
+	else if (cmd.Name == "G81" || cmd.Name == "G82" || cmd.Name == "G83")
+	{
+		// drill cycles: rapid to the retract height above the hole, plunge
+		// down to the bottom and back up to the retract height
+		float retract = cmd.has("R") ? (float)cmd.getParam("R") : fromPos.z;
+		float safe = std::max(fromPos.z, retract);
+		Point3D up(fromPos.x, fromPos.y, safe);
+		Point3D above(pos.x, pos.y, safe);
+		Point3D hole(pos.x, pos.y, retract);
+		m_stock->ApplyLinearTool(fromPos, up, *m_tool);
+		m_stock->ApplyLinearTool(up, above, *m_tool);
+		m_stock->ApplyLinearTool(above, hole, *m_tool);
+		m_stock->ApplyLinearTool(hole, pos, *m_tool);
+		pos = hole;
+	}
+}
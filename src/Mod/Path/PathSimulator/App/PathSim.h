@@ -31,6 +31,7 @@
 #include <TopoDS.hxx>
 #include <TopoDS_Shape.hxx>
 #include <Mod/Path/App/Command.h>
+#include <Mod/Path/App/Path.h>
 #include <Mod/Path/App/Tooltable.h>
 #include <Mod/Part/App/TopoShape.h>
 #include "VolSim.h"
@@ -53,6 +54,12 @@ namespace PathSimulator
 			void BeginSimulation(Part::TopoShape * stock, float resolution);
 			void SetCurrentTool(Tool * tool);
 			Base::Placement * ApplyCommand(Base::Placement * pos, Command * cmd);
+			/// simulates all the commands of the path, and returns the final position
+			Base::Placement ApplyPath(const Base::Placement & pos, const Toolpath & path);
+			void GetResultMesh(Mesh::MeshObject & meshOuter, Mesh::MeshObject & meshInner);
+
+		private:
+			void ApplyCommand(Point3D & pos, const Command & cmd);
 
 		public:
 			cStock * m_stock;
@@ -27,6 +27,7 @@
 #include <Base/VectorPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
 #include <Mod/Path/App/CommandPy.h>
+#include <Mod/Path/App/PathPy.h>
 #include <Mod/Mesh/App/MeshPy.h>
 #include "Mod/Path/PathSimulator/App/PathSim.h"
 
@@ -84,10 +85,10 @@ PyObject* PathSimPy::GetResultMesh(PyObject * args)
 {
 	if (!PyArg_ParseTuple(args, ""))
 		return 0;
-	cStock *stock = getPathSimPtr()->m_stock;
-	if (stock == NULL)
+	PathSim *sim = getPathSimPtr();
+	if (sim->m_stock == NULL)
 	{
-		PyErr_SetString(PyExc_RuntimeError, "Simulation has stock object");
+		PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock object");
 		return 0;
 	}
 
@@ -95,7 +96,7 @@ PyObject* PathSimPy::GetResultMesh(PyObject * args)
 	Mesh::MeshPy *meshOuterpy = new Mesh::MeshPy(meshOuter);
 	Mesh::MeshObject *meshInner = new Mesh::MeshObject();
 	Mesh::MeshPy *meshInnerpy = new Mesh::MeshPy(meshInner);
-	stock->Tessellate(*meshOuter, *meshInner);
+	sim->GetResultMesh(*meshOuter, *meshInner);
 	PyObject *tuple = PyTuple_New(2);
 	PyTuple_SetItem(tuple, 0, meshOuterpy);
 	PyTuple_SetItem(tuple, 1, meshInnerpy);
@@ -120,6 +121,20 @@ PyObject* PathSimPy::ApplyCommand(PyObject * args, PyObject * kwds)
 	return newposPy;
 }
 
+PyObject* PathSimPy::ApplyPath(PyObject * args, PyObject * kwds)
+{
+	static char *kwlist[] = { "position", "path", NULL };
+	PyObject *pObjPlace;
+	PyObject *pObjPath;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!O!", kwlist, &(Base::PlacementPy::Type), &pObjPlace, &(Path::PathPy::Type), &pObjPath))
+		return 0;
+	PathSim *sim = getPathSimPtr();
+	Base::Placement *pos = static_cast<Base::PlacementPy*>(pObjPlace)->getPlacementPtr();
+	Path::Toolpath *path = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+	Base::Placement newpos = sim->ApplyPath(*pos, *path);
+	return new Base::PlacementPy(new Base::Placement(newpos));
+}
+
 Py::Object PathSimPy::getTool(void) const
 {
     //return Py::Object();
@@ -24,6 +24,7 @@
 
 #ifndef _PreComp_
 # include <algorithm>
+# include <cmath>
 #endif
 
 #include "VolSim.h"
@@ -504,160 +505,167 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
 	}
 }
 
-void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool)
+// Tool profiles, giving the height of the tool tip above its lowest point as a
+// function of the squared distance from the tool axis in pixel units. They are
+// kept branch free, so that the sweep loops below can be vectorized.
+struct cFlatProfile
 {
-	// translate coordinates
-	Point3D pi1 = ToInner(p1);
-	Point3D pi2 = ToInner(p2);
-	float rad = tool.radius;
-	rad /= m_res;
-	float cupAngle = 180;
-
-	// strait motion
-	float perpDirX = 1;
-	float perpDirY = 0;
-	cLineSegment path(pi1, pi2);
-	if (path.lenXY > SIM_EPSILON) // only if moving along xy
+	inline float operator () (float) const { return 0; }
+};
+
+struct cChamferProfile
+{
+	cChamferProfile(float ratio) : ratio(ratio) {}
+	inline float operator () (float d2) const { return ratio * sqrtf(d2); }
+	float ratio;	// height increment per pixel
+};
+
+struct cRoundProfile
+{
+	cRoundProfile(float rad, float res) : rad(rad), drad(rad * rad), dres(res * res) {}
+	inline float operator () (float d2) const { return rad - sqrtf(std::max(0.0f, drad - d2 * dres)); }
+	float rad, drad, dres;
+};
+
+// Lowers all the pixels covered by the tool moving along a straight segment
+// (given in inner coordinates). The height of each pixel is taken at the closest
+// point of the segment, and the stock columns are contiguous along y, so the
+// inner loop only does arithmetic on consecutive floats.
+template <class Profile>
+void cStock::SweepSegment(const Point3D & pi1, const Point3D & pi2, float rad, Profile profile)
+{
+	float x1 = pi1.x;
+	float y1 = pi1.y;
+	float z1 = pi1.z;
+	float dx = pi2.x - x1;
+	float dy = pi2.y - y1;
+	float dz = pi2.z - z1;
+	float il2 = 0;
+	float l2 = dx * dx + dy * dy;
+	if (l2 > SIM_EPSILON)
+		il2 = 1.0f / l2;
+	else
 	{
-		perpDirX = -path.pDirXY.y;
-		perpDirY = path.pDirXY.x;
-		Point3D start(perpDirX * rad + pi1.x, perpDirY * rad + pi1.y, pi1.z);
-		Point3D mainWay = path.pDir * SIM_WALK_RES;
-		Point3D sideWay(-perpDirX * SIM_WALK_RES, -perpDirY * SIM_WALK_RES, 0);
-		int lenSteps = (int)(path.len / SIM_WALK_RES) + 1;
-		int radSteps = (int)(rad * 2 / SIM_WALK_RES) + 1;
-		float zstep = (pi2.z - pi1.z) / radSteps;
-		float tstep = 2.0 / radSteps;
-		float t = -1;
-		for (int j = 0; j < radSteps; j++)
-		{
-			float z = pi1.z + tool.GetToolProfileAt(t);
-			Point3D p = start;
-			for (int i = 0; i < lenSteps; i++)
-			{
-				int x = (int)p.x;
-				int y = (int)p.y;
-				if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-				{
-					if (m_stock[x][y] > z)
-						m_stock[x][y] = z;
-				}
-				p.Add(mainWay);
-				z += zstep;
-			}
-			t += tstep;
-			start.Add(sideWay);
-		}
+		// vertical move, only the lowest point matters
+		z1 = std::min(pi1.z, pi2.z);
+		dx = dy = dz = 0;
 	}
-	else
-		cupAngle = 360;
 
-	// end cup
-	for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES)
+	// make sure the pixel containing the tool center is always hit
+	rad = std::max(rad, 0.7072f);
+	float drad = rad * rad;
+
+	int xs = std::max(0, (int)floorf(std::min(pi1.x, pi2.x) - rad));
+	int xe = std::min(m_x - 1, (int)floorf(std::max(pi1.x, pi2.x) + rad));
+	float ylo = std::min(pi1.y, pi2.y) - rad;
+	float yhi = std::max(pi1.y, pi2.y) + rad;
+	for (int x = xs; x <= xe; x++)
 	{
-		Point3D cupCirc(perpDirX * r, perpDirY * r, pi2.z);
-		float rotang = 180 * SIM_WALK_RES / (3.1415926535 * r);
-		cupCirc.SetRotationAngle(-rotang);
-		float z = pi2.z + tool.GetToolProfileAt(r / rad);
-		for (float a = 0; a < cupAngle; a += rotang)
+		float px = x + 0.5f - x1;
+		int ys, ye;
+		if (fabsf(dx) > SIM_EPSILON)
 		{
-			int x = (int)(pi2.x + cupCirc.x);
-			int y = (int)(pi2.y + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
-			cupCirc.Rotate();
+			// clip the segment to the band of width 2*rad around this column
+			float ta = (px - rad) / dx;
+			float tb = (px + rad) / dx;
+			if (ta > tb)
+				std::swap(ta, tb);
+			ta = std::max(0.0f, ta);
+			tb = std::min(1.0f, tb);
+			if (ta > tb)
+				continue;
+			float ya = y1 + ta * dy;
+			float yb = y1 + tb * dy;
+			ys = (int)floorf(std::min(ya, yb) - rad);
+			ye = (int)floorf(std::max(ya, yb) + rad);
+		}
+		else
+		{
+			ys = (int)floorf(ylo);
+			ye = (int)floorf(yhi);
+		}
+		ys = std::max(0, ys);
+		ye = std::min(m_y - 1, ye);
+
+		float *col = m_stock[x];
+		for (int y = ys; y <= ye; y++)
+		{
+			float py = y + 0.5f - y1;
+			float t = std::min(1.0f, std::max(0.0f, (px * dx + py * dy) * il2));
+			float ex = px - t * dx;
+			float ey = py - t * dy;
+			float d2 = ex * ex + ey * ey;
+			float z = z1 + t * dz + profile(d2);
+			float cur = col[y];
+			col[y] = std::min(cur, d2 <= drad ? z : cur);
 		}
 	}
 }
 
+void cStock::ApplyToolSegment(const Point3D & pi1, const Point3D & pi2, cSimTool & tool)
+{
+	float rad = tool.radius / m_res;
+	switch (tool.type)
+	{
+	case cSimTool::FLAT:
+		SweepSegment(pi1, pi2, rad, cFlatProfile());
+		break;
+
+	case cSimTool::CHAMFER:
+		SweepSegment(pi1, pi2, rad, cChamferProfile(rad > SIM_EPSILON ? tool.chamRatio / rad : 0));
+		break;
+
+	case cSimTool::ROUND:
+		SweepSegment(pi1, pi2, rad, cRoundProfile(tool.radius, m_res));
+		break;
+	}
+}
+
+void cStock::ApplyLinearTool(Point3D & p1, Point3D & p2, cSimTool & tool)
+{
+	// translate coordinates
+	Point3D pi1 = ToInner(p1);
+	Point3D pi2 = ToInner(p2);
+	ApplyToolSegment(pi1, pi2, tool);
+}
+
 void cStock::ApplyCircularTool(Point3D & p1, Point3D & p2, Point3D & cent, cSimTool & tool, bool isCCW)
 {
 	// translate coordinates
 	Point3D pi1 = ToInner(p1);
 	Point3D pi2 = ToInner(p2);
-	Point3D centi(cent.x / m_res, cent.y / m_res, cent.z);
-	float rad = tool.radius;
-	rad /= m_res;
-	float cpx = centi.x;
-	float cpy = centi.y;
-
-	Point3D xynorm = unit(Point3D(-cpx, -cpy, 0));
-	float crad = sqrt(cpx * cpx + cpy * cpy);
-	//bool shortRad = (crad - rad) < 0.0001;
-	//if (shortRad)
-	//	rad = crad;
-	float crad1 = std::max((float)0.5, crad - rad);
-	float crad2 = crad + rad;
-
-	float sang = atan2(-cpy, -cpx); // start angle
-
-	cpx += pi1.x;
-	cpy += pi1.y;
-	double eang = atan2(pi2.y - cpy, pi2.x - cpx); // end angle
-
-	double ang = eang - sang;
-	if (!isCCW && ang > 0)
-		ang -= 2 * 3.1415926;
-	if (isCCW && ang < 0)
-		ang += 2 * 3.1415926;
-	ang = fabs(ang);
-
-	// apply path
-	Point3D cupCirc;
-	float tstep = (float)SIM_WALK_RES / rad;
-	float t = -1;
-	for (float r = crad1; r <= crad2; r += (float)SIM_WALK_RES)
+	float cpx = pi1.x + cent.x / m_res;
+	float cpy = pi1.y + cent.y / m_res;
+	float crad = sqrtf((pi1.x - cpx) * (pi1.x - cpx) + (pi1.y - cpy) * (pi1.y - cpy));
+
+	float sang = atan2f(pi1.y - cpy, pi1.x - cpx); // start angle
+	float eang = atan2f(pi2.y - cpy, pi2.x - cpx); // end angle
+	float ang = eang - sang;
+	if (fabsf(ang) < SIM_EPSILON)
+		ang = 0; // same start and end point, full circle
+	if (!isCCW && ang >= 0)
+		ang -= 2 * 3.1415926535f;
+	if (isCCW && ang <= 0)
+		ang += 2 * 3.1415926535f;
+
+	// sweep the tool along chords of the arc
+	int ndivs = 1;
+	if (crad > SIM_ARC_TOLERANCE)
 	{
-		cupCirc.x = xynorm.x * r;
-		cupCirc.y = xynorm.y * r;
-		float rotang = (float)SIM_WALK_RES / r;
-		int ndivs = (int)(ang / rotang) + 1;
-		if (!isCCW)
-			rotang = -rotang;
-		cupCirc.SetRotationAngleRad(rotang);
-		float z = pi1.z + tool.GetToolProfileAt(t);
-		float zstep = (pi2.z - pi1.z) / ndivs;
-		for (int i = 0; i< ndivs; i++)
-		{
-			int x = (int)(cpx + cupCirc.x);
-			int y = (int)(cpy + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
-			z += zstep;
-			cupCirc.Rotate();
-		}
-		t += tstep;
+		float step = 2 * acosf(1 - SIM_ARC_TOLERANCE / crad);
+		ndivs = std::max(1, (int)ceilf(fabsf(ang) / step));
 	}
-
-	// apply end cup
-	xynorm.SetRotationAngleRad(ang);
-	xynorm.Rotate();
-	for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES)
+	Point3D from = pi1;
+	for (int i = 1; i <= ndivs; i++)
 	{
-		Point3D cupCirc(xynorm.x * r, xynorm.y * r, 0);
-		float rotang = (float)SIM_WALK_RES / r;
-		int ndivs = (int)(3.1415926535 / rotang) + 1;
-		if (!isCCW)
-			rotang = -rotang;
-		cupCirc.SetRotationAngleRad(rotang);
-		float z = pi2.z + tool.GetToolProfileAt(r / rad);
-		for (int i = 0; i < ndivs; i++)
+		Point3D to = pi2;
+		if (i < ndivs)
 		{
-			int x = (int)(pi2.x + cupCirc.x);
-			int y = (int)(pi2.y + cupCirc.y);
-			if (x >= 0 && y >= 0 && x < m_x && y < m_y)
-			{
-				if (m_stock[x][y] > z)
-					m_stock[x][y] = z;
-			}
-			cupCirc.Rotate();
+			float a = sang + ang * i / ndivs;
+			to.set(cpx + crad * cosf(a), cpy + crad * sinf(a), pi1.z + (pi2.z - pi1.z) * i / ndivs);
 		}
+		ApplyToolSegment(from, to, tool);
+		from = to;
 	}
 }
 
@@ -699,14 +707,18 @@ void Point3D::SetRotationAngle(float angle)
 	SetRotationAngleRad(angle * 2 * 3.1415926535 / 360);
 }
 
-void Point3D::UpdateCmd(Path::Command & cmd)
+void Point3D::UpdateCmd(const Path::Command & cmd)
 {
-	if (cmd.has("X"))
-		x = cmd.getPlacement().getPosition()[0];
-	if (cmd.has("Y"))
-		y = cmd.getPlacement().getPosition()[1];
-	if (cmd.has("Z"))
-		z = cmd.getPlacement().getPosition()[2];
+	std::map<std::string, double>::const_iterator it;
+	it = cmd.Parameters.find("X");
+	if (it != cmd.Parameters.end())
+		x = it->second;
+	it = cmd.Parameters.find("Y");
+	if (it != cmd.Parameters.end())
+		y = it->second;
+	it = cmd.Parameters.find("Z");
+	if (it != cmd.Parameters.end())
+		z = it->second;
 }
 
 //************************************************************************************************************
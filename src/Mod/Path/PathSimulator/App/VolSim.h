@@ -33,7 +33,7 @@
 #define SIM_EPSILON 0.00001
 #define SIM_TESSEL_TOP		1
 #define SIM_TESSEL_BOT		2
-#define SIM_WALK_RES		0.6   // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_ARC_TOLERANCE	0.25  // max distance between an arc and its chords in pixel units
 struct Point3D
 {
 	Point3D() : x(0), y(0), z(0), sina(0), cosa(0) {}
@@ -43,7 +43,7 @@ struct Point3D
 	inline void set(float px, float py, float pz) { x = px; y = py; z = pz; }
 	inline void Add(Point3D & p) { x += p.x; y += p.y; z += p.z; }
 	inline void Rotate() { float tx = x;  x = x * cosa - y * sina; y = tx * sina + y * cosa; }
-	void UpdateCmd(Path::Command & cmd);
+	void UpdateCmd(const Path::Command & cmd);
 	void SetRotationAngle(float angle);
 	void SetRotationAngleRad(float angle);
 	float x, y, z;
@@ -146,6 +146,9 @@ public:
 	}
 
 private:
+	void ApplyToolSegment(const Point3D & pi1, const Point3D & pi2, cSimTool & tool);
+	template <class Profile>
+	void SweepSegment(const Point3D & pi1, const Point3D & pi2, float rad, Profile profile);
 	float FindRectTop(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz);
 	void FindRectBot(int & xp, int & yp, int & x_size, int & y_size, bool scanHoriz);
 	void SetFacetPoints(MeshCore::MeshGeomFacet & facet, Point3D & p1, Point3D & p2, Point3D & p3);
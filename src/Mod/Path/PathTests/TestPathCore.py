@@ -126,6 +126,23 @@ G0 Z0.500000
         p.setFromGCode(lines)
         self.assertEqual (p.toGCode(), output)
 
+    def test15(self):
+        """Test Path gcode parsing of comments and units"""
+
+        lines = 'G20\nG0 X1 Y2 (rapid move)\nG21\nG1 X1 F100\n(unterminated'
+        p = Path.Path()
+        p.setFromGCode(lines)
+        self.assertEqual(p.toGCode(), 'G0 X25.400000 Y50.800000\n(rapid move)\nG1 F100.000000 X1.000000\n')
+
+        # a big program has to survive a round trip unchanged
+        cmds = [Path.Command('G1', {'X': i * 0.5, 'Y': -i * 0.25, 'F': 200}) for i in range(10000)]
+        p = Path.Path(cmds)
+        gcode = p.toGCode()
+        p2 = Path.Path()
+        p2.setFromGCode(gcode)
+        self.assertEqual(p2.Size, 10000)
+        self.assertEqual(p2.toGCode(), gcode)
+
     def test20(self):
         """Test Path Tool and ToolTable object core functionality"""
 
@@ -155,3 +172,22 @@ G0 Z0.500000
 
         self.assertEqual(len(table.Tools), 2)
         self.assertEqual(str(table.Tools), '{1: Tool 12.7mm Drill Bit, 2: Tool my other tool}' )
+
+    def test30(self):
+        """Test optimized wire sorting"""
+        import Part
+
+        shapes = []
+        for z in (0, 5):
+            for i in range(20):
+                for j in range(20):
+                    shapes.append(Part.Wire(Part.makeCircle(1, FreeCAD.Vector(i*5, (j*7)%20*5, z))))
+            for i in range(10):
+                shapes.append(Part.Wire(Part.makeLine(FreeCAD.Vector(i*10, -10, z), FreeCAD.Vector(i*10+5, -10, z))))
+
+        # sort mode 'Optimized', with and without 2-opt refinement
+        for limit in (1.0, 0):
+            (wires, end) = Path.sortWires(shapes, sort_mode=4, sort_time_limit=limit)
+            self.assertEqual(len(wires), len(shapes))
+            # layers are processed from the top
+            self.assertEqual([round(w.BoundBox.ZMax) for w in wires], [5]*410 + [0]*410)
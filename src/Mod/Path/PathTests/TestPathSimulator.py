@@ -0,0 +1,118 @@
+# -*- coding: utf-8 -*-
+
+# ***************************************************************************
+# *                                                                         *
+# *   Copyright (c) 2026 FreeCAD Project Association                        *
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import FreeCAD
+import Part
+import Path
+import PathSimulator
+import time
+
+from FreeCAD import Placement, Rotation, Vector
+from PathTests.PathTestUtils import PathTestBase
+
+class TestPathSimulator(PathTestBase):
+
+    def simulator(self, tooltype='EndMill', resolution=0.1):
+        sim = PathSimulator.PathSim()
+        sim.BeginSimulation(Part.makeBox(20, 20, 10), resolution)
+        sim.SetCurrentTool(Path.Tool(name='t1', tooltype=tooltype, diameter=2.0))
+        return sim
+
+    def start(self):
+        return Placement(Vector(0, 0, 15), Rotation())
+
+    def test00(self):
+        '''Verify a straight slot is cut with a flat end mill.'''
+        sim = self.simulator()
+        path = Path.Path([
+            Path.Command('G0', {'X': 5, 'Y': 10}),
+            Path.Command('G1', {'Z': 7}),
+            Path.Command('G1', {'X': 15})])
+        pos = sim.ApplyPath(self.start(), path)
+        self.assertCoincide(pos.Base, Vector(15, 10, 7))
+
+        (outer, inner) = sim.GetResultMesh()
+        self.assertRoughly(inner.BoundBox.ZMin, 7)
+        self.assertRoughly(inner.BoundBox.XMin, 4, 0.2)
+        self.assertRoughly(inner.BoundBox.XMax, 16, 0.2)
+        self.assertRoughly(inner.BoundBox.YMin, 9, 0.2)
+        self.assertRoughly(inner.BoundBox.YMax, 11, 0.2)
+
+    def test10(self):
+        '''Verify arcs and drill cycles.'''
+        sim = self.simulator()
+        path = Path.Path([
+            Path.Command('G0', {'X': 5, 'Y': 10}),
+            Path.Command('G1', {'Z': 8}),
+            Path.Command('G2', {'X': 5, 'Y': 10, 'I': 5, 'J': 0}),
+            Path.Command('G0', {'Z': 15}),
+            Path.Command('G81', {'X': 10, 'Y': 10, 'Z': 5, 'R': 12})])
+        pos = sim.ApplyPath(self.start(), path)
+        self.assertCoincide(pos.Base, Vector(10, 10, 12))
+
+        (outer, inner) = sim.GetResultMesh()
+        self.assertRoughly(inner.BoundBox.ZMin, 5)
+        # the full circle is cut all around
+        self.assertRoughly(inner.BoundBox.XMin, 4, 0.2)
+        self.assertRoughly(inner.BoundBox.XMax, 16, 0.2)
+        self.assertRoughly(inner.BoundBox.YMin, 4, 0.2)
+        self.assertRoughly(inner.BoundBox.YMax, 16, 0.2)
+
+    def test20(self):
+        '''Verify the tool profile is applied.'''
+        sim = self.simulator('BallEndMill')
+        path = Path.Path([
+            Path.Command('G0', {'X': 10, 'Y': 10}),
+            Path.Command('G1', {'Z': 8})])
+        sim.ApplyPath(self.start(), path)
+        (outer, inner) = sim.GetResultMesh()
+        self.assertRoughly(inner.BoundBox.ZMin, 8, 0.01)
+        self.assertRoughly(inner.BoundBox.XLength, 2, 0.2)
+        # the ball leaves a bowl, only its center reaches the full depth
+        xs = [p.x for p in inner.Points if p.z < 8.1]
+        self.assertTrue(max(xs) - min(xs) < 1.5)
+
+    def test30(self):
+        '''Simulate a large zig-zag clearing program.'''
+        sim = self.simulator(resolution=0.05)
+        gcode = ['G0 X0 Y0 Z15']
+        for depth in range(1, 11):
+            gcode.append('G1 Z%.1f' % (10 - depth * 0.5))
+            for i in range(200):
+                y = i * 0.1
+                gcode.append('G1 X20 Y%.2f' % y if i % 2 == 0 else 'G1 X0 Y%.2f' % y)
+                gcode.append('G1 Y%.2f' % (y + 0.1))
+            gcode.append('G0 Z15')
+            gcode.append('G0 X0 Y0')
+        path = Path.Path('\n'.join(gcode))
+        self.assertEqual(path.Size, 4031)
+
+        start = time.time()
+        sim.ApplyPath(self.start(), path)
+        FreeCAD.Console.PrintLog('simulated %d commands in %.3fs\n' % (path.Size, time.time() - start))
+
+        (outer, inner) = sim.GetResultMesh()
+        # whole stock is cleared 5mm deep
+        self.assertRoughly(inner.BoundBox.ZMin, 5)
+        self.assertRoughly(outer.BoundBox.ZMax, 5)
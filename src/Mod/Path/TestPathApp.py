@@ -38,6 +38,7 @@ from PathTests.TestPathTool import TestPathTool
 from PathTests.TestPathTooltable import TestPathTooltable
 from PathTests.TestPathToolController import TestPathToolController
 from PathTests.TestPathSetupSheet import TestPathSetupSheet
+from PathTests.TestPathSimulator import TestPathSimulator
 from PathTests.TestPathDeburr  import TestPathDeburr
 
 # dummy usage to get flake8 and lgtm quiet
@@ -55,5 +56,6 @@ False if TestPathTool.__name__ else True
 False if TestPathTooltable.__name__ else True
 False if TestPathToolController.__name__ else True
 False if TestPathSetupSheet.__name__ else True
+False if TestPathSimulator.__name__ else True
 False if TestPathDeburr.__name__ else True
 
@@ -31,6 +31,8 @@
 # include <TopExp_Explorer.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Face.hxx>
+# include <Standard_Version.hxx>
+# include <algorithm>
 # include <sstream>
 #endif
 
@@ -40,6 +42,7 @@
 #include <Base/Matrix.h>
 #include <App/ComplexGeoData.h>
 #include <boost/regex.hpp>
+#include <Mod/Part/App/Parallel.h>
 
 
 #include "PovTools.h"
@@ -70,13 +73,20 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
-    TopExp_Explorer ex;
+#if OCC_VERSION_HEX >= 0x060600
+    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation,Standard_False,0.5,Standard_True);
+#else
     BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+#endif
+
+    // the Lux mesh is a single shape, so repeated faces can't be instanced
+    std::vector<TopoDS_Face> faces;
+    std::vector<int> instanceOf;
+    PovTools::getFaces(Shape, faces, instanceOf);
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
+    // start sequencer
+    int count = static_cast<int>(faces.size());
+    Base::SequencerLauncher seq("Writing file", count+1);
     
     // write object
     out << "AttributeBegin #  \"" << PartName << "\"" << endl;
@@ -88,45 +98,48 @@ void LuxTools::writeShape(std::ostream &out, const char *PartName, const TopoDS_
     std::stringstream triindices;
     std::stringstream N;
     std::stringstream P;
-    l = 1;
     int vi = 0;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
-
-        PovTools::transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
-        // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            P << vertices[i].X() << " " << vertices[i].Y() << " " << vertices[i].Z() << " ";
+    bool complete = true;
+    std::vector<FaceMesh> meshes;
+    std::vector<char> valid;
+    const int batchSize = 256;
+    for (int first = 0; first < count && complete; first += batchSize) {
+        // the faces are triangulated in parallel, a batch at a time
+        int last = std::min(first + batchSize, count);
+        meshes.assign(last - first, FaceMesh());
+        valid.assign(last - first, 0);
+        Part::Parallel::forEach(last - first, [&](std::size_t k) {
+            valid[k] = PovTools::transferToMesh(faces[first + k], meshes[k]);
+        });
+
+        for (int l = first; l < last; l++) {
+            if (!valid[l - first]) {
+                Base::Console().Log("Empty face triangulation\n");
+                complete = false;
+                break;
+            }
+            const FaceMesh& mesh = meshes[l - first];
+
+            // writing vertices
+            for (std::vector<gp_Vec>::const_iterator it = mesh.vertices.begin(); it != mesh.vertices.end(); ++it) {
+                P << it->X() << " " << it->Y() << " " << it->Z() << " ";
+            }
+
+            // writing per vertex normals
+            for (std::vector<gp_Vec>::const_iterator it = mesh.normals.begin(); it != mesh.normals.end(); ++it) {
+                N << it->X() << " "  << it->Y() << " " << it->Z() << " ";
+            }
+
+            // writing triangle indices
+            std::size_t nbTriInFace = mesh.indices.size() / 3;
+            for (std::size_t k=0; k < nbTriInFace; k++) {
+                triindices << mesh.indices[3*k]+vi << " " << mesh.indices[3*k+2]+vi << " " << mesh.indices[3*k+1]+vi << " ";
+            }
+
+            vi = vi + static_cast<int>(mesh.vertices.size());
+
+            seq.next();
         }
-
-        // writing per vertex normals
-        for (int j=0; j < nbNodesInFace; j++) {
-            N << vertexnormals[j].X() << " "  << vertexnormals[j].Y() << " " << vertexnormals[j].Z() << " ";
-        }
-
-        // writing triangle indices
-        for (int k=0; k < nbTriInFace; k++) {
-            triindices << cons[3*k]+vi << " " << cons[3*k+2]+vi << " " << cons[3*k+1]+vi << " ";
-        }
-        
-        vi = vi + nbNodesInFace;
-        
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
-
-        seq.next();
-
     } // end of face loop
 
     // write mesh data
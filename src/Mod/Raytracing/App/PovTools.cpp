@@ -31,6 +31,13 @@
 # include <TopExp_Explorer.hxx>
 # include <TopoDS.hxx>
 # include <TopoDS_Face.hxx>
+# include <gp_Trsf.hxx>
+# include <Precision.hxx>
+# include <Standard_Version.hxx>
+# include <algorithm>
+# include <cmath>
+# include <cstdio>
+# include <map>
 # include <sstream>
 #endif
 
@@ -38,6 +45,7 @@
 #include <Base/Exception.h>
 #include <Base/Sequencer.h>
 #include <App/ComplexGeoData.h>
+#include <Mod/Part/App/Parallel.h>
 
 
 #include "PovTools.h"
@@ -211,6 +219,103 @@ void PovTools::writeData(const char *FileName, const char *PartName,
     fout.close();
 }
 
+// number of faces that are triangulated and formatted at once
+static const int FaceBatchSize = 256;
+
+// the text is formatted the same way as by a std::ostream with its default settings
+static inline void appendNumber(std::string& buf, double value)
+{
+    char tmp[32];
+    int len = snprintf(tmp, sizeof(tmp), "%g", value);
+    buf.append(tmp, len);
+}
+
+static inline void appendNumber(std::string& buf, long value)
+{
+    char tmp[32];
+    int len = snprintf(tmp, sizeof(tmp), "%ld", value);
+    buf.append(tmp, len);
+}
+
+static void appendHeader(std::string& buf, const char *PartName, int l)
+{
+    buf += "// face number";
+    appendNumber(buf, static_cast<long>(l));
+    buf += " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++\n#declare ";
+    buf += PartName;
+    appendNumber(buf, static_cast<long>(l));
+}
+
+static void appendVectors(std::string& buf, const std::vector<gp_Vec>& vectors)
+{
+    buf += "    ";
+    appendNumber(buf, static_cast<long>(vectors.size()));
+    buf += ",\n";
+    for (std::vector<gp_Vec>::const_iterator it = vectors.begin(); it != vectors.end(); ++it) {
+        buf += "    <";
+        appendNumber(buf, it->X());
+        buf += ',';
+        appendNumber(buf, it->Z());
+        buf += ',';
+        appendNumber(buf, it->Y());
+        buf += ">,\n";
+    }
+}
+
+void PovTools::formatMesh(std::string& buf, const char *PartName, int l, const FaceMesh& mesh)
+{
+    buf.reserve(64 * (2 * mesh.vertices.size() + mesh.indices.size() / 3) + 256);
+
+    // writing per face header
+    appendHeader(buf, PartName, l);
+    buf += " = mesh2{\n  vertex_vectors {\n";
+    // writing vertices
+    appendVectors(buf, mesh.vertices);
+    // writing per vertex normals
+    buf += "  }\n  normal_vectors {\n";
+    appendVectors(buf, mesh.normals);
+
+    // writing triangle indices
+    buf += "  }\n  face_indices {\n    ";
+    std::size_t nbTriInFace = mesh.indices.size() / 3;
+    appendNumber(buf, static_cast<long>(nbTriInFace));
+    buf += ",\n";
+    for (std::size_t k=0; k < nbTriInFace; k++) {
+        buf += "    <";
+        appendNumber(buf, mesh.indices[3*k]);
+        buf += ',';
+        appendNumber(buf, mesh.indices[3*k+2]);
+        buf += ',';
+        appendNumber(buf, mesh.indices[3*k+1]);
+        buf += ">,\n";
+    }
+
+    // end of face
+    buf += "  }\n} // end of Face";
+    appendNumber(buf, static_cast<long>(l));
+    buf += "\n\n";
+}
+
+void PovTools::formatInstance(std::string& buf, const char *PartName, int l, int source, const gp_Trsf& trsf)
+{
+    // POV-Ray swaps the y and z axes and uses row vectors, so the matrix
+    // <a,b,c, d,e,f, g,h,i, j,k,l> maps x' = a*x + d*y + g*z + j
+    static const int axis[3] = {1, 3, 2};
+    appendHeader(buf, PartName, l);
+    buf += " = object{ ";
+    buf += PartName;
+    appendNumber(buf, static_cast<long>(source));
+    buf += " matrix <";
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 3; row++) {
+            if (col > 0 || row > 0)
+                buf += ',';
+            appendNumber(buf, trsf.Value(axis[row], col < 3 ? axis[col] : 4));
+        }
+    }
+    buf += "> }\n\n";
+}
+
 void PovTools::writeShape(const char *FileName, const char *PartName,
                           const TopoDS_Shape& Shape, float fMeshDeviation)
 {
@@ -225,79 +330,69 @@ void PovTools::writeShape(std::ostream &out, const char *PartName,
 {
     Base::Console().Log("Meshing with Deviation: %f\n",fMeshDeviation);
 
-    TopExp_Explorer ex;
+#if OCC_VERSION_HEX >= 0x060600
+    BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation,Standard_False,0.5,Standard_True);
+#else
     BRepMesh_IncrementalMesh MESH(Shape,fMeshDeviation);
+#endif
 
+    std::vector<TopoDS_Face> faces;
+    std::vector<int> instanceOf;
+    getFaces(Shape, faces, instanceOf);
 
-    // counting faces and start sequencer
-    int l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {}
-    Base::SequencerLauncher seq("Writing file", l);
+    // start sequencer
+    int count = static_cast<int>(faces.size());
+    Base::SequencerLauncher seq("Writing file", count+1);
 
     // write the file
     out <<  "// Written by FreeCAD http://www.freecadweb.org/" << endl;
-    l = 1;
-    for (ex.Init(Shape, TopAbs_FACE); ex.More(); ex.Next(),l++) {
-
-        // get the shape and mesh it
-        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
-
-        // this block mesh the face and transfers it in a C array of vertices and face indexes
-        Standard_Integer nbNodesInFace,nbTriInFace;
-        gp_Vec* vertices=0;
-        gp_Vec* vertexnormals=0;
-        long* cons=0;
-
-        transferToArray(aFace,&vertices,&vertexnormals,&cons,nbNodesInFace,nbTriInFace);
-
-        if (!vertices) break;
-        // writing per face header
-        out << "// face number" << l << " +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
-        << "#declare " << PartName << l << " = mesh2{" << endl
-        << "  vertex_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
-        // writing vertices
-        for (int i=0; i < nbNodesInFace; i++) {
-            out << "    <" << vertices[i].X() << ","
-            << vertices[i].Z() << ","
-            << vertices[i].Y() << ">,"
-            << endl;
-        }
-        out << "  }" << endl
-        // writing per vertex normals
-        << "  normal_vectors {" << endl
-        << "    " << nbNodesInFace << "," << endl;
-        for (int j=0; j < nbNodesInFace; j++) {
-            out << "    <" << vertexnormals[j].X() << ","
-            << vertexnormals[j].Z() << ","
-            << vertexnormals[j].Y() << ">,"
-            << endl;
-        }
 
-        out << "  }" << endl
-        // writing triangle indices
-        << "  face_indices {" << endl
-        << "    " << nbTriInFace << "," << endl;
-        for (int k=0; k < nbTriInFace; k++) {
-            out << "    <" << cons[3*k] << ","<< cons[3*k+2] << ","<< cons[3*k+1] << ">," << endl;
+    // the faces are triangulated and formatted in parallel, a batch at a time
+    // to bound the memory, and written in their original order
+    std::vector<std::string> blocks;
+    std::vector<char> empty;
+    int l = 1;
+    bool complete = true;
+    for (int first = 0; first < count && complete; first += FaceBatchSize) {
+        int last = std::min(first + FaceBatchSize, count);
+        blocks.assign(last - first, std::string());
+        empty.assign(last - first, 0);
+        Part::Parallel::forEach(last - first, [&](std::size_t k) {
+            int i = first + static_cast<int>(k);
+            std::string& block = blocks[k];
+            if (instanceOf[i] >= 0) {
+                gp_Trsf trsf = relativeTransformation(faces[instanceOf[i]], faces[i]);
+                formatInstance(block, PartName, i + 1, instanceOf[i] + 1, trsf);
+                return;
+            }
+
+            FaceMesh mesh;
+            if (!transferToMesh(faces[i], mesh)) {
+                empty[k] = 1;
+                return;
+            }
+            formatMesh(block, PartName, i + 1, mesh);
+        });
+
+        for (int i = first; i < last; i++, l++) {
+            if (empty[i - first]) {
+                Base::Console().Log("Empty face triangulation\n");
+                complete = false;
+                break;
+            }
+            out << blocks[i - first];
+            seq.next();
         }
-        // end of face
-        out << "  }" << endl
-        << "} // end of Face"<< l << endl << endl;
-
-        delete [] vertexnormals;
-        delete [] vertices;
-        delete [] cons;
-
-        seq.next();
-
     } // end of face loop
 
 
     out << endl << endl << "// Declare all together +++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << endl
     << "#declare " << PartName << " = union {" << endl;
     for (int i=1; i < l; i++) {
-        out << "mesh2{ " << PartName << i << "}" << endl;
+        if (instanceOf[i-1] >= 0)
+            out << "object{ " << PartName << i << "}" << endl;
+        else
+            out << "mesh2{ " << PartName << i << "}" << endl;
     }
     out << "}" << endl;
 }
@@ -363,20 +458,38 @@ void PovTools::writeShapeCSV(const char *FileName,
 
 void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace )
 {
-    TopLoc_Location aLoc;
-
-    // doing the meshing and checking the result
-    //BRepMesh_IncrementalMesh MESH(aFace,fDeflection);
-    Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
-    if (aPoly.IsNull()) {
+    FaceMesh mesh;
+    if (!transferToMesh(aFace, mesh)) {
         Base::Console().Log("Empty face triangulation\n");
         nbNodesInFace =0;
         nbTriInFace = 0;
-        vertices = 0l;
-        cons = 0l;
+        *vertices = 0l;
+        *vertexnormals = 0l;
+        *cons = 0l;
         return;
     }
 
+    // getting size and create the array
+    nbNodesInFace = static_cast<int>(mesh.vertices.size());
+    nbTriInFace = static_cast<int>(mesh.indices.size() / 3);
+    *vertices = new gp_Vec[nbNodesInFace];
+    *vertexnormals = new gp_Vec[nbNodesInFace];
+    std::copy(mesh.vertices.begin(), mesh.vertices.end(), *vertices);
+    std::copy(mesh.normals.begin(), mesh.normals.end(), *vertexnormals);
+
+    *cons = new long[3*(nbTriInFace)+1];
+    std::copy(mesh.indices.begin(), mesh.indices.end(), *cons);
+}
+
+bool PovTools::transferToMesh(const TopoDS_Face& aFace, FaceMesh& mesh)
+{
+    TopLoc_Location aLoc;
+
+    // checking the result of the meshing
+    Handle(Poly_Triangulation) aPoly = BRep_Tool::Triangulation(aFace,aLoc);
+    if (aPoly.IsNull())
+        return false;
+
     // getting the transformation of the shape/face
     gp_Trsf myTransf;
     Standard_Boolean identity = true;
@@ -387,15 +500,11 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
 
     Standard_Integer i;
     // getting size and create the array
-    nbNodesInFace = aPoly->NbNodes();
-    nbTriInFace = aPoly->NbTriangles();
-    *vertices = new gp_Vec[nbNodesInFace];
-    *vertexnormals = new gp_Vec[nbNodesInFace];
-    for (i=0; i < nbNodesInFace; i++) {
-        (*vertexnormals)[i]= gp_Vec(0.0,0.0,0.0);
-    }
-
-    *cons = new long[3*(nbTriInFace)+1];
+    Standard_Integer nbNodesInFace = aPoly->NbNodes();
+    Standard_Integer nbTriInFace = aPoly->NbTriangles();
+    mesh.vertices.assign(nbNodesInFace, gp_Vec(0.0,0.0,0.0));
+    mesh.normals.assign(nbNodesInFace, gp_Vec(0.0,0.0,0.0));
+    mesh.indices.resize(3*nbTriInFace);
 
     // check orientation
     TopAbs_Orientation orient = aFace.Orientation();
@@ -431,59 +540,93 @@ void PovTools::transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec
         gp_Vec v1(V1.X(),V1.Y(),V1.Z()),v2(V2.X(),V2.Y(),V2.Z()),v3(V3.X(),V3.Y(),V3.Z());
         gp_Vec Normal = (v2-v1)^(v3-v1);
 
-        //Standard_Real Area = 0.5 * Normal.Magnitude();
-
         // add the triangle normal to the vertex normal for all points of this triangle
-        (*vertexnormals)[N1-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-        (*vertexnormals)[N2-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-        (*vertexnormals)[N3-1] += gp_Vec(Normal.X(),Normal.Y(),Normal.Z());
-
-        (*vertices)[N1-1].SetX((float)(V1.X()));
-        (*vertices)[N1-1].SetY((float)(V1.Y()));
-        (*vertices)[N1-1].SetZ((float)(V1.Z()));
-        (*vertices)[N2-1].SetX((float)(V2.X()));
-        (*vertices)[N2-1].SetY((float)(V2.Y()));
-        (*vertices)[N2-1].SetZ((float)(V2.Z()));
-        (*vertices)[N3-1].SetX((float)(V3.X()));
-        (*vertices)[N3-1].SetY((float)(V3.Y()));
-        (*vertices)[N3-1].SetZ((float)(V3.Z()));
+        mesh.normals[N1-1] += Normal;
+        mesh.normals[N2-1] += Normal;
+        mesh.normals[N3-1] += Normal;
+
+        mesh.vertices[N1-1].SetCoord((float)(V1.X()), (float)(V1.Y()), (float)(V1.Z()));
+        mesh.vertices[N2-1].SetCoord((float)(V2.X()), (float)(V2.Y()), (float)(V2.Z()));
+        mesh.vertices[N3-1].SetCoord((float)(V3.X()), (float)(V3.Y()), (float)(V3.Z()));
 
         int j = i - 1;
-        N1--;
-        N2--;
-        N3--;
-        (*cons)[3*j] = N1;
-        (*cons)[3*j+1] = N2;
-        (*cons)[3*j+2] = N3;
+        mesh.indices[3*j] = N1-1;
+        mesh.indices[3*j+1] = N2-1;
+        mesh.indices[3*j+2] = N3-1;
+    }
+
+    // the surface and the projector are the same for all vertices of the face
+    Handle(Geom_Surface) Surface;
+    GeomAPI_ProjectPointOnSurf ProPntSrf;
+    try {
+        Surface = BRep_Tool::Surface(aFace);
+        if (!Surface.IsNull()) {
+            Standard_Real u1, u2, v1, v2;
+            Surface->Bounds(u1, u2, v1, v2);
+            ProPntSrf.Init(Surface, u1, u2, v1, v2);
+        }
+    }
+    catch (...) {
+        Surface.Nullify();
     }
 
     // normalize all vertex normals
     for (i=0; i < nbNodesInFace; i++) {
+        gp_Vec& normal = mesh.normals[i];
+        if (!Surface.IsNull()) {
+            try {
+                ProPntSrf.Perform(gp_Pnt(mesh.vertices[i].XYZ()));
+                Standard_Real fU, fV;
+                ProPntSrf.Parameters(1, fU, fV);
+
+                GeomLProp_SLProps clPropOfFace(Surface, fU, fV, 2, gp::Resolution());
+
+                gp_Vec temp = clPropOfFace.Normal();
+                if ( temp * normal < 0 )
+                    temp = -temp;
+                normal = temp;
+            }
+            catch (...) {
+            }
+        }
 
-        gp_Dir clNormal;
-
-        try {
-            Handle(Geom_Surface) Surface = BRep_Tool::Surface(aFace);
-
-            gp_Pnt vertex((*vertices)[i].XYZ());
-//     gp_Pnt vertex((*vertices)[i][0], (*vertices)[i][1], (*vertices)[i][2]);
-            GeomAPI_ProjectPointOnSurf ProPntSrf(vertex, Surface);
-            Standard_Real fU, fV;
-            ProPntSrf.Parameters(1, fU, fV);
+        normal.Normalize();
+    }
 
-            GeomLProp_SLProps clPropOfFace(Surface, fU, fV, 2, gp::Resolution());
+    return true;
+}
 
-            clNormal = clPropOfFace.Normal();
-            gp_Vec temp = clNormal;
-            //Base::Console().Log("unterschied:%.2f",temp.dot((*vertexnormals)[i]));
-            if ( temp * (*vertexnormals)[i] < 0 )
-                temp = -temp;
-            (*vertexnormals)[i] = temp;
+gp_Trsf PovTools::relativeTransformation(const TopoDS_Face& from, const TopoDS_Face& to)
+{
+    gp_Trsf trsf = from.Location().Transformation().Inverted();
+    trsf.PreMultiply(to.Location().Transformation());
+    return trsf;
+}
 
+void PovTools::getFaces(const TopoDS_Shape& Shape,
+                        std::vector<TopoDS_Face>& faces,
+                        std::vector<int>& instanceOf)
+{
+    // the triangulation is stored with the TShape, so faces sharing it only
+    // differ by their location
+    typedef std::pair<const TopoDS_TShape*, int> FaceKey;
+    std::map<FaceKey, int> firstFace;
+    for (TopExp_Explorer ex(Shape, TopAbs_FACE); ex.More(); ex.Next()) {
+        const TopoDS_Face& aFace = TopoDS::Face(ex.Current());
+        int index = static_cast<int>(faces.size());
+        FaceKey key(aFace.TShape().operator->(), static_cast<int>(aFace.Orientation()));
+        std::map<FaceKey, int>::iterator it = firstFace.find(key);
+        int source = -1;
+        if (it == firstFace.end()) {
+            firstFace[key] = index;
         }
-        catch (...) {
+        else {
+            // scaled or mirrored copies change the normals and the winding
+            gp_Trsf trsf = relativeTransformation(faces[it->second], aFace);
+            if (!trsf.IsNegative() && std::fabs(trsf.ScaleFactor() - 1.0) < Precision::Confusion())
+                source = it->second;
         }
-
-        (*vertexnormals)[i].Normalize();
+        faces.push_back(aFace);
+        instanceOf.push_back(source);
     }
 }
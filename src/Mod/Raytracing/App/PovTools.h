@@ -25,10 +25,12 @@
 #define _PovTools_h_
 
 #include <gp_Vec.hxx>
+#include <string>
 #include <vector>
 
 class TopoDS_Shape;
 class TopoDS_Face;
+class gp_Trsf;
 
 namespace Data { class ComplexGeoData; }
 
@@ -70,6 +72,15 @@ public:
     gp_Vec Up;
 };
 
+/// triangulation of a face with its vertex normals
+struct FaceMesh
+{
+    std::vector<gp_Vec> vertices;
+    std::vector<gp_Vec> normals;
+    /// three vertex indices per triangle, starting at 0
+    std::vector<long> indices;
+};
+
 
 class AppRaytracingExport PovTools
 {
@@ -113,6 +124,25 @@ public:
 
 
     static void transferToArray(const TopoDS_Face& aFace,gp_Vec** vertices,gp_Vec** vertexnormals, long** cons,int &nbNodesInFace,int &nbTriInFace );
+
+    /// gets the triangulation of a meshed face, returns false if there is none
+    static bool transferToMesh(const TopoDS_Face& aFace, FaceMesh& mesh);
+
+    /** Collects the faces of a shape. If a face has the same triangulation and
+     * orientation as an earlier one, only at another place, \a instanceOf holds
+     * the index of the earlier face, otherwise -1.
+     */
+    static void getFaces(const TopoDS_Shape& Shape,
+                         std::vector<TopoDS_Face>& faces,
+                         std::vector<int>& instanceOf);
+
+private:
+    /// transformation that moves the face \a from to the place of \a to
+    static gp_Trsf relativeTransformation(const TopoDS_Face& from, const TopoDS_Face& to);
+    /// appends the mesh2 declaration of the face number \a l
+    static void formatMesh(std::string& buf, const char *PartName, int l, const FaceMesh& mesh);
+    /// appends the declaration of the face number \a l as a moved copy of the face \a source
+    static void formatInstance(std::string& buf, const char *PartName, int l, int source, const gp_Trsf& trsf);
 };
 
 
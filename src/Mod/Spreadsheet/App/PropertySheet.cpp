@@ -105,6 +105,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    cellToDependentCellMap.clear();
+    cellToPrecedentCellMap.clear();
     docDeps.clear();
     aliasProp.clear();
     revAliasProp.clear();
@@ -209,6 +211,8 @@ PropertySheet::PropertySheet(Sheet *_owner)
     : Property()
     , AtomicPropertyChangeInterface()
     , owner(_owner)
+    , batchCounter(0)
+    , docDepsPending(false)
 {
 }
 
@@ -222,7 +226,11 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , cellToDependentCellMap(other.cellToDependentCellMap)
+    , cellToPrecedentCellMap(other.cellToPrecedentCellMap)
     , docDeps(other.docDeps)
+    , batchCounter(0)
+    , docDepsPending(false)
     , documentObjectName(other.documentObjectName)
     , documentName(other.documentName)
     , aliasProp(other.aliasProp)
@@ -237,6 +245,23 @@ PropertySheet::PropertySheet(const PropertySheet &other)
     }
 }
 
+PropertySheet::BatchChange::BatchChange(PropertySheet &prop)
+    : prop(prop)
+    , signaller(prop)
+{
+    ++prop.batchCounter;
+}
+
+PropertySheet::BatchChange::~BatchChange()
+{
+    // Rebuild the document dependencies before the signaller
+    // reports the change of the property
+    if (--prop.batchCounter == 0 && prop.docDepsPending) {
+        prop.docDepsPending = false;
+        prop.rebuildDocDepList();
+    }
+}
+
 PropertySheet::~PropertySheet()
 {
     clear();
@@ -326,7 +351,7 @@ void PropertySheet::Restore(Base::XMLReader &reader)
 {
     int Cnt;
 
-    AtomicPropertyChange signaller(*this);
+    BatchChange batch(*this);
 
     reader.readElement("Cells");
     Cnt = reader.getAttributeAsInteger("Count");
@@ -932,6 +957,22 @@ bool PropertySheet::isHidden(CellAddress address) const
     return i != mergedCells.end() && i->second != address;
 }
 
+/**
+  * Convert a property name of the sheet to the address of the cell it names.
+  *
+  * @returns The address, or an invalid address if \a name is not a cell.
+  */
+
+static CellAddress propertyToAddress(const std::string &name)
+{
+    try {
+        return stringToAddress(name.c_str());
+    }
+    catch (const Base::Exception &) {
+        return CellAddress();
+    }
+}
+
 /**
   * Update dependencies of \a expression for cell at \a key.
   *
@@ -988,6 +1029,7 @@ void PropertySheet::addDependencies(CellAddress key)
         // Also an alias?
         if (docObj == owner) {
             std::map<std::string, CellAddress>::const_iterator j = revAliasProp.find(i->getPropertyName());
+            CellAddress dep;
 
             if (j != revAliasProp.end()) {
                 propName = docObjName + "." + j->second.toString();
@@ -995,6 +1037,16 @@ void PropertySheet::addDependencies(CellAddress key)
                 // Insert into maps
                 propertyNameToCellMap[propName].insert(key);
                 cellToPropertyNameMap[key].insert(propName);
+
+                dep = j->second;
+            }
+            else
+                dep = propertyToAddress(i->getPropertyName());
+
+            // Keep track of references between cells of this sheet
+            if (dep.isValid()) {
+                cellToDependentCellMap[dep].insert(key);
+                cellToPrecedentCellMap[key].insert(dep);
             }
         }
 
@@ -1057,6 +1109,29 @@ void PropertySheet::removeDependencies(CellAddress key)
 
         cellToDocumentObjectMap.erase(i2);
     }
+
+    /* Remove from Cell <-> Cell maps */
+
+    std::map<CellAddress, std::set< CellAddress > >::iterator i3 = cellToPrecedentCellMap.find(key);
+
+    if (i3 != cellToPrecedentCellMap.end()) {
+        std::set< CellAddress >::const_iterator j = i3->second.begin();
+
+        while (j != i3->second.end()) {
+            std::map<CellAddress, std::set< CellAddress > >::iterator k = cellToDependentCellMap.find(*j);
+
+            if (k != cellToDependentCellMap.end()) {
+                k->second.erase(key);
+
+                if (k->second.size() == 0)
+                    cellToDependentCellMap.erase(k);
+            }
+
+            ++j;
+        }
+
+        cellToPrecedentCellMap.erase(i3);
+    }
 }
 
 /**
@@ -1254,6 +1329,24 @@ const std::set<std::string> &PropertySheet::getDeps(CellAddress pos) const
         return empty;
 }
 
+/**
+  * Get the cells of this sheet that read the cell at \a pos.
+  *
+  * @param pos Address of cell
+  *
+  */
+
+const std::set<CellAddress> &PropertySheet::getCellDependents(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    std::map<CellAddress, std::set< CellAddress > >::const_iterator i = cellToDependentCellMap.find(pos);
+
+    if (i != cellToDependentCellMap.end())
+        return i->second;
+    else
+        return empty;
+}
+
 void PropertySheet::recomputeDependencies(CellAddress key)
 {
     AtomicPropertyChange signaller(*this);
@@ -1265,6 +1358,12 @@ void PropertySheet::recomputeDependencies(CellAddress key)
 
 void PropertySheet::rebuildDocDepList()
 {
+    // Deferred to the end of the current batch
+    if (batchCounter > 0) {
+        docDepsPending = true;
+        return;
+    }
+
     AtomicPropertyChange signaller(*this);
 
     docDeps.clear();
@@ -45,6 +45,20 @@ public:
 
     ~PropertySheet();
 
+    /*! Groups a number of cell changes into a single change of the property.
+      While a batch is active, the change signals are held back and the list
+      of documents objects the sheet depends on is rebuilt only once, when
+      the outermost batch ends.
+      */
+    class BatchChange {
+    public:
+        BatchChange(PropertySheet & prop);
+        ~BatchChange();
+    private:
+        PropertySheet & prop;
+        AtomicPropertyChange signaller;
+    };
+
     virtual Property *Copy(void) const;
 
     virtual void Paste(const Property &from);
@@ -127,6 +141,8 @@ public:
 
     const std::set<std::string> &getDeps(App::CellAddress pos) const;
 
+    const std::set<App::CellAddress> &getCellDependents(App::CellAddress pos) const;
+
     const std::set<App::DocumentObject*> & getDocDeps() const { return docDeps; }
 
     void recomputeDependencies(App::CellAddress key);
@@ -213,9 +229,23 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set< std::string > > cellToDocumentObjectMap;
 
+    /*! Cells of this sheet that read the cell given in key, either by
+      address or by alias. Used to order the evaluation in Sheet::execute().
+      */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellToDependentCellMap;
+
+    /*! Cells of this sheet the cell given in key reads */
+    std::map<App::CellAddress, std::set< App::CellAddress > > cellToPrecedentCellMap;
+
     /*! Other document objects the sheet depends on */
     std::set<App::DocumentObject*> docDeps;
 
+    /*! Nesting level of active BatchChange objects */
+    int batchCounter;
+
+    /*! docDeps needs to be rebuilt when the last batch ends */
+    bool docDepsPending;
+
     /*! Name of document objects, used for renaming */
     std::map<const App::DocumentObject*, std::string> documentObjectName;
 
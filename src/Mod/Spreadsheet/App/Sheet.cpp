@@ -29,7 +29,7 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/assign.hpp>
-#include <boost/graph/topological_sort.hpp>
+#include <boost/graph/adjacency_list.hpp>
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DynamicProperty.h>
@@ -52,6 +52,7 @@
 #include <boost/regex.hpp>
 #include <boost/bind.hpp>
 #include <deque>
+#include <algorithm>
 
 using namespace Base;
 using namespace App;
@@ -147,25 +148,26 @@ bool Sheet::importFromFile(const std::string &filename, char delimiter, char quo
     Base::ifstream file(fi, std::ios::in);
     int row = 0;
 
-    PropertySheet::AtomicPropertyChange signaller(cells);
+    PropertySheet::BatchChange batch(cells);
 
     clearAll();
 
     if (file.is_open()) {
         std::string line;
 
-        while (std::getline(file, line)) {
-            using namespace boost;
+        using namespace boost;
+
+        escaped_list_separator<char> e;
 
+        if (quoteChar)
+            e = escaped_list_separator<char>(escapeChar, delimiter, quoteChar);
+        else
+            e = escaped_list_separator<char>('\0', delimiter, '\0');
+
+        while (std::getline(file, line)) {
             try {
-                escaped_list_separator<char> e;
                 int col = 0;
 
-                if (quoteChar)
-                    e = escaped_list_separator<char>(escapeChar, delimiter, quoteChar);
-                else
-                    e = escaped_list_separator<char>('\0', delimiter, '\0');
-
                 tokenizer<escaped_list_separator<char> > tok(line, e);
 
                 for(tokenizer<escaped_list_separator<char> >::iterator i = tok.begin(); i != tok.end();++i) {
@@ -377,6 +379,39 @@ void Sheet::setCell(CellAddress address, const char * value)
     touch();
 }
 
+/**
+  * Set the contents of a block of cells, starting at \a start. Each entry of
+  * \a contents is a row, and its strings are set on consecutive columns. The
+  * changes are done as a single change of the cells property, so dependencies
+  * and change notifications are only updated once for the whole block.
+  *
+  * @param start      Upper left corner of the block.
+  * @param contents   Rows of cell contents; empty strings clear the cell.
+  *
+  */
+
+void Sheet::setCells(CellAddress start, const std::vector<std::vector<std::string> > &contents)
+{
+    std::size_t cols = 0;
+
+    for (std::vector<std::vector<std::string> >::const_iterator i = contents.begin(); i != contents.end(); ++i)
+        cols = std::max(cols, i->size());
+
+    if (!start.isValid() ||
+            start.row() + contents.size() > static_cast<std::size_t>(CellAddress::MAX_ROWS) ||
+            start.col() + cols > static_cast<std::size_t>(CellAddress::MAX_COLUMNS))
+        throw Base::ValueError("Cell block exceeds the spreadsheet");
+
+    PropertySheet::BatchChange batch(cells);
+
+    for (std::size_t r = 0; r < contents.size(); ++r) {
+        const std::vector<std::string> & row = contents[r];
+
+        for (std::size_t c = 0; c < row.size(); ++c)
+            setCell(CellAddress(start.row() + r, start.col() + c), row[c].c_str());
+    }
+}
+
 /**
   * Get the Python object for the Sheet.
   *
@@ -620,7 +655,7 @@ void Sheet::updateProperty(CellAddress key)
         const Expression * input = cell->getExpression();
 
         if (input) {
-            output = input->eval();
+            output = input->evalCompiled();
         }
         else {
             std::string s;
@@ -742,78 +777,81 @@ DocumentObjectExecReturn *Sheet::execute(void)
          dirtyCells.insert(*i);
     }
 
-    // Push dirty cells onto queue
-    for (std::set<CellAddress>::const_iterator i = dirtyCells.begin(); i != dirtyCells.end(); ++i) {
-        // Create queue and a graph structure to compute order of evaluation
-        std::deque<CellAddress> workQueue;
-        DependencyList graph;
-        std::map<CellAddress, Vertex> VertexList;
-        std::map<Vertex, CellAddress> VertexIndexList;
+    // Collect the dirty cells and every cell depending on them into one
+    // graph, so that each cell is evaluated at most once
+    DependencyList graph;
+    std::map<CellAddress, Vertex> VertexList;
+    std::vector<CellAddress> VertexIndexList;
+    std::deque<CellAddress> workQueue;
 
+    for (std::set<CellAddress>::const_iterator i = dirtyCells.begin(); i != dirtyCells.end(); ++i) {
+        VertexList[*i] = add_vertex(graph);
+        VertexIndexList.push_back(*i);
         workQueue.push_back(*i);
+    }
 
-        while (workQueue.size() > 0) {
-            CellAddress currPos = workQueue.front();
-            std::set<CellAddress> s;
+    while (workQueue.size() > 0) {
+        CellAddress currPos = workQueue.front();
+        workQueue.pop_front();
 
-            // Get other cells that depends on the current cell (currPos)
-            providesTo(currPos, s);
-            workQueue.pop_front();
+        // Get other cells that depends on the current cell (currPos)
+        const std::set<CellAddress> & s = cells.getCellDependents(currPos);
 
+        // Process cells that depend on the current cell
+        std::set<CellAddress>::const_iterator i = s.begin();
+        while (i != s.end()) {
             // Insert into map of CellPos -> Index, if it doesn't exist already
-            if (VertexList.find(currPos) == VertexList.end()) {
-                VertexList[currPos] = add_vertex(graph);
-                VertexIndexList[VertexList[currPos]] = currPos;
-            }
-
-            // Process cells that depend on the current cell
-            std::set<CellAddress>::const_iterator i = s.begin();
-            while (i != s.end()) {
-                // Insert into map of CellPos -> Index, if it doesn't exist already
-                if (VertexList.find(*i) == VertexList.end()) {
-                    VertexList[*i] = add_vertex(graph);
-                    VertexIndexList[VertexList[*i]] = *i;
-                    workQueue.push_back(*i);
-                }
-                // Add edge to graph to signal dependency
-                add_edge(VertexList[currPos], VertexList[*i], graph);
-                ++i;
+            std::map<CellAddress, Vertex>::const_iterator j = VertexList.find(*i);
+            if (j == VertexList.end()) {
+                j = VertexList.insert(std::make_pair(*i, add_vertex(graph))).first;
+                VertexIndexList.push_back(*i);
+                workQueue.push_back(*i);
             }
+            // Add edge to graph to signal dependency
+            add_edge(VertexList[currPos], j->second, graph);
+            ++i;
         }
+    }
 
-        // Compute cells
-        std::list<Vertex> make_order;
+    // Evaluate in topological order; a cell is ready once all its inputs are
+    std::vector<int> pendingInputs(num_vertices(graph), 0);
+    Traits::edge_iterator ei, ei_end;
+    for (boost::tie(ei, ei_end) = edges(graph); ei != ei_end; ++ei)
+        ++pendingInputs[target(*ei, graph)];
 
-        // Sort graph topologically to find evaluation order
-        try {
-            boost::topological_sort(graph, std::front_inserter(make_order));
+    std::deque<Vertex> readyQueue;
+    for (Vertex v = 0; v < num_vertices(graph); ++v) {
+        if (pendingInputs[v] == 0)
+            readyQueue.push_back(v);
+    }
 
-            // Recompute cells
-            std::list<Vertex>::const_iterator i = make_order.begin();
-            while (i != make_order.end()) {
-                recomputeCell(VertexIndexList[*i]);
-                ++i;
-            }
-        }
-        catch (std::exception&) {
-            // Cycle detected; flag all with errors
+    while (readyQueue.size() > 0) {
+        Vertex v = readyQueue.front();
+        readyQueue.pop_front();
 
-            std::map<CellAddress, Vertex>::const_iterator i = VertexList.begin();
-            while (i != VertexList.end()) {
-                Cell * cell = cells.getValue(i->first);
+        recomputeCell(VertexIndexList[v]);
 
-                // Mark as erroneous
-                cellErrors.insert(i->first);
+        Traits::out_edge_iterator oi, oi_end;
+        for (boost::tie(oi, oi_end) = out_edges(v, graph); oi != oi_end; ++oi) {
+            if (--pendingInputs[target(*oi, graph)] == 0)
+                readyQueue.push_back(target(*oi, graph));
+        }
+    }
 
-                if (cell)
-                    cell->setException("Circular dependency.");
-                updateProperty(i->first);
-                updateAlias(i->first);
+    // Cells still waiting for input are part of a cycle, or depend on one; flag them with errors
+    for (Vertex v = 0; v < num_vertices(graph); ++v) {
+        if (pendingInputs[v] == 0)
+            continue;
 
-                ++i;
-            }
-        }
+        Cell * cell = cells.getValue(VertexIndexList[v]);
+
+        // Mark as erroneous
+        cellErrors.insert(VertexIndexList[v]);
 
+        if (cell)
+            cell->setException("Circular dependency.");
+        updateProperty(VertexIndexList[v]);
+        updateAlias(VertexIndexList[v]);
     }
 
     // Signal update of column widths
@@ -1260,10 +1298,7 @@ void Sheet::providesTo(CellAddress address, std::set<std::string> & result) cons
 
 void Sheet::providesTo(CellAddress address, std::set<CellAddress> & result) const
 {
-    const char * docName = getDocument()->Label.getValue();
-    const char * docObjName = getNameInDocument();
-    std::string fullName = std::string(docName) + "#" + std::string(docObjName) + "." + address.toString();
-    result = cells.getDeps(fullName);
+    result = cells.getCellDependents(address);
 }
 
 void Sheet::onDocumentRestored()
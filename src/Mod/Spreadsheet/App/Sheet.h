@@ -40,6 +40,7 @@
 #include <App/FeaturePython.h>
 #include <Base/Unit.h>
 #include <map>
+#include <vector>
 #include "PropertySheet.h"
 #include "PropertyColumnWidths.h"
 #include "PropertyRowHeights.h"
@@ -100,6 +101,8 @@ public:
 
     void setCell(App::CellAddress address, const char *value);
 
+    void setCells(App::CellAddress start, const std::vector<std::vector<std::string> > &contents);
+
     void clearAll();
 
     void clear(App::CellAddress address, bool all = true);
@@ -74,11 +74,11 @@ PyObject* SheetPy::set(PyObject *args)
         if (cellAddress.size() > 0)
             sheet->setCell(cellAddress.c_str(), contents);
         else {
-            Range rangeIter(address);
+            Range range(address);
+            std::vector<std::string> row(range.to().col() - range.from().col() + 1, contents);
+            std::vector<std::vector<std::string> > block(range.to().row() - range.from().row() + 1, row);
 
-            do {
-                sheet->setCell(rangeIter.address().c_str(), contents);
-            } while (rangeIter.next());
+            sheet->setCells(range.from(), block);
         }
     }
     catch (const Base::Exception & e) {
@@ -89,6 +89,66 @@ PyObject* SheetPy::set(PyObject *args)
     Py_Return;
 }
 
+PyObject* SheetPy::setCells(PyObject *args)
+{
+    char *address;
+    PyObject *rows;
+
+    if (!PyArg_ParseTuple(args, "sO:setCells", &address, &rows))
+        return 0;
+
+    std::vector<std::vector<std::string> > block;
+
+    try {
+        Py::Sequence rowSeq(rows);
+
+        block.resize(rowSeq.size());
+        for (Py::Sequence::size_type r = 0; r < rowSeq.size(); ++r) {
+            Py::Sequence colSeq(rowSeq[r]);
+            std::vector<std::string> & row = block[r];
+
+            row.resize(colSeq.size());
+            for (Py::Sequence::size_type c = 0; c < colSeq.size(); ++c) {
+                Py::Object item(colSeq[c]);
+
+                // None clears the cell, like an empty string
+                if (item.isNone())
+                    continue;
+#if PY_MAJOR_VERSION >= 3
+                else if (PyUnicode_Check(item.ptr()))
+                    row[c] = PyUnicode_AsUTF8(item.ptr());
+#else
+                else if (PyString_Check(item.ptr()))
+                    row[c] = PyString_AsString(item.ptr());
+#endif
+                else
+                    row[c] = item.as_string();
+            }
+        }
+    }
+    catch (const Py::Exception &) {
+        PyErr_SetString(PyExc_TypeError, "Expected a sequence of sequences of cell contents");
+        return 0;
+    }
+
+    try {
+        Sheet * sheet = getSheetPtr();
+        std::string cellAddress = sheet->getAddressFromAlias(address);
+
+        /* Check to see if address is really an alias first */
+        if (cellAddress.size() > 0)
+            sheet->setCells(CellAddress(cellAddress.c_str()), block);
+        else
+            sheet->setCells(CellAddress(address), block);
+    }
+    catch (const Base::Exception & e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        return 0;
+    }
+
+    Py_Return;
+}
+
 PyObject* SheetPy::get(PyObject *args)
 {
     char *address;
@@ -10,6 +10,7 @@ import FreeCAD
 import Part
 import Sketcher
 import tempfile
+import time
 from FreeCAD import Base
 from FreeCAD import Units
 
@@ -861,6 +862,81 @@ class SpreadsheetCases(unittest.TestCase):
         self.assertEqual(sheet.get('C1'), Units.Quantity('3 mm'))
 
 
+    def testDependencyOrder(self):
+        """ Cells reading each other in several paths are evaluated in order """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('A1', '1')
+        sheet.setAlias('A1', 'base')
+        sheet.set('D1', '=C1 + base')
+        sheet.set('C1', '=B1 * 2')
+        sheet.set('B1', '=A1 + 1')
+        sheet.set('E1', '=D1 + B1')
+        self.doc.recompute()
+        self.assertEqual(sheet.get('D1'), 5)
+        self.assertEqual(sheet.get('E1'), 7)
+        sheet.set('A1', '5')
+        self.doc.recompute()
+        self.assertEqual(sheet.get('D1'), 17)
+        self.assertEqual(sheet.get('E1'), 23)
+
+    def testCellTypeChange(self):
+        """ A cell changing its property type is looked up again """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('A1', '5')
+        sheet.set('B1', '=A1 * 2')
+        self.doc.recompute()
+        self.assertEqual(sheet.B1, 10)
+        sheet.set('A1', '5mm')
+        self.doc.recompute()
+        self.assertEqual(sheet.B1, Units.Quantity('10 mm'))
+        sheet.set('A1', 'text')
+        self.doc.recompute()
+        self.assertEqual(sheet.B1, u'ERR: Invalid expression')
+
+    def testLargeSheet(self):
+        """ Recompute a long chain of formulas """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('A1', '1')
+        for i in range(2, 1001):
+            sheet.set('A%d' % i, '=A%d + cos(60) * 2' % (i - 1))
+            sheet.set('B%d' % i, '=A%d > 500.5 ? 1 : 0' % i)
+        sheet.set('C1', '=sum(B2:B1000)')
+
+        start = time.time()
+        self.doc.recompute()
+        FreeCAD.Console.PrintLog('recomputed 1999 cells in %.3fs\n' % (time.time() - start))
+        self.assertAlmostEqual(sheet.A1000, 1000, 6)
+        self.assertEqual(sheet.C1, 500)
+
+        sheet.set('A1', '2')
+        start = time.time()
+        self.doc.recompute()
+        FreeCAD.Console.PrintLog('recomputed 1999 cells in %.3fs\n' % (time.time() - start))
+        self.assertAlmostEqual(sheet.A1000, 1001, 6)
+        self.assertEqual(sheet.C1, 501)
+
+    def testSetCells(self):
+        """ Set a block of cells in one call """
+        sheet = self.doc.addObject('Spreadsheet::Sheet','Spreadsheet')
+        sheet.set('D1', 'x')
+        rows = [[str(r * 10 + c) for c in range(3)] for r in range(100)]
+        rows[0] = ['=sum(A2:A100)', None, 'text']
+        sheet.setCells('A1', rows)
+        sheet.setCells('D1', [[None], [5, 2.5]])
+        sheet.set('F1:G2', '=A2 * 2')
+        self.doc.recompute()
+        self.assertEqual(sheet.A1, sum(r * 10 for r in range(1, 100)))
+        self.assertEqual(sheet.getContents('B1'), '')
+        self.assertEqual(sheet.C1, 'text')
+        self.assertEqual(sheet.C100, 992)
+        self.assertEqual(sheet.getContents('D1'), '')
+        self.assertEqual(sheet.D2, 5)
+        self.assertEqual(sheet.E2, 2.5)
+        self.assertEqual(sheet.F1, 20)
+        self.assertEqual(sheet.G2, 20)
+        self.assertRaises(TypeError, sheet.setCells, 'A1', 5)
+        self.assertRaises(ValueError, sheet.setCells, 'ZZ1', [['1', '2']])
+
     def tearDown(self):
         #closing doc
         FreeCAD.closeDocument(self.doc.Name)
@@ -343,7 +343,11 @@ private:
             if (PyObject_TypeCheck(viewObj, &(TechDraw::DrawViewPartPy::Type))) {
                 obj = static_cast<App::DocumentObjectPy*>(viewObj)->getDocumentObjectPtr();
                 dvp = static_cast<TechDraw::DrawViewPart*>(obj);
+                dvp->waitForHlr();                                //the projection may still be running
                 TechDraw::GeometryObject* go = dvp->getGeometryObject();
+                if (go == nullptr) {
+                    throw Base::RuntimeError(std::string("View has no geometry: ") + dvp->getNameInDocument());
+                }
                 TopoDS_Shape s = TechDraw::mirrorShape(go->getVisHard());
                 ss << dxfOut.exportEdges(s);
                 s = TechDraw::mirrorShape(go->getVisOutline());
@@ -400,7 +404,11 @@ private:
             if (PyObject_TypeCheck(viewObj, &(TechDraw::DrawViewPartPy::Type))) {
                 obj = static_cast<App::DocumentObjectPy*>(viewObj)->getDocumentObjectPtr();
                 dvp = static_cast<TechDraw::DrawViewPart*>(obj);
+                dvp->waitForHlr();                                //the projection may still be running
                 TechDraw::GeometryObject* go = dvp->getGeometryObject();
+                if (go == nullptr) {
+                    throw Base::RuntimeError(std::string("View has no geometry: ") + dvp->getNameInDocument());
+                }
                 //visible group begin "<g ... >"
                 ss << grpHead1;
 //                double thick = dvp->LineWidth.getValue();
@@ -461,7 +469,11 @@ private:
 
     void write1ViewDxf( ImpExpDxfWrite& writer, TechDraw::DrawViewPart* dvp, bool alignPage)
     {
+        dvp->waitForHlr();                                        //the projection may still be running
         TechDraw::GeometryObject* go = dvp->getGeometryObject();
+        if (go == nullptr) {
+            throw Base::RuntimeError(std::string("View has no geometry: ") + dvp->getNameInDocument());
+        }
         TopoDS_Shape s = TechDraw::mirrorShape(go->getVisHard());
         double offX = 0.0;
         double offY = 0.0;
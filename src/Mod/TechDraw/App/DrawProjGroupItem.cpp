@@ -147,6 +147,27 @@ void DrawProjGroupItem::autoPosition()
     }
 }
 
+//! the group can only be distributed properly once all its items have geometry
+void DrawProjGroupItem::postHlrTasks(void)
+{
+    DrawViewPart::postHlrTasks();
+    auto pgroup = getPGroup();
+    if (pgroup == nullptr) {
+        autoPosition();
+        return;
+    }
+    std::vector<DrawProjGroupItem*> items = pgroup->getViewsAsDPGI();
+    for (auto& item: items) {
+        if (item->waitingForHlr()) {
+            return;
+        }
+    }
+    for (auto& item: items) {
+        item->autoPosition();
+    }
+    pgroup->requestPaint();
+}
+
 void DrawProjGroupItem::onDocumentRestored()
 {
     App::DocumentObjectExecReturn* rc = DrawProjGroupItem::execute();
@@ -78,6 +78,7 @@ public:
 
     virtual double getScale(void) const override;
     void autoPosition(void);
+    virtual void postHlrTasks(void) override;
     bool isAnchor(void) const;
 
 
@@ -67,6 +67,9 @@
 #include <cmath>
 #include <GeomLib_Tool.hxx>
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
 #include <App/Application.h>
 #include <Base/BoundBox.h>
 #include <Base/Console.h>
@@ -74,6 +77,7 @@
 #include <Base/FileInfo.h>
 #include <Base/Parameter.h>
 #include <Mod/Part/App/PartFeature.h>
+#include <Mod/Part/App/Parallel.h>
 
 #include "DrawUtil.h"
 #include "Geometry.h"
@@ -88,6 +92,17 @@
 using namespace TechDraw;
 using namespace std;
 
+static void printSplitMessages(const std::vector<splitMessage>& messages)
+{
+    for (auto& m: messages) {
+        if (m.error) {
+            Base::Console().Error("%s", m.text.c_str());
+        } else {
+            Base::Console().Message("%s", m.text.c_str());
+        }
+    }
+}
+
 
 //===========================================================================
 // DrawProjectSplit
@@ -165,84 +180,132 @@ std::vector<TopoDS_Edge> DrawProjectSplit::getEdges(TechDraw::GeometryObject* ge
         }
     }
     faceEdges = nonZero;
-    origEdges = nonZero;
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DPS::Extract Faces - outer Bnd_Box is void\n");
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DPS::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
+    std::vector<splitPoint> splits = getSplitPoints(faceEdges);
+
+    std::vector<splitPoint> sorted = sortSplits(splits,true);
+    auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
+    sorted.erase(last, sorted.end());                         //remove dupls
+    std::vector<TopoDS_Edge> newEdges = splitEdges(faceEdges,sorted);
+
+    if (newEdges.empty()) {
+        Base::Console().Log("LOG - DPS::extractFaces - no newEdges\n");
+    }
+    newEdges = removeDuplicateEdges(newEdges);
+    return newEdges;
+}
+
+
+//! find the vertices of each edge that lie on another edge, away from its ends.
+//! the edges are indexed by bounding box, so a vertex is only checked against
+//! the edges whose box contains it, and the checks run in parallel.
+std::vector<splitPoint> DrawProjectSplit::getSplitPoints(const std::vector<TopoDS_Edge>& edges)
+{
+    namespace bg = boost::geometry;
+    namespace bgi = boost::geometry::index;
+    typedef bg::model::point<double,3,bg::cs::cartesian> RPoint;
+    typedef bg::model::box<RPoint> RBox;
+    typedef std::pair<RBox,int> RValue;
+
+    std::vector<RValue> boxes;
+    boxes.reserve(edges.size());
+    for (int i = 0; i < (int)edges.size(); i++) {
+        if (DrawUtil::isZeroEdge(edges[i])) {
             continue;  //skip zero length edges. shouldn't happen ;)
         }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DPS::Extract Faces - inner Bnd_Box is void\n");
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
+        Bnd_Box box;
+        BRepBndLib::Add(edges[i], box);
+        box.SetGap(0.1);
+        if (box.IsVoid()) {
+            Base::Console().Message("DPS::getSplitPoints - Bnd_Box is void for edge: %d\n",i);
+            continue;
+        }
+        double xMin,yMin,zMin,xMax,yMax,zMax;
+        box.Get(xMin,yMin,zMin,xMax,yMax,zMax);
+        boxes.push_back(RValue(RBox(RPoint(xMin,yMin,zMin),RPoint(xMax,yMax,zMax)),i));
+    }
+    //packing constructor, builds a balanced tree in one go
+    const bgi::rtree<RValue,bgi::quadratic<16> > tree(boxes.begin(),boxes.end());
+
+    //splits found for each edge, in the same order as checking all edge pairs would give
+    std::vector<std::vector<splitPoint> > found(edges.size());
+    //Base::Console() is not thread safe, the workers keep their messages here
+    std::vector<std::vector<splitMessage> > messages(edges.size());
+    auto findSplits = [&](int iOuter) {
+        const TopoDS_Edge& outer = edges[iOuter];
+        TopoDS_Vertex v1 = TopExp::FirstVertex(outer);
+        TopoDS_Vertex v2 = TopExp::LastVertex(outer);
+        gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
+        gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
+
+        std::vector<int> inners;
+        std::vector<RValue> hits;
+        tree.query(bgi::intersects(RPoint(pnt1.X(),pnt1.Y(),pnt1.Z())),std::back_inserter(hits));
+        tree.query(bgi::intersects(RPoint(pnt2.X(),pnt2.Y(),pnt2.Z())),std::back_inserter(hits));
+        for (auto& h: hits) {
+            if (h.second != iOuter) {
+                inners.push_back(h.second);
             }
+        }
+        std::sort(inners.begin(),inners.end());
+        inners.erase(std::unique(inners.begin(),inners.end()),inners.end());
 
+        for (int iInner: inners) {
             double param = -1;
-            if (isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
+            if (isOnEdge(edges[iInner],v1,param,false,messages[iOuter])) {
                 splitPoint s1;
                 s1.i = iInner;
                 s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
                 s1.param = param;
-                splits.push_back(s1);
+                found[iOuter].push_back(s1);
             }
-            if (isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
+            if (isOnEdge(edges[iInner],v2,param,false,messages[iOuter])) {
                 splitPoint s2;
                 s2.i = iInner;
                 s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
                 s2.param = param;
-                splits.push_back(s2);
+                found[iOuter].push_back(s2);
             }
-        } //inner loop
-    }   //outer loop
+        }
+    };
 
-    std::vector<splitPoint> sorted = sortSplits(splits,true);
-    auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
-    sorted.erase(last, sorted.end());                         //remove dupls
-    std::vector<TopoDS_Edge> newEdges = splitEdges(faceEdges,sorted);
+    if (boxes.size() < 100) {
+        for (auto& b: boxes) {
+            findSplits(b.second);
+        }
+    } else {
+        Part::Parallel::forEach(boxes.size(), [&](size_t i) {
+            findSplits(boxes[i].second);
+        });
+    }
 
-    if (newEdges.empty()) {
-        Base::Console().Log("LOG - DPS::extractFaces - no newEdges\n");
+    for (auto& edgeMessages: messages) {
+        printSplitMessages(edgeMessages);
     }
-    newEdges = removeDuplicateEdges(newEdges);
-    return newEdges;
-}
 
+    std::vector<splitPoint> result;
+    for (auto& f: found) {
+        result.insert(result.end(),f.begin(),f.end());
+    }
+    return result;
+}
 
 //this routine is the big time consumer.  gets called many times (and is slow?))
 //note param gets modified here
 bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds)
+{
+    std::vector<splitMessage> messages;
+    bool result = isOnEdge(e, v, param, allowEnds, messages);
+    printSplitMessages(messages);
+    return result;
+}
+
+//! same as above, but doesn't print anything, so that it can run in worker threads.
+//! the messages are appended to messages instead.
+bool DrawProjectSplit::isOnEdge(const TopoDS_Edge& e, const TopoDS_Vertex& v, double& param, bool allowEnds,
+                                std::vector<splitMessage>& messages)
 {
     bool result = false;
     bool outOfBox = false;
@@ -253,7 +316,7 @@ bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, b
     BRepBndLib::Add(e, sBox);
     sBox.SetGap(0.1);
     if (sBox.IsVoid()) {
-        Base::Console().Message("DPS::isOnEdge - Bnd_Box is void\n");
+        messages.push_back(splitMessage{false, "DPS::isOnEdge - Bnd_Box is void\n"});
     } else {
         gp_Pnt pt = BRep_Tool::Pnt(v);
         if (sBox.IsOut(pt)) {
@@ -261,9 +324,16 @@ bool DrawProjectSplit::isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, b
         }
     }
     if (!outOfBox) {
-            double dist = DrawUtil::simpleMinDist(v,e);
+            //DrawUtil::simpleMinDist, without its message
+            double dist = -1;
+            BRepExtrema_DistShapeShape extss(v, e);
+            if (!extss.IsDone()) {
+                messages.push_back(splitMessage{false, "DU::simpleMinDist - BRepExtrema_DistShapeShape failed"});
+            } else if (extss.NbSolution() != 0) {
+                dist = extss.Value();
+            }
             if (dist < 0.0) {
-                Base::Console().Error("DPS::isOnEdge - simpleMinDist failed: %.3f\n",dist);
+                messages.push_back(splitMessage{true, "DPS::isOnEdge - simpleMinDist failed: -1.000\n"});
                 result = false;
             } else if (dist < Precision::Confusion()) {
                 const gp_Pnt pt = BRep_Tool::Pnt(v);                         //have to duplicate method 3 to get param
@@ -412,10 +482,11 @@ std::vector<splitPoint> DrawProjectSplit::sortSplits(std::vector<splitPoint>& s,
     return result;
 }
 
-std::vector<TopoDS_Edge> DrawProjectSplit::removeDuplicateEdges(std::vector<TopoDS_Edge>& inEdges)
+std::vector<TopoDS_Edge> DrawProjectSplit::removeDuplicateEdges(const std::vector<TopoDS_Edge>& inEdges)
 {
     std::vector<TopoDS_Edge> result;
     std::vector<edgeSortItem> temp;
+    temp.reserve(inEdges.size());
 
     unsigned int idx = 0;
     for (auto& e: inEdges) {
@@ -440,12 +511,32 @@ std::vector<TopoDS_Edge> DrawProjectSplit::removeDuplicateEdges(std::vector<Topo
         idx++;
     }
 
+    //keep the first of each group of duplicates in sorted order, like std::unique does.
+    //candidates are found by hashing the start points of the kept edges, so duplicates
+    //are caught even if they don't end up next to each other after sorting.
     std::vector<edgeSortItem> sorted = sortEdges(temp,true);
-    auto last = std::unique(sorted.begin(), sorted.end(), edgeSortItem::edgeEqual);  //duplicates to back
-    sorted.erase(last, sorted.end());                         //remove dupls
+    std::vector<edgeSortItem> unique;
+    unique.reserve(sorted.size());
+    vertexWelder welder(Precision::Confusion());
+    for (auto& e: sorted) {
+        gp_Pnt start(e.start.x, e.start.y, e.start.z);
+        bool isDupl = false;
+        for (auto& i: welder.findAll(start)) {
+            if (edgeSortItem::edgeEqual(unique[i], e)) {
+                isDupl = true;
+                break;
+            }
+        }
+        if (!isDupl) {
+            welder.add(start);
+            unique.push_back(e);
+        }
+    }
+    sorted.swap(unique);
 
     //TODO: "sorted" turns to garbage if pagescale set to "0.1"!!!!???? ***
-    for (auto e: sorted) {
+    result.reserve(sorted.size());
+    for (auto& e: sorted) {
         if (e.idx < inEdges.size()) {
             result.push_back(inEdges.at(e.idx));                  //<<< ***here
         } else {
@@ -52,6 +52,12 @@ struct splitPoint {
     double param;
 };
 
+//! a message kept back by a worker thread, to be printed by the calling thread
+struct splitMessage {
+    bool error;
+    std::string text;
+};
+
 class edgeSortItem
 {
 public:
@@ -82,17 +88,20 @@ public:
     static TechDraw::GeometryObject*  buildGeometryObject(TopoDS_Shape shape, const gp_Ax2& viewAxis);
 
     static bool isOnEdge(TopoDS_Edge e, TopoDS_Vertex v, double& param, bool allowEnds = false);
+    static std::vector<splitPoint> getSplitPoints(const std::vector<TopoDS_Edge>& edges);
     static std::vector<TopoDS_Edge> splitEdges(std::vector<TopoDS_Edge> orig, std::vector<splitPoint> splits);
     static std::vector<TopoDS_Edge> split1Edge(TopoDS_Edge e, std::vector<splitPoint> splitPoints);
 
     static std::vector<splitPoint> sortSplits(std::vector<splitPoint>& s, bool ascend);
     static bool splitCompare(const splitPoint& p1, const splitPoint& p2);
     static bool splitEqual(const splitPoint& p1, const splitPoint& p2);
-    static std::vector<TopoDS_Edge> removeDuplicateEdges(std::vector<TopoDS_Edge>& inEdges);
+    static std::vector<TopoDS_Edge> removeDuplicateEdges(const std::vector<TopoDS_Edge>& inEdges);
     static std::vector<edgeSortItem> sortEdges(std::vector<edgeSortItem>& e, bool ascend);
 
 protected:
     static std::vector<TopoDS_Edge> getEdges(TechDraw::GeometryObject* geometryObject);
+    static bool isOnEdge(const TopoDS_Edge& e, const TopoDS_Vertex& v, double& param, bool allowEnds,
+                         std::vector<splitMessage>& messages);
 
 
 private:
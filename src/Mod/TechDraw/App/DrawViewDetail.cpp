@@ -325,7 +325,8 @@ App::DocumentObjectExecReturn *DrawViewDetail::execute(void)
         inputCenter = TechDraw::findCentroid(mirroredShape,
                                                      dirDetail);
 
-        geometryObject = buildGeometryObject(mirroredShape,viewAxis);
+        geometryObject = buildGeometryObject(mirroredShape,viewAxis,
+                                             makeProjectionKey(scale),1.0);
         geometryObject->pruneVertexGeom(Base::Vector3d(0.0,0.0,0.0),Radius.getValue() * scale);      //remove vertices beyond clipradius
 
 #if MOD_TECHDRAW_HANDLE_FACES
@@ -365,6 +366,29 @@ double DrawViewDetail::getFudgeRadius()
     return Radius.getValue() * m_fudge;
 }
 
+//! the detail shape is new on every execute, so the key is made from the base view and the detail area
+void DrawViewDetail::addProjectionSources(TechDraw::projectionKey& key) const
+{
+    App::DocumentObject* baseObj = BaseView.getValue();
+    if ((baseObj == nullptr) ||
+        !baseObj->getTypeId().isDerivedFrom(TechDraw::DrawViewPart::getClassTypeId())) {
+        return;
+    }
+    DrawViewPart* dvp = static_cast<DrawViewPart*>(baseObj);
+    dvp->addProjectionSources(key);
+    key.addValue(dvp->getTypeId().getKey());
+    Base::Vector3d anchor = AnchorPoint.getValue();
+    Base::Vector3d dirDetail = dvp->Direction.getValue();
+    key.addValue(anchor.x);
+    key.addValue(anchor.y);
+    key.addValue(anchor.z);
+    key.addValue(Radius.getValue() * m_fudge);
+    key.addValue(dirDetail.x);
+    key.addValue(dirDetail.y);
+    key.addValue(dirDetail.z);
+    key.addValue(dvp->Rotation.getValue());
+}
+
 void DrawViewDetail::getParameters()
 {
 // what parameters are useful?
@@ -70,6 +70,7 @@ public:
 
 public:
     double getFudgeRadius(void);
+    virtual void addProjectionSources(TechDraw::projectionKey& key) const override;
 
 protected:
     Base::Vector3d toR3(const gp_Ax2 fromSystem, const Base::Vector3d fromPoint);
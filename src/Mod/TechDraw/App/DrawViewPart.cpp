@@ -74,7 +74,11 @@
 
 #include <limits>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <Standard_Version.hxx>
+
+#include <QtConcurrentRun>
 
 #include <App/Application.h>
 #include <App/Document.h>
@@ -109,6 +113,119 @@
 using namespace TechDraw;
 using namespace std;
 
+namespace TechDraw {
+
+//! inputs and result of projecting a view. run() only uses what is in here,
+//! so it can be done in a worker thread while the document is edited.
+class hlrJob
+{
+public:
+    hlrJob() :
+        go(nullptr),
+        faces(false),
+        smoothVisible(false),
+        seamVisible(false),
+        isoVisible(false),
+        hardHidden(false),
+        smoothHidden(false),
+        seamHidden(false),
+        isoHidden(false),
+        isoCount(0),
+        scale(1.0),
+        projected(false),
+        cancelled(false)
+    {}
+    ~hlrJob() { delete go; }
+
+    void run(void);
+    TechDraw::GeometryObject* release(void)
+    {
+        TechDraw::GeometryObject* result = go;
+        go = nullptr;
+        return result;
+    }
+
+    TechDraw::GeometryObject* go;
+    TopoDS_Shape shape;
+    gp_Ax2 viewAxis;
+    bool faces;
+    bool smoothVisible;
+    bool seamVisible;
+    bool isoVisible;
+    bool hardHidden;
+    bool smoothHidden;
+    bool seamHidden;
+    bool isoHidden;
+    int isoCount;
+    projectionKey key;                 //empty if the projection is not cached
+    double scale;                      //applied after projecting
+
+    bool projected;                    //edges are extracted, go can be used
+    std::atomic<bool> cancelled;       //result is no longer wanted
+    std::string error;
+};
+
+}
+
+//! project the shape and extract the edges, and the faces if wanted
+void hlrJob::run(void)
+{
+    if (cancelled) {
+        return;
+    }
+    go->projectShapeCached(key, shape, viewAxis);
+    if (cancelled) {
+        return;
+    }
+    go->scaleProjection(scale);
+
+    auto start = chrono::high_resolution_clock::now();
+
+    go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
+                        true);
+    go->extractGeometry(TechDraw::ecOUTLINE,
+                        true);
+    if (smoothVisible) {
+        go->extractGeometry(TechDraw::ecSMOOTH,
+                            true);
+    }
+    if (seamVisible) {
+        go->extractGeometry(TechDraw::ecSEAM,
+                            true);
+    }
+    if (isoVisible && (isoCount > 0)) {
+        go->extractGeometry(TechDraw::ecUVISO,
+                            true);
+    }
+    if (hardHidden) {
+        go->extractGeometry(TechDraw::ecHARD,
+                            false);
+        go->extractGeometry(TechDraw::ecOUTLINE,
+                            false);
+    }
+    if (smoothHidden) {
+        go->extractGeometry(TechDraw::ecSMOOTH,
+                            false);
+    }
+    if (seamHidden) {
+        go->extractGeometry(TechDraw::ecSEAM,
+                            false);
+    }
+    if (isoHidden && (isoCount > 0)) {
+        go->extractGeometry(TechDraw::ecUVISO,
+                            false);
+    }
+    auto end   = chrono::high_resolution_clock::now();
+    auto diff  = end - start;
+    double diffOut = chrono::duration <double, milli> (diff).count();
+    Base::Console().Log("TIMING - %s DVP spent: %.3f millisecs in GO::extractGeometry\n",go->getParentName().c_str(),diffOut);
+    projected = true;
+
+    if (faces && !go->usePolygonHLR() && !cancelled) {
+        DrawViewPart::extractFaces(go, smoothVisible, seamVisible);
+    }
+}
+
 
 //===========================================================================
 // DrawViewPart
@@ -156,10 +273,16 @@ DrawViewPart::DrawViewPart(void) :
 
     geometryObject = nullptr;
     getRunControl();
+
+    QObject::connect(&m_hlrWatcher, &QFutureWatcherBase::finished,
+                     &m_hlrWatcher, [this]() { this->onHlrFinished(); });
 }
 
 DrawViewPart::~DrawViewPart()
 {
+    //the worker may still be using the projection set up by this view
+    cancelHlr();
+    m_hlrWatcher.waitForFinished();
     delete geometryObject;
 }
 
@@ -316,10 +439,22 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
                                                  getViewAxis(stdOrg,Direction.getValue()));
                                                  
     shapeCentroid = Base::Vector3d(inputCenter.X(),inputCenter.Y(),inputCenter.Z());
+
+    //orthographic projections are cached at 1:1 and scaled afterwards, so a
+    //change of scale does not need a new projection
+    double hlrScale = getScale();
+    projectionKey key;
+    if (!Perspective.getValue() && (getScale() > 0.0)) {
+        key = makeProjectionKey(1.0);
+        if (!key.isEmpty()) {
+            hlrScale = 1.0;
+        }
+    }
+
     TopoDS_Shape mirroredShape;
     mirroredShape = TechDraw::mirrorShape(shape,
                                                   inputCenter,
-                                                  getScale());
+                                                  hlrScale);
 
     gp_Ax2 viewAxis = getViewAxis(shapeCentroid,Direction.getValue());
     if (!DrawUtil::fpCompare(Rotation.getValue(),0.0)) {
@@ -327,7 +462,14 @@ App::DocumentObjectExecReturn *DrawViewPart::execute(void)
                                                       viewAxis,
                                                       Rotation.getValue());
      }
-    geometryObject =  buildGeometryObject(mirroredShape,viewAxis);
+
+    if (useBackgroundHlr()) {
+        //the rest is done in onHlrFinished once the projection is done
+        startHlr(mirroredShape,viewAxis,key,getScale() / hlrScale);
+        return App::DocumentObject::StdReturn;
+    }
+
+    geometryObject =  buildGeometryObject(mirroredShape,viewAxis,key,getScale() / hlrScale);
 
 #if MOD_TECHDRAW_HANDLE_FACES
     auto start = chrono::high_resolution_clock::now();
@@ -397,79 +539,215 @@ void DrawViewPart::onChanged(const App::Property* prop)
 //note: slightly different than routine with same name in DrawProjectSplit
 TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis)
 {
+    return buildGeometryObject(shape, viewAxis, projectionKey(), 1.0);
+}
+
+//! project shape, which was made at 1/scale of the view, reusing a cached projection for key
+TechDraw::GeometryObject* DrawViewPart::buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis,
+                                                            const projectionKey& key, double scale)
+{
+    std::shared_ptr<hlrJob> job = setupHlr(shape, viewAxis);
+    job->key = key;
+    job->scale = scale;
+    job->run();
+    TechDraw::GeometryObject* go = job->release();
+
+    const std::vector<TechDraw::BaseGeom  *> & edges = go->getEdgeGeometry();
+    if (edges.empty()) {
+        Base::Console().Log("DVP::buildGO - NO extracted edges!\n");
+    }
+    bbox = go->calcBoundingBox();
+    return go;
+}
+
+//! collect everything needed to project the shape, so the projection does not
+//! have to look at the properties
+std::shared_ptr<hlrJob> DrawViewPart::setupHlr(TopoDS_Shape shape, gp_Ax2 viewAxis)
+{
+    std::shared_ptr<hlrJob> job = std::make_shared<hlrJob>();
     TechDraw::GeometryObject* go = new TechDraw::GeometryObject(getNameInDocument(), this);
     go->setIsoCount(IsoCount.getValue());
     go->isPerspective(Perspective.getValue());
     go->setFocus(Focus.getValue());
     go->usePolygonHLR(CoarseView.getValue());
+    job->go = go;
 
     Base::Vector3d baseProjDir = Direction.getValue();
     saveParamSpace(baseProjDir);
 
-    if (go->usePolygonHLR()){
-        go->projectShapeWithPolygonAlgo(shape,
-            viewAxis);
+    job->shape = shape;
+    job->viewAxis = viewAxis;
+    job->smoothVisible = SmoothVisible.getValue();
+    job->seamVisible = SeamVisible.getValue();
+    job->isoVisible = IsoVisible.getValue();
+    job->hardHidden = HardHidden.getValue();
+    job->smoothHidden = SmoothHidden.getValue();
+    job->seamHidden = SeamHidden.getValue();
+    job->isoHidden = IsoHidden.getValue();
+    job->isoCount = IsoCount.getValue();
+    return job;
+}
+
+projectionKey DrawViewPart::makeProjectionKey(double hlrScale) const
+{
+    projectionKey key;
+    if (!projectionCache::instance().isEnabled()) {
+        return key;
     }
-    else{
-        go->projectShape(shape,
-            viewAxis);
+    addProjectionSources(key);
+    if (key.isEmpty()) {
+        return key;
     }
+    key.addValue(getTypeId().getKey());
+    key.addValue(Rotation.getValue());
+    key.addValue(hlrScale);
+    return key;
+}
 
-    auto start = chrono::high_resolution_clock::now();
+void DrawViewPart::addProjectionSources(projectionKey& key) const
+{
+    for (auto& l: Source.getValues()) {
+        for (auto& s: getShapesFromObject(l)) {
+            if (!s.IsNull()) {
+                key.addShape(s);
+            }
+        }
+    }
+}
 
-    go->extractGeometry(TechDraw::ecHARD,                   //always show the hard&outline visible lines
-                        true);
-    go->extractGeometry(TechDraw::ecOUTLINE,
-                        true);
-    if (SmoothVisible.getValue()) {
-        go->extractGeometry(TechDraw::ecSMOOTH,
-                            true);
+//! projections are only done in the background if they are turned on and there
+//! is an event loop to report back to. it is off by default, because scripts
+//! expect the geometry to be there after recompute.
+bool DrawViewPart::useBackgroundHlr(void) const
+{
+    if (App::Application::Config()["RunMode"] != "Gui") {
+        return false;
     }
-    if (SeamVisible.getValue()) {
-        go->extractGeometry(TechDraw::ecSEAM,
-                            true);
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/General");
+    return hGrp->GetBool("BackgroundHLR", false);
+}
+
+//! project the shape in a worker thread. any projection still running for
+//! this view is out of date and gets cancelled.
+void DrawViewPart::startHlr(TopoDS_Shape shape, gp_Ax2 viewAxis,
+                            const projectionKey& key, double scale)
+{
+    cancelHlr();
+
+    std::shared_ptr<hlrJob> job = setupHlr(shape, viewAxis);
+    job->key = key;
+    job->scale = scale;
+    job->faces = handleFaces();
+    m_hlrJob = job;
+
+    QFuture<void> future = QtConcurrent::run([job]() {
+#if OCC_VERSION_HEX < 0x070000
+        Standard::SetReentrant(Standard_True);
+#endif
+        try {
+            job->run();
+        }
+        catch (Standard_Failure& e) {
+            job->error = e.GetMessageString();
+        }
+        catch (Base::Exception& e) {
+            job->error = e.what();
+        }
+        catch (std::exception& e) {
+            job->error = e.what();
+        }
+        catch (...) {
+            job->error = "unknown error while projecting shape";
+        }
+    });
+    m_hlrWatcher.setFuture(future);
+}
+
+//! forget the pending projection. HLRBRep_Algo can not be interrupted, so the
+//! worker finishes the step it is in and drops the result.
+void DrawViewPart::cancelHlr(void)
+{
+    if (m_hlrJob) {
+        m_hlrJob->cancelled = true;
+        m_hlrJob.reset();
     }
-    if ((IsoVisible.getValue()) && (IsoCount.getValue() > 0)) {
-        go->extractGeometry(TechDraw::ecUVISO,
-                            true);
+}
+
+void DrawViewPart::waitForHlr(void)
+{
+    if (m_hlrJob) {
+        m_hlrWatcher.waitForFinished();
+        onHlrFinished();
     }
-    if (HardHidden.getValue()) {
-        go->extractGeometry(TechDraw::ecHARD,
-                            false);
-        go->extractGeometry(TechDraw::ecOUTLINE,
-                            false);
+}
+
+//! use the result of the background projection
+void DrawViewPart::onHlrFinished(void)
+{
+    if (!m_hlrJob || !m_hlrWatcher.isFinished()) {
+        return;                           //superseded, or already handled by waitForHlr
     }
-    if (SmoothHidden.getValue()) {
-        go->extractGeometry(TechDraw::ecSMOOTH,
-                            false);
+    std::shared_ptr<hlrJob> job = m_hlrJob;
+    m_hlrJob.reset();
+
+    if (!job->error.empty()) {
+        Base::Console().Error("Error: DVP - %s - %s\n",
+                              getNameInDocument(), job->error.c_str());
     }
-    if (SeamHidden.getValue()) {
-        go->extractGeometry(TechDraw::ecSEAM,
-                            false);
+    if (!job->projected) {
+        return;
     }
-    if (IsoHidden.getValue() && (IsoCount.getValue() > 0)) {
-        go->extractGeometry(TechDraw::ecUVISO,
-                            false);
+
+    geometryObject = job->release();
+    bbox = geometryObject->calcBoundingBox();
+    if (geometryObject->getEdgeGeometry().empty()) {
+        Base::Console().Log("DVP::onHlrFinished - NO extracted edges!\n");
     }
-    auto end   = chrono::high_resolution_clock::now();
-    auto diff  = end - start;
-    double diffOut = chrono::duration <double, milli> (diff).count();
-    Base::Console().Log("TIMING - %s DVP spent: %.3f millisecs in GO::extractGeometry\n",getNameInDocument(),diffOut);
 
-    const std::vector<TechDraw::BaseGeom  *> & edges = go->getEdgeGeometry();
-    if (edges.empty()) {
-        Base::Console().Log("DVP::buildGO - NO extracted edges!\n");
+    //add the cosmetic vertices to the geometry vertices list
+    addCosmeticVertexesToGeom();
+    //add the cosmetic Edges to geometry Edges list
+    addCosmeticEdgesToGeom();
+    //add centerlines to geometry edges list
+    addCenterLinesToGeom();
+
+    postHlrTasks();
+}
+
+void DrawViewPart::postHlrTasks(void)
+{
+    //dimensions and balloons were computed against the previous geometry
+    bool recomputing = getDocument()->testStatus(App::Document::Recomputing);
+    for (auto& d: getDimensions()) {
+        if (recomputing) {
+            d->touch();
+        } else {
+            d->recomputeFeature();
+        }
     }
-    bbox = go->calcBoundingBox();
-    return go;
+    for (auto& b: getBalloons()) {
+        if (recomputing) {
+            b->touch();
+        } else {
+            b->recomputeFeature();
+        }
+    }
+    requestPaint();
 }
 
 //! make faces from the existing edge geometry
 void DrawViewPart::extractFaces()
 {
-    geometryObject->clearFaceGeom();
+    extractFaces(geometryObject, SmoothVisible.getValue(), SeamVisible.getValue());
+}
+
+//! make faces from the visible edges of go
+void DrawViewPart::extractFaces(TechDraw::GeometryObject* go, bool smoothVisible, bool seamVisible)
+{
+    go->clearFaceGeom();
     const std::vector<TechDraw::BaseGeom*>& goEdges =
-                       geometryObject->getVisibleFaceEdges(SmoothVisible.getValue(),SeamVisible.getValue());
+                       go->getVisibleFaceEdges(smoothVisible,seamVisible);
     std::vector<TechDraw::BaseGeom*>::const_iterator itEdge = goEdges.begin();
     std::vector<TopoDS_Edge> origEdges;
     for (;itEdge != goEdges.end(); itEdge++) {
@@ -483,71 +761,14 @@ void DrawViewPart::extractFaces()
         if (!DrawUtil::isZeroEdge(e)) {
             nonZero.push_back(e);
         } else {
-            Base::Console().Message("INFO - DVP::extractFaces for %s found ZeroEdge!\n",getNameInDocument());
+            Base::Console().Message("INFO - DVP::extractFaces for %s found ZeroEdge!\n",go->getParentName().c_str());
         }
     }
     faceEdges = nonZero;
-    origEdges = nonZero;
 
     //HLR algo does not provide all edge intersections for edge endpoints.
     //need to split long edges touched by Vertex of another edge
-    std::vector<splitPoint> splits;
-    std::vector<TopoDS_Edge>::iterator itOuter = origEdges.begin();
-    int iOuter = 0;
-    for (; itOuter != origEdges.end(); ++itOuter, iOuter++) {
-        TopoDS_Vertex v1 = TopExp::FirstVertex((*itOuter));
-        TopoDS_Vertex v2 = TopExp::LastVertex((*itOuter));
-        Bnd_Box sOuter;
-        BRepBndLib::Add(*itOuter, sOuter);
-        sOuter.SetGap(0.1);
-        if (sOuter.IsVoid()) {
-            Base::Console().Message("DVP::Extract Faces - outer Bnd_Box is void for %s\n",getNameInDocument());
-            continue;
-        }
-        if (DrawUtil::isZeroEdge(*itOuter)) {
-            Base::Console().Message("DVP::extractFaces - outerEdge: %d is ZeroEdge\n",iOuter);   //this is not finding ZeroEdges
-            continue;  //skip zero length edges. shouldn't happen ;)
-        }
-        int iInner = 0;
-        std::vector<TopoDS_Edge>::iterator itInner = faceEdges.begin();
-        for (; itInner != faceEdges.end(); ++itInner,iInner++) {
-            if (iInner == iOuter) {
-                continue;
-            }
-            if (DrawUtil::isZeroEdge((*itInner))) {
-                continue;  //skip zero length edges. shouldn't happen ;)
-            }
-
-            Bnd_Box sInner;
-            BRepBndLib::Add(*itInner, sInner);
-            sInner.SetGap(0.1);
-            if (sInner.IsVoid()) {
-                Base::Console().Log("INFO - DVP::Extract Faces - inner Bnd_Box is void for %s\n",getNameInDocument());
-                continue;
-            }
-            if (sOuter.IsOut(sInner)) {      //bboxes of edges don't intersect, don't bother
-                continue;
-            }
-
-            double param = -1;
-            if (DrawProjectSplit::isOnEdge((*itInner),v1,param,false)) {
-                gp_Pnt pnt1 = BRep_Tool::Pnt(v1);
-                splitPoint s1;
-                s1.i = iInner;
-                s1.v = Base::Vector3d(pnt1.X(),pnt1.Y(),pnt1.Z());
-                s1.param = param;
-                splits.push_back(s1);
-            }
-            if (DrawProjectSplit::isOnEdge((*itInner),v2,param,false)) {
-                gp_Pnt pnt2 = BRep_Tool::Pnt(v2);
-                splitPoint s2;
-                s2.i = iInner;
-                s2.v = Base::Vector3d(pnt2.X(),pnt2.Y(),pnt2.Z());
-                s2.param = param;
-                splits.push_back(s2);
-            }
-        } //inner loop
-    }   //outer loop
+    std::vector<splitPoint> splits = DrawProjectSplit::getSplitPoints(faceEdges);
 
     std::vector<splitPoint> sorted = DrawProjectSplit::sortSplits(splits,true);
     auto last = std::unique(sorted.begin(), sorted.end(), DrawProjectSplit::splitEqual);  //duplicates to back
@@ -566,7 +787,7 @@ void DrawViewPart::extractFaces()
     ew.loadEdges(newEdges);
     bool success = ew.perform();
     if (!success) {
-        Base::Console().Warning("DVP::extractFaces - %s -Can't make faces from projected edges\n", getNameInDocument());
+        Base::Console().Warning("DVP::extractFaces - %s -Can't make faces from projected edges\n", go->getParentName().c_str());
         return;
     }
     std::vector<TopoDS_Wire> fw = ew.getResultNoDups();
@@ -580,7 +801,7 @@ void DrawViewPart::extractFaces()
         const TopoDS_Wire& wire = (*itWire);
         TechDraw::Wire* w = new TechDraw::Wire(wire);
         f->wires.push_back(w);
-        geometryObject->addFaceGeom(f);
+        go->addFaceGeom(f);
     }
 }
 
@@ -641,18 +862,31 @@ std::vector<TechDraw::DrawViewBalloon*> DrawViewPart::getBalloons() const
     return result;
 }
 
+//the geometry is empty until the first projection of the view is done
 const std::vector<TechDraw::Vertex *> & DrawViewPart::getVertexGeometry() const
 {
+    if (geometryObject == nullptr) {
+        static const std::vector<TechDraw::Vertex *> noVertexes;
+        return noVertexes;
+    }
     return geometryObject->getVertexGeometry();
 }
 
 const std::vector<TechDraw::Face *> & DrawViewPart::getFaceGeometry() const
 {
+    if (geometryObject == nullptr) {
+        static const std::vector<TechDraw::Face *> noFaces;
+        return noFaces;
+    }
     return geometryObject->getFaceGeometry();
 }
 
 const std::vector<TechDraw::BaseGeom  *> & DrawViewPart::getEdgeGeometry() const
 {
+    if (geometryObject == nullptr) {
+        static const std::vector<TechDraw::BaseGeom *> noEdges;
+        return noEdges;
+    }
     return geometryObject->getEdgeGeometry();
 }
 
@@ -844,6 +1078,9 @@ std::vector<DrawViewDetail*> DrawViewPart::getDetailRefs(void) const
 
 const std::vector<TechDraw::BaseGeom  *> DrawViewPart::getVisibleFaceEdges() const
 {
+    if (geometryObject == nullptr) {
+        return std::vector<TechDraw::BaseGeom *>();
+    }
     return geometryObject->getVisibleFaceEdges(SmoothVisible.getValue(),SeamVisible.getValue());
 }
 
@@ -880,6 +1117,7 @@ bool DrawViewPart::showSectionEdges(void)
 void DrawViewPart::unsetupObject()
 {
     nowUnsetting = true;
+    cancelHlr();
     App::Document* doc = getDocument();
     std::string docName = doc->getName();
 
@@ -1068,6 +1306,9 @@ TechDraw::CosmeticVertex* DrawViewPart::getCosmeticVertexByGeom(int idx) const
 //add the cosmetic verts to geometry vertex list
 void DrawViewPart::addCosmeticVertexesToGeom(void)
 {
+    if (geometryObject == nullptr) {
+        return;                       //added once the projection is done
+    }
     int i = 0;
     const std::vector<TechDraw::CosmeticVertex*> verts = CosmeticVertexes.getValues();
     int stop = (int) verts.size();
@@ -1215,6 +1456,9 @@ int DrawViewPart::getCosmeticEdgeIndex(TechDraw::CosmeticEdge* ce) const
 //add the cosmetic edges to geometry Edges list
 void DrawViewPart::addCosmeticEdgesToGeom(void)
 {
+    if (geometryObject == nullptr) {
+        return;                       //added once the projection is done
+    }
     int i = 0;
     const std::vector<TechDraw::CosmeticEdge*> edges = CosmeticEdges.getValues();
     int stop = (int) edges.size();
@@ -1320,6 +1564,9 @@ TechDraw::CenterLine* DrawViewPart::getCenterLineByGeom(int idx) const
 void DrawViewPart::addCenterLinesToGeom(void)
 {
 //   Base::Console().Message("DVP::addCenterLinesToGeom()\n");
+    if (geometryObject == nullptr) {
+        return;                       //added once the projection is done
+    }
    int i = 0;
     const std::vector<TechDraw::CenterLine*> lines = CenterLines.getValues();
     int stop = (int) lines.size();
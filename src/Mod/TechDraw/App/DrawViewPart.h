@@ -29,6 +29,9 @@
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Wire.hxx>
 
+#include <memory>
+#include <QFutureWatcher>
+
 #include <App/DocumentObject.h>
 #include <App/PropertyLinks.h>
 #include <App/PropertyStandard.h>
@@ -82,6 +85,8 @@ namespace TechDraw
 {
 
 class DrawViewSection;
+class hlrJob;
+class projectionKey;
 
 class TechDrawExport DrawViewPart : public DrawView
 {
@@ -157,6 +162,18 @@ public:
     bool handleFaces(void);
     bool showSectionEdges(void);
 
+    //! make faces from the visible edges of go
+    static void extractFaces(TechDraw::GeometryObject* go, bool smoothVisible, bool seamVisible);
+
+    //! true while a background projection for this view is running
+    bool waitingForHlr(void) const { return m_hlrJob != nullptr; }
+    //! block until a pending background projection has finished and use its result
+    void waitForHlr(void);
+    //! things to do once the projection is in place
+    virtual void postHlrTasks(void);
+    //! add the shapes and settings this view is made from to key
+    virtual void addProjectionSources(TechDraw::projectionKey& key) const;
+
     bool isUnsetting(void) { return nowUnsetting; }
     
     gp_Pln getProjPlane(void) const;
@@ -214,8 +231,19 @@ protected:
     virtual void unsetupObject();
 
     virtual TechDraw::GeometryObject*  buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis);
+    TechDraw::GeometryObject*  buildGeometryObject(TopoDS_Shape shape, gp_Ax2 viewAxis,
+                                                   const TechDraw::projectionKey& key, double scale);
     void extractFaces();
 
+    //! key for caching a projection made at hlrScale, empty if the cache is off
+    TechDraw::projectionKey makeProjectionKey(double hlrScale) const;
+
+    bool useBackgroundHlr(void) const;
+    void startHlr(TopoDS_Shape shape, gp_Ax2 viewAxis,
+                  const TechDraw::projectionKey& key, double scale);
+    void onHlrFinished(void);
+    void cancelHlr(void);
+
     //Projection parameter space
     virtual void saveParamSpace(const Base::Vector3d& direction, const Base::Vector3d& xAxis=Base::Vector3d(0.0,0.0,0.0));
     Base::Vector3d uDir;                       //paperspace X
@@ -229,6 +257,9 @@ protected:
 
 private:
     bool nowUnsetting;
+    std::shared_ptr<hlrJob> setupHlr(TopoDS_Shape shape, gp_Ax2 viewAxis);
+    std::shared_ptr<hlrJob> m_hlrJob;
+    QFutureWatcher<void> m_hlrWatcher;
 
 };
 
@@ -309,7 +309,8 @@ PyObject* DrawViewPartPy::getCosmeticEdgeByGeom(PyObject *args)
         throw Py::TypeError("expected (index)");
     }
     DrawViewPart* dvp = getDrawViewPartPtr();
-    
+    dvp->waitForHlr();                    //the geometry of a pending projection
+
     TechDraw::BaseGeom* bg = dvp->getGeomByIndex(idx);
     if (bg == nullptr) {
         Base::Console().Error("DVPPI::getCEbyGeom - geom: %d not found\n",idx);
@@ -503,6 +504,16 @@ PyObject* DrawViewPartPy::formatGeometricEdge(PyObject *args)
     return Py_None;
 }
 
+PyObject* DrawViewPartPy::waitForHlr(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        throw Py::TypeError("no arguments expected");
+    }
+    DrawViewPart* dvp = getDrawViewPartPtr();
+    dvp->waitForHlr();
+    Py_INCREF(Py_None);
+    return Py_None;
+}
 
 PyObject *DrawViewPartPy::getCustomAttributes(const char* /*attr*/) const
 {
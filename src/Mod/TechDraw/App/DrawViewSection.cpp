@@ -279,7 +279,8 @@ App::DocumentObjectExecReturn *DrawViewSection::execute(void)
                                                           viewAxis,
                                                           Rotation.getValue());
         }
-        geometryObject = buildGeometryObject(mirroredShape,viewAxis);   //this is original shape after cut by section prism
+        geometryObject = buildGeometryObject(mirroredShape,viewAxis,        //this is original shape after cut by section prism
+                                             makeProjectionKey(getScale()),1.0);
 
 #if MOD_TECHDRAW_HANDLE_FACES
         extractFaces();
@@ -337,6 +338,26 @@ App::DocumentObjectExecReturn *DrawViewSection::execute(void)
     return App::DocumentObject::StdReturn;
 }
 
+//! the cut shape is new on every execute, so the key is made from what was cut and how
+void DrawViewSection::addProjectionSources(TechDraw::projectionKey& key) const
+{
+    App::DocumentObject* base = BaseView.getValue();
+    if ((base == nullptr) ||
+        !base->getTypeId().isDerivedFrom(TechDraw::DrawViewPart::getClassTypeId())) {
+        return;
+    }
+    static_cast<TechDraw::DrawViewPart*>(base)->addProjectionSources(key);
+    key.addValue(FuseBeforeCut.getValue() ? 1.0 : 0.0);
+    Base::Vector3d origin = SectionOrigin.getValue();
+    Base::Vector3d normal = SectionNormal.getValue();
+    key.addValue(origin.x);
+    key.addValue(origin.y);
+    key.addValue(origin.z);
+    key.addValue(normal.x);
+    key.addValue(normal.y);
+    key.addValue(normal.z);
+}
+
 gp_Pln DrawViewSection::getSectionPlane() const
 {
     Base::Vector3d plnPnt = SectionOrigin.getValue();
@@ -97,6 +97,7 @@ public:
     std::vector<PATLineSpec> getDecodedSpecsFromFile(std::string fileSpec, std::string myPattern);
 
     TopoDS_Shape getCutShape(void) {return m_cutShape;}
+    virtual void addProjectionSources(TechDraw::projectionKey& key) const override;
 
     static const char* SectionDirEnums[];
 
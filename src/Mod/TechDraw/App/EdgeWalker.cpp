@@ -45,6 +45,8 @@
 #endif
 #include <sstream>
 #include <cmath>
+#include <algorithm>
+#include <functional>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -55,6 +57,91 @@
 using namespace TechDraw;
 using namespace boost;
 
+//*******************************************************
+//* vertexWelder methods
+//*******************************************************
+vertexWelder::vertexWelder(double tol) :
+    tolerance(tol)
+{
+}
+
+vertexWelder::cellKey vertexWelder::getKey(const gp_Pnt& p) const
+{
+    cellKey k;
+    k.x = static_cast<long long>(std::floor(p.X() / tolerance));
+    k.y = static_cast<long long>(std::floor(p.Y() / tolerance));
+    k.z = static_cast<long long>(std::floor(p.Z() / tolerance));
+    return k;
+}
+
+std::size_t vertexWelder::cellHash::operator()(const cellKey& k) const
+{
+    std::size_t h = std::hash<long long>()(k.x);
+    h ^= std::hash<long long>()(k.y) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    h ^= std::hash<long long>()(k.z) + 0x9e3779b9 + (h << 6) + (h >> 2);
+    return h;
+}
+
+int vertexWelder::add(const gp_Pnt& p)
+{
+    int idx = points.size();
+    points.push_back(p);
+    cells[getKey(p)].push_back(idx);
+    return idx;
+}
+
+int vertexWelder::find(const gp_Pnt& p) const
+{
+    //points within tolerance can only be in this cell or its neighbours
+    int result = -1;
+    cellKey k = getKey(p);
+    cellKey n;
+    for (n.x = k.x - 1; n.x <= k.x + 1; n.x++) {
+        for (n.y = k.y - 1; n.y <= k.y + 1; n.y++) {
+            for (n.z = k.z - 1; n.z <= k.z + 1; n.z++) {
+                auto it = cells.find(n);
+                if (it == cells.end()) {
+                    continue;
+                }
+                for (auto& i: it->second) {              //cell lists are in ascending order
+                    if (result >= 0 && i >= result) {
+                        break;
+                    }
+                    if (points[i].IsEqual(p, tolerance)) {
+                        result = i;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<int> vertexWelder::findAll(const gp_Pnt& p) const
+{
+    std::vector<int> result;
+    cellKey k = getKey(p);
+    cellKey n;
+    for (n.x = k.x - 1; n.x <= k.x + 1; n.x++) {
+        for (n.y = k.y - 1; n.y <= k.y + 1; n.y++) {
+            for (n.z = k.z - 1; n.z <= k.z + 1; n.z++) {
+                auto it = cells.find(n);
+                if (it == cells.end()) {
+                    continue;
+                }
+                for (auto& i: it->second) {
+                    if (points[i].IsEqual(p, tolerance)) {
+                        result.push_back(i);
+                    }
+                }
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
 //*******************************************************
 //* edgeVisior methods
 //*******************************************************
@@ -103,7 +190,8 @@ void edgeVisitor::setGraph(TechDraw::graph& g)
 #define EWTOLERANCE 0.00001    //arbitrary number that seems to give good results for drawing
 
 
-EdgeWalker::EdgeWalker()
+EdgeWalker::EdgeWalker() :
+    m_saveInEdges(nullptr)
 {
 }
 
@@ -128,7 +216,7 @@ bool EdgeWalker::loadEdges(std::vector<TechDraw::WalkerEdge>& edges)
     return true;
 }
 
-bool EdgeWalker::loadEdges(std::vector<TopoDS_Edge> edges)
+bool EdgeWalker::loadEdges(const std::vector<TopoDS_Edge>& edges)
 {
     //Base::Console().Message("TRACE -EW::loadEdges(TopoDS)\n");
     if (edges.empty()) {
@@ -236,8 +324,7 @@ std::vector<TopoDS_Wire> EdgeWalker::getResultWires()
         std::vector<WalkerEdge>::iterator iEdge = (*iWire).wedges.begin();
         std::vector<TopoDS_Edge> topoEdges;
         for (;iEdge != (*iWire).wedges.end(); iEdge++) {
-            TopoDS_Edge e = m_saveInEdges.at((*iEdge).idx);
-            topoEdges.push_back(e);
+            topoEdges.push_back(getInEdge((*iEdge).idx));
         }
     TopoDS_Wire w = makeCleanWire(topoEdges);             //make 1 clean wire from its edges
     fw.push_back(w);
@@ -261,8 +348,7 @@ std::vector<TopoDS_Wire> EdgeWalker::getResultNoDups()
         std::vector<WalkerEdge>::iterator iEdge = (*iWire).wedges.begin();
         std::vector<TopoDS_Edge> topoEdges;
         for (;iEdge != (*iWire).wedges.end(); iEdge++) {
-            TopoDS_Edge e = m_saveInEdges.at((*iEdge).idx);
-            topoEdges.push_back(e);
+            topoEdges.push_back(getInEdge((*iEdge).idx));
         }
     TopoDS_Wire w = makeCleanWire(topoEdges);             //make 1 clean wire from its edges
     fw.push_back(w);
@@ -270,6 +356,15 @@ std::vector<TopoDS_Wire> EdgeWalker::getResultNoDups()
     return fw;
 }
 
+//! the loaded TopoDS_Edge of a WalkerEdge
+const TopoDS_Edge& EdgeWalker::getInEdge(int idx) const
+{
+    if (m_saveInEdges == nullptr) {
+        throw Base::ValueError("EdgeWalker has no TopoDS_Edges loaded\n");
+    }
+    return m_saveInEdges->at(idx);
+}
+
 //* static *//
 //! make a clean wire with sorted, oriented, connected, etc edges
 TopoDS_Wire EdgeWalker::makeCleanWire(std::vector<TopoDS_Edge> edges, double tol)
@@ -303,44 +398,49 @@ TopoDS_Wire EdgeWalker::makeCleanWire(std::vector<TopoDS_Edge> edges, double tol
     return result;
 }
 
-std::vector<TopoDS_Vertex> EdgeWalker:: makeUniqueVList(std::vector<TopoDS_Edge> edges)
+std::vector<TopoDS_Vertex> EdgeWalker::makeUniqueVList(const std::vector<TopoDS_Edge>& edges)
 {
     //Base::Console().Message("TRACE - EW::makeUniqueVList()\n");
     std::vector<TopoDS_Vertex> uniqueVert;
+    vertexWelder welder(EWTOLERANCE);
     for(auto& e:edges) {
         TopoDS_Vertex v1 = TopExp::FirstVertex(e);
         TopoDS_Vertex v2 = TopExp::LastVertex(e);
-        bool addv1 = true;
-        bool addv2 = true;
-        for (auto v:uniqueVert) {
-            if (DrawUtil::isSamePoint(v,v1,EWTOLERANCE))
-                addv1 = false;
-            if (DrawUtil::isSamePoint(v,v2,EWTOLERANCE))
-                addv2 = false;
-        }
-        if (addv1)
+        gp_Pnt p1 = BRep_Tool::Pnt(v1);
+        gp_Pnt p2 = BRep_Tool::Pnt(v2);
+        bool addv1 = (welder.find(p1) < 0);
+        bool addv2 = (welder.find(p2) < 0);
+        if (addv1) {
             uniqueVert.push_back(v1);
-        if (addv2)
+            welder.add(p1);
+        }
+        if (addv2) {
             uniqueVert.push_back(v2);
+            welder.add(p2);
+        }
     }
     return uniqueVert;
 }
 
 //!make WalkerEdges (unique Vertex index pairs) from edge list
-std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edges,
-                                                      std::vector<TopoDS_Vertex> verts)
+std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(const std::vector<TopoDS_Edge>& edges,
+                                                      const std::vector<TopoDS_Vertex>& verts)
 {
 //    Base::Console().Message("TRACE - EW::makeWalkerEdges()\n");
-    m_saveInEdges = edges;
+    m_saveInEdges = &edges;
+    vertexWelder welder(EWTOLERANCE);
+    for (auto& v: verts) {
+        welder.add(BRep_Tool::Pnt(v));
+    }
+
     std::vector<WalkerEdge> walkerEdges;
-    for (auto e:edges) {
-        TopoDS_Vertex ev1 = TopExp::FirstVertex(e);
-        TopoDS_Vertex ev2 = TopExp::LastVertex(e);
-        int v1dx = findUniqueVert(ev1, verts);
-        int v2dx = findUniqueVert(ev2, verts);
+    walkerEdges.reserve(edges.size());
+    for (auto& e:edges) {
+        int v1dx = welder.find(BRep_Tool::Pnt(TopExp::FirstVertex(e)));
+        int v2dx = welder.find(BRep_Tool::Pnt(TopExp::LastVertex(e)));
         WalkerEdge we;
-        we.v1 = v1dx;
-        we.v2 = v2dx;
+        we.v1 = std::max(v1dx, 0);                 //we're always going to find the vertex, right?
+        we.v2 = std::max(v2dx, 0);
         walkerEdges.push_back(we);
     }
 
@@ -348,21 +448,6 @@ std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edg
     return walkerEdges;
 }
 
-int EdgeWalker::findUniqueVert(TopoDS_Vertex vx, std::vector<TopoDS_Vertex> &uniqueVert)
-{
-//    Base::Console().Message("TRACE - EW::findUniqueVert()\n");
-    int idx = 0;
-    int result = 0;
-    for(auto& v:uniqueVert) {                    //we're always going to find vx, right?
-        if (DrawUtil::isSamePoint(v,vx,EWTOLERANCE)) {
-            result = idx;
-            break;
-        }
-        idx++;
-    }                                           //if idx >= uniqueVert.size() TARFU
-    return result;
-}
-
 std::vector<TopoDS_Wire> EdgeWalker::sortStrip(std::vector<TopoDS_Wire> fw, bool includeBiggest)
 {
     std::vector<TopoDS_Wire> closedWires;                  //all the wires should be closed, but anomalies happen
@@ -404,32 +489,40 @@ std::vector<TopoDS_Wire> EdgeWalker::sortWiresBySize(std::vector<TopoDS_Wire>& w
     return area1 > area2;
 }
 
-std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge> edges,
-                                                 const std::vector<TopoDS_Vertex> uniqueVList)
+std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge>& edges,
+                                                 const std::vector<TopoDS_Vertex>& uniqueVList)
 {
 //    Base::Console().Message("TRACE - EW::makeEmbedding(edges: %d, verts: %d)\n",
 //                            edges.size(),uniqueVList.size());
-    std::vector<embedItem> result;
-
-    int iv = 0;
+    vertexWelder welder(EWTOLERANCE);
     for (auto& v: uniqueVList) {
-        int ie = 0;
-        std::vector<incidenceItem> iiList;
-        for (auto& e: edges) {
-            double angle = 0;
-            if (DrawUtil::isFirstVert(e,v,EWTOLERANCE)) {
-                angle = DrawUtil::angleWithX(e,v,EWTOLERANCE);
-                incidenceItem ii(ie, angle, m_saveWalkerEdges[ie].ed);
-                iiList.push_back(ii);
-            } else if (DrawUtil::isLastVert(e,v,EWTOLERANCE)) {
-                angle = DrawUtil::angleWithX(e,v,EWTOLERANCE);
-                incidenceItem ii(ie, angle, m_saveWalkerEdges[ie].ed);
-                iiList.push_back(ii);
-            } else {
-                //Base::Console().Message("TRACE - EW::makeEmbedding - neither first nor last\n");
+        welder.add(BRep_Tool::Pnt(v));
+    }
+
+    //each edge is only incident to the vertices at its ends
+    std::vector<std::vector<incidenceItem> > iiLists(uniqueVList.size());
+    int ie = 0;
+    for (auto& e: edges) {
+        std::vector<int> first = welder.findAll(BRep_Tool::Pnt(TopExp::FirstVertex(e)));
+        std::vector<int> last  = welder.findAll(BRep_Tool::Pnt(TopExp::LastVertex(e)));
+        auto firstEnd = first.size();
+        for (auto& iv: last) {
+            if (!std::binary_search(first.begin(), first.begin() + firstEnd, iv)) {
+                first.push_back(iv);
             }
-            ie++;
-       }
+        }
+        for (auto& iv: first) {
+            double angle = DrawUtil::angleWithX(e,uniqueVList[iv],EWTOLERANCE);
+            incidenceItem ii(ie, angle, m_saveWalkerEdges[ie].ed);
+            iiLists[iv].push_back(ii);
+        }
+        ie++;
+    }
+
+    std::vector<embedItem> result;
+    result.reserve(uniqueVList.size());
+    int iv = 0;
+    for (auto& iiList: iiLists) {
        //sort incidenceList by angle
        iiList = embedItem::sortIncidenceList(iiList,  false);
        embedItem embed(iv, iiList);
@@ -30,6 +30,7 @@
 
 #include <vector>
 #include <iostream>
+#include <unordered_map>
 
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/properties.hpp>
@@ -40,6 +41,7 @@
 #include <boost/graph/planar_face_traversal.hpp>
 #include <boost/ref.hpp>
 
+#include <gp_Pnt.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Wire.hxx>
@@ -154,6 +156,36 @@ public:
 };
 
 
+//! tolerance aware lookup of points, hashed on a grid with cells the size of the tolerance
+//! so that only the neighbouring cells need to be searched
+class vertexWelder
+{
+public:
+    vertexWelder(double tolerance);
+
+    //! adds a point, even if there is already one within tolerance, and returns its index
+    int add(const gp_Pnt& p);
+    //! index of the first point within tolerance of p, or -1
+    int find(const gp_Pnt& p) const;
+    //! indices of all points within tolerance of p, in ascending order
+    std::vector<int> findAll(const gp_Pnt& p) const;
+    std::size_t size(void) const { return points.size(); }
+
+private:
+    struct cellKey {
+        long long x, y, z;
+        bool operator==(const cellKey& k) const { return x == k.x && y == k.y && z == k.z; }
+    };
+    struct cellHash {
+        std::size_t operator()(const cellKey& k) const;
+    };
+    cellKey getKey(const gp_Pnt& p) const;
+
+    double tolerance;
+    std::vector<gp_Pnt> points;
+    std::unordered_map<cellKey, std::vector<int>, cellHash> cells;
+};
+
 class EdgeWalker
 {
 public:
@@ -161,31 +193,33 @@ public:
     virtual ~EdgeWalker();
 
     bool loadEdges(std::vector<TechDraw::WalkerEdge>& edges);
-    bool loadEdges(std::vector<TopoDS_Edge> edges);
+    bool loadEdges(const std::vector<TopoDS_Edge>& edges);
     bool setSize(int size);
     bool perform();
     ewWireList getResult();
     std::vector<TopoDS_Wire> getResultWires();
     std::vector<TopoDS_Wire> getResultNoDups();
 
-    std::vector<TopoDS_Vertex> makeUniqueVList(std::vector<TopoDS_Edge> edges);
-    std::vector<WalkerEdge>    makeWalkerEdges(std::vector<TopoDS_Edge> edges,
-                                               std::vector<TopoDS_Vertex> verts);
+    std::vector<TopoDS_Vertex> makeUniqueVList(const std::vector<TopoDS_Edge>& edges);
+    std::vector<WalkerEdge>    makeWalkerEdges(const std::vector<TopoDS_Edge>& edges,
+                                               const std::vector<TopoDS_Vertex>& verts);
 
-    int findUniqueVert(TopoDS_Vertex vx, std::vector<TopoDS_Vertex> &uniqueVert);
     std::vector<TopoDS_Wire> sortStrip(std::vector<TopoDS_Wire> fw, bool includeBiggest);
     std::vector<TopoDS_Wire> sortWiresBySize(std::vector<TopoDS_Wire>& w, bool reverse = false);
     static TopoDS_Wire makeCleanWire(std::vector<TopoDS_Edge> edges, double tol = 0.10);
 
     std::vector<int> getEmbeddingRowIx(int v);
     std::vector<edge_t> getEmbeddingRow(int v);
-    std::vector<embedItem> makeEmbedding(const std::vector<TopoDS_Edge> edges,
-                                                 const std::vector<TopoDS_Vertex> uniqueVList);
+    std::vector<embedItem> makeEmbedding(const std::vector<TopoDS_Edge>& edges,
+                                                 const std::vector<TopoDS_Vertex>& uniqueVList);
 
 protected:
     static bool wireCompare(const TopoDS_Wire& w1, const TopoDS_Wire& w2);
+    const TopoDS_Edge& getInEdge(int idx) const;
     std::vector<TechDraw::WalkerEdge> m_saveWalkerEdges;
-    std::vector<TopoDS_Edge> m_saveInEdges;
+    //! the edges given to loadEdges(), indexed by WalkerEdge::idx. they are not
+    //! copied, so they must be kept until the results have been read.
+    const std::vector<TopoDS_Edge>* m_saveInEdges;
     std::vector<embedItem> m_embedding;
 
 private:
@@ -65,10 +65,13 @@
 
 #include <algorithm>
 #include <chrono>
+#include <functional>
 
+#include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
 #include <Base/FileInfo.h>
+#include <Base/Parameter.h>
 #include <Base/Tools.h>
 
 #include <Mod/Part/App/PartFeature.h>
@@ -157,6 +160,79 @@ void GeometryObject::clear()
     edgeGeom.clear();
 }
 
+//!project the shape, or reuse an earlier projection of the same shapes
+void GeometryObject::projectShapeCached(const projectionKey& key,
+                                        const TopoDS_Shape& input,
+                                        const gp_Ax2 viewAxis)
+{
+    if (key.isEmpty()) {
+        if (m_usePolygonHLR) {
+            projectShapeWithPolygonAlgo(input, viewAxis);
+        } else {
+            projectShape(input, viewAxis);
+        }
+        return;
+    }
+
+    projectionKey fullKey = key;
+    fullKey.addAxis(viewAxis);
+    fullKey.addValue(m_isoCount);
+    fullKey.addValue(m_isPersp ? 1.0 : 0.0);
+    fullKey.addValue(m_focus);
+    fullKey.addValue(m_usePolygonHLR ? 1.0 : 0.0);
+
+    std::vector<TopoDS_Shape*> projected = getProjectedShapes();
+    std::vector<TopoDS_Shape> result;
+    if (projectionCache::instance().find(fullKey, result)) {
+        clear();
+        for (unsigned int i = 0; i < projected.size(); i++) {
+            *projected[i] = result[i];
+        }
+        Base::Console().Log("LOG - GO::projectShapeCached - %s uses cached projection\n",m_parentName.c_str());
+        return;
+    }
+
+    if (m_usePolygonHLR) {
+        projectShapeWithPolygonAlgo(input, viewAxis);
+    } else {
+        projectShape(input, viewAxis);
+    }
+    for (auto& p: projected) {
+        result.push_back(*p);
+    }
+    projectionCache::instance().add(fullKey, result);
+}
+
+//! the projected edges are in view coordinates, so scaling them about the origin
+//! is the same as projecting a scaled shape (orthographic projection only)
+void GeometryObject::scaleProjection(double scale)
+{
+    if (!(scale > 0.0) || DrawUtil::fpCompare(scale, 1.0)) {
+        return;
+    }
+    for (auto& p: getProjectedShapes()) {
+        if (!p->IsNull()) {
+            *p = scaleShape(*p, scale);
+        }
+    }
+}
+
+std::vector<TopoDS_Shape*> GeometryObject::getProjectedShapes(void)
+{
+    std::vector<TopoDS_Shape*> result;
+    result.push_back(&visHard);
+    result.push_back(&visOutline);
+    result.push_back(&visSmooth);
+    result.push_back(&visSeam);
+    result.push_back(&visIso);
+    result.push_back(&hidHard);
+    result.push_back(&hidOutline);
+    result.push_back(&hidSmooth);
+    result.push_back(&hidSeam);
+    result.push_back(&hidIso);
+    return result;
+}
+
 //!set up a hidden line remover and project a shape with it
 void GeometryObject::projectShape(const TopoDS_Shape& input,
                                   const gp_Ax2 viewAxis)
@@ -828,3 +904,113 @@ TopoDS_Shape TechDraw::moveShape(const TopoDS_Shape &input,
     }
     return transShape;
 }
+
+//*************************
+//* projectionKey methods
+//*************************
+static inline void hashCombine(std::size_t& seed, std::size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+void projectionKey::addShape(const TopoDS_Shape& s)
+{
+    //the location is compared by value, Part features make a new one on every call
+    shapes.push_back(s);
+    hashCombine(hashValue, s.Located(TopLoc_Location()).HashCode(IntegerLast()));
+    addValue(s.Orientation());
+    const gp_Trsf& trsf = s.Location().Transformation();
+    for (int row = 1; row <= 3; row++) {
+        for (int col = 1; col <= 4; col++) {
+            addValue(trsf.Value(row, col));
+        }
+    }
+}
+
+void projectionKey::addValue(double v)
+{
+    values.push_back(v);
+    hashCombine(hashValue, std::hash<double>()(v));
+}
+
+void projectionKey::addAxis(const gp_Ax2& axis)
+{
+    addValue(axis.Location().X());
+    addValue(axis.Location().Y());
+    addValue(axis.Location().Z());
+    addValue(axis.Direction().X());
+    addValue(axis.Direction().Y());
+    addValue(axis.Direction().Z());
+    addValue(axis.XDirection().X());
+    addValue(axis.XDirection().Y());
+    addValue(axis.XDirection().Z());
+}
+
+bool projectionKey::operator==(const projectionKey& other) const
+{
+    if (hashValue != other.hashValue ||
+        shapes.size() != other.shapes.size() ||
+        values != other.values) {
+        return false;
+    }
+    for (unsigned int i = 0; i < shapes.size(); i++) {
+        if (!shapes[i].IsPartner(other.shapes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//*************************
+//* projectionCache methods
+//*************************
+projectionCache& projectionCache::instance(void)
+{
+    static projectionCache cache;
+    return cache;
+}
+
+//! reads the size from the preferences, so it must be called from the main thread
+bool projectionCache::isEnabled(void)
+{
+    Base::Reference<ParameterGrp> hGrp = App::GetApplication().GetUserParameter()
+        .GetGroup("BaseApp")->GetGroup("Preferences")->GetGroup("Mod/TechDraw/General");
+    int size = hGrp->GetInt("ProjectionCacheSize", 16);
+    std::lock_guard<std::mutex> lock(mutex);
+    maxSize = size;
+    if (maxSize <= 0) {
+        entries.clear();
+    }
+    return maxSize > 0;
+}
+
+bool projectionCache::find(const projectionKey& key, std::vector<TopoDS_Shape>& result)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->key == key) {
+            entries.splice(entries.begin(), entries, it);
+            result = entries.front().result;
+            return true;
+        }
+    }
+    return false;
+}
+
+void projectionCache::add(const projectionKey& key, const std::vector<TopoDS_Shape>& result)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entry e;
+    e.key = key;
+    e.result = result;
+    entries.push_front(e);
+    while (!entries.empty() && (int)entries.size() > maxSize) {
+        entries.pop_back();
+    }
+}
+
+void projectionCache::clear(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+}
@@ -30,6 +30,8 @@
 
 #include <Base/Vector3D.h>
 #include <Base/BoundBox.h>
+#include <list>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -87,6 +89,52 @@ gp_Ax2 TechDrawExport getViewAxis(const Base::Vector3d origin,
                                   const Base::Vector3d& xAxis,
                                   const bool flip=true);
 
+//! identifies the result of a projection by what went into it. shapes are
+//! compared by identity, so a key only matches while its sources are unchanged.
+class TechDrawExport projectionKey
+{
+public:
+    projectionKey() : hashValue(0) {}
+
+    void addShape(const TopoDS_Shape& s);
+    void addValue(double v);
+    void addAxis(const gp_Ax2& axis);
+
+    bool isEmpty(void) const { return shapes.empty(); }
+    std::size_t hash(void) const { return hashValue; }
+    bool operator==(const projectionKey& other) const;
+
+private:
+    std::vector<TopoDS_Shape> shapes;
+    std::vector<double> values;
+    std::size_t hashValue;
+};
+
+//! recently projected shapes, shared by all views
+class TechDrawExport projectionCache
+{
+public:
+    static projectionCache& instance(void);
+
+    //! true if the cache is switched on in the preferences
+    bool isEnabled(void);
+
+    bool find(const projectionKey& key, std::vector<TopoDS_Shape>& result);
+    void add(const projectionKey& key, const std::vector<TopoDS_Shape>& result);
+    void clear(void);
+
+private:
+    projectionCache() : maxSize(16) {}
+
+    struct entry {
+        projectionKey key;
+        std::vector<TopoDS_Shape> result;
+    };
+    std::list<entry> entries;             //most recently used first
+    int maxSize;
+    std::mutex mutex;
+};
+
 class TechDrawExport GeometryObject
 {
 public:
@@ -108,12 +156,19 @@ public:
                       const gp_Ax2 viewAxis);
     void projectShapeWithPolygonAlgo(const TopoDS_Shape &input,
                                      const gp_Ax2 viewAxis);
+    //! project the shape, unless the cache holds a projection with the same key
+    void projectShapeCached(const projectionKey& key,
+                            const TopoDS_Shape &input,
+                            const gp_Ax2 viewAxis);
+    //! scale the projected edges about the view origin
+    void scaleProjection(double scale);
 
     void extractGeometry(edgeClass category, bool visible);
     void addFaceGeom(Face * f);
     void clearFaceGeom();
     void setIsoCount(int i) { m_isoCount = i; }
     void setParentName(std::string n);                          //for debug messages
+    const std::string& getParentName(void) const { return m_parentName; }
     void isPerspective(bool b) { m_isPersp = b; }
     bool isPerspective(void) { return m_isPersp; }
     void usePolygonHLR(bool b) { m_usePolygonHLR = b; }
@@ -171,6 +226,7 @@ protected:
     std::vector<Face *> faceGeom;
 
     bool findVertex(Base::Vector3d v);
+    std::vector<TopoDS_Shape*> getProjectedShapes(void);
 
     std::string m_parentName;
     TechDraw::DrawView* m_parent;